@@ -0,0 +1,187 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file calibration_store_file_test.c
+ * Host test of the file backed Ex10CalibrationStore: writing, reading back,
+ * replacing, reading an erased or short store and the argument checks.
+ *
+ * Build and run on Linux from this directory:
+ *   cc -std=gnu11 -Wall -pthread -DEX10_OSAL_TYPE=EX10_OS_TYPE_POSIX \
+ *       -DEX10_CALIBRATION_STORE_FILE_PATH='"calibration_store_test.bin"' \
+ *       -I ../src -I ../src/include -I ../src/board \
+ *       -o calibration_store_file_test calibration_store_file_test.c \
+ *       host_osal_posix.c ../src/board/ex10_calibration_store_file.c
+ *   ./calibration_store_file_test
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board/ex10_calibration_store.h"
+#include "board/ex10_osal.h"
+
+#ifndef EX10_CALIBRATION_STORE_FILE_PATH
+#error "Build with EX10_CALIBRATION_STORE_FILE_PATH set to a scratch file"
+#endif
+
+/// The size of a test snapshot; not a multiple of a flash word.
+#define SNAPSHOT_LENGTH ((size_t)301u)
+
+static int failures = 0;
+
+#define CHECK(condition)                                                 \
+    do                                                                   \
+    {                                                                    \
+        if (!(condition))                                                \
+        {                                                                \
+            printf("%s:%d: check failed: %s\n",                          \
+                   __FILE__,                                             \
+                   __LINE__,                                             \
+                   #condition);                                          \
+            failures += 1;                                               \
+        }                                                                \
+    } while (0)
+
+// Stubs of the Ex10Result constructors used by the store.
+
+struct Ex10Result make_ex10_success(void)
+{
+    struct Ex10Result ex10_result;
+    memset(&ex10_result, 0, sizeof(ex10_result));
+    return ex10_result;
+}
+
+struct Ex10Result make_ex10_sdk_error(enum Ex10Module        module,
+                                      enum Ex10SdkResultCode result_code)
+{
+    struct Ex10Result ex10_result = make_ex10_success();
+    ex10_result.error             = true;
+    ex10_result.module            = module;
+    ex10_result.result_code.sdk   = result_code;
+    return ex10_result;
+}
+
+// Test helpers.
+
+static void fill_snapshot(uint8_t* snapshot, size_t length, uint8_t seed)
+{
+    for (size_t iter = 0u; iter < length; ++iter)
+    {
+        snapshot[iter] = (uint8_t)(iter * 31u + seed);
+    }
+}
+
+static bool is_zero(uint8_t const* buffer, size_t length)
+{
+    for (size_t iter = 0u; iter < length; ++iter)
+    {
+        if (buffer[iter] != 0u)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Tests.
+
+static void test_write_read(void)
+{
+    struct Ex10CalibrationStore const* store =
+        get_ex10_calibration_store_file();
+
+    uint8_t written[SNAPSHOT_LENGTH];
+    uint8_t read[SNAPSHOT_LENGTH];
+    fill_snapshot(written, sizeof(written), 7u);
+
+    CHECK(store->write(written, sizeof(written)).error == false);
+    memset(read, 0xA5, sizeof(read));
+    CHECK(store->read(read, sizeof(read)).error == false);
+    CHECK(memcmp(read, written, sizeof(written)) == 0);
+
+    // The start of the snapshot can be read on its own.
+    memset(read, 0xA5, sizeof(read));
+    CHECK(store->read(read, 16u).error == false);
+    CHECK(memcmp(read, written, 16u) == 0);
+    CHECK(read[16u] == 0xA5);
+}
+
+static void test_replace(void)
+{
+    struct Ex10CalibrationStore const* store =
+        get_ex10_calibration_store_file();
+
+    uint8_t written[SNAPSHOT_LENGTH];
+    uint8_t read[SNAPSHOT_LENGTH];
+    fill_snapshot(written, sizeof(written), 7u);
+    CHECK(store->write(written, sizeof(written)).error == false);
+
+    // A shorter snapshot replaces the whole of the previous one.
+    fill_snapshot(written, sizeof(written), 99u);
+    CHECK(store->write(written, 100u).error == false);
+    memset(read, 0xA5, sizeof(read));
+    CHECK(store->read(read, sizeof(read)).error == false);
+    CHECK(memcmp(read, written, 100u) == 0);
+    CHECK(is_zero(&read[100u], sizeof(read) - 100u));
+}
+
+static void test_erase(void)
+{
+    struct Ex10CalibrationStore const* store =
+        get_ex10_calibration_store_file();
+
+    uint8_t written[SNAPSHOT_LENGTH];
+    uint8_t read[SNAPSHOT_LENGTH];
+    fill_snapshot(written, sizeof(written), 7u);
+    CHECK(store->write(written, sizeof(written)).error == false);
+
+    // An erased store reads as zeros, which the caller fails to validate.
+    CHECK(store->erase().error == false);
+    memset(read, 0xA5, sizeof(read));
+    CHECK(store->read(read, sizeof(read)).error == false);
+    CHECK(is_zero(read, sizeof(read)));
+
+    // Erasing an empty store is not an error.
+    CHECK(store->erase().error == false);
+}
+
+static void test_null_buffer(void)
+{
+    struct Ex10CalibrationStore const* store =
+        get_ex10_calibration_store_file();
+
+    struct Ex10Result ex10_result = store->read(NULL, 1u);
+    CHECK(ex10_result.error);
+    CHECK(ex10_result.result_code.sdk == Ex10SdkErrorNullPointer);
+
+    ex10_result = store->write(NULL, 1u);
+    CHECK(ex10_result.error);
+    CHECK(ex10_result.result_code.sdk == Ex10SdkErrorNullPointer);
+}
+
+int main(void)
+{
+    test_write_read();
+    test_replace();
+    test_erase();
+    test_null_buffer();
+
+    (void)get_ex10_calibration_store_file()->erase();
+
+    printf("calibration_store_file_test: %s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file device_time_test.c
+ * Host test of the Ex10DeviceTime us_counter extension: extension across
+ * many device counter wraps, extension of older packets, re-anchoring on
+ * the existing timeline, and re-anchoring after a device counter reset.
+ * The host uptime is replaced by the stub below.
+ *
+ * Build and run on Linux from this directory:
+ *   cc -std=gnu11 -Wall -pthread -DEX10_OSAL_TYPE=EX10_OS_TYPE_POSIX \
+ *       -I ../src -I ../src/include -I ../src/board \
+ *       -o device_time_test device_time_test.c host_osal_posix.c \
+ *       ../src/src/ex10_api/ex10_device_time.c
+ *   ./device_time_test
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board/time_helpers.h"
+#include "ex10_api/ex10_device_time.h"
+#include "ex10_api/ex10_ops.h"
+#include "ex10_api/ex10_protocol.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                 \
+    do                                                                   \
+    {                                                                    \
+        if (!(condition))                                                \
+        {                                                                \
+            printf("%s:%d: check failed: %s\n",                          \
+                   __FILE__,                                             \
+                   __LINE__,                                             \
+                   #condition);                                          \
+            failures += 1;                                               \
+        }                                                                \
+    } while (0)
+
+// Stubs of the board and protocol layers used by the device time module.
+
+/// The host uptime returned by the time helpers stub.
+static uint32_t host_time_ms = 0u;
+
+static uint32_t time_now(void)
+{
+    return host_time_ms;
+}
+
+static struct Ex10TimeHelpers time_helpers = {
+    .time_now = time_now,
+};
+
+struct Ex10TimeHelpers* get_ex10_time_helpers(void)
+{
+    return &time_helpers;
+}
+
+struct Ex10Protocol const* get_ex10_protocol(void)
+{
+    return NULL;
+}
+
+struct Ex10Ops const* get_ex10_ops(void)
+{
+    return NULL;
+}
+
+struct Ex10Result make_ex10_success(void)
+{
+    struct Ex10Result ex10_result;
+    memset(&ex10_result, 0, sizeof(ex10_result));
+    return ex10_result;
+}
+
+struct Ex10Result make_ex10_sdk_error(enum Ex10Module        module,
+                                      enum Ex10SdkResultCode result_code)
+{
+    struct Ex10Result ex10_result = make_ex10_success();
+    ex10_result.error             = true;
+    ex10_result.module            = module;
+    ex10_result.result_code.sdk   = result_code;
+    return ex10_result;
+}
+
+/**
+ * The device counter runs from a host time of 5 s, with the first anchor
+ * just below its wrap. Stepping a minute at a time through five wraps, each
+ * extended value must be exactly the device time elapsed since the anchor
+ * past the anchor timestamp.
+ */
+static void test_wraparound(void)
+{
+    struct Ex10DeviceTime const* device_time = get_ex10_device_time();
+
+    host_time_ms                = 5000u;
+    uint32_t const start_us     = UINT32_MAX - 500000u;
+    uint64_t const start_stamp  = device_time->anchor_us_counter(start_us);
+    uint64_t       last_stamp   = start_stamp;
+    uint64_t       elapsed_us   = 0u;
+    uint32_t const step_ms      = 60u * 1000u;
+    uint32_t const wrap_minutes = 72u;  // 2^32 us is about 71.6 minutes.
+    CHECK(start_stamp == 5000u * 1000u);
+
+    for (uint32_t minute = 0u; minute < 5u * wrap_minutes; ++minute)
+    {
+        host_time_ms += step_ms;
+        elapsed_us += (uint64_t)step_ms * 1000u;
+        // Re-anchor every 30 minutes, within the 35 minute extension range.
+        if (minute % 30u == 0u)
+        {
+            uint32_t const us_counter = start_us + (uint32_t)elapsed_us;
+            CHECK(device_time->anchor_us_counter(us_counter) ==
+                  start_stamp + elapsed_us);
+        }
+
+        // A packet from 10 s ago, and the current time.
+        uint32_t const old_counter =
+            start_us + (uint32_t)(elapsed_us - 10000000u);
+        uint32_t const now_counter = start_us + (uint32_t)elapsed_us;
+        uint64_t const old_stamp = device_time->extend_us_counter(old_counter);
+        uint64_t const now_stamp = device_time->extend_us_counter(now_counter);
+        CHECK(old_stamp == start_stamp + elapsed_us - 10000000u);
+        CHECK(now_stamp == start_stamp + elapsed_us);
+        CHECK(now_stamp > last_stamp);
+        last_stamp = now_stamp;
+    }
+}
+
+/**
+ * A device counter that disagrees with the timeline by less than the
+ * tolerance keeps the timeline; a larger difference is taken as a reset and
+ * re-ties it to host time, but never before a timestamp already returned.
+ */
+static void test_reanchor(void)
+{
+    struct Ex10DeviceTime const* device_time = get_ex10_device_time();
+
+    // Drift of half a second, running ahead of the host.
+    host_time_ms += 1000u;
+    uint32_t       us_counter = 1000000u;
+    uint64_t const base_stamp = device_time->anchor_us_counter(us_counter);
+    host_time_ms += 1000u;
+    us_counter += 1500000u;
+    uint64_t const drift_stamp = device_time->anchor_us_counter(us_counter);
+    CHECK(drift_stamp == base_stamp + 1500000u);
+
+    // The device runs half a second ahead of the host since the last anchor
+    // when it is reset, so the host time places the reset before the last
+    // timestamp returned.
+    host_time_ms += 1000u;
+    uint64_t const before_reset =
+        device_time->extend_us_counter(us_counter + 1500000u);
+    CHECK(before_reset == drift_stamp + 1500000u);
+
+    host_time_ms += 10u;
+    uint64_t const reset_stamp = device_time->anchor_us_counter(0u);
+    CHECK(reset_stamp == before_reset + 1u);
+
+    // The new timeline continues from the reset counter.
+    host_time_ms += 1000u;
+    CHECK(device_time->extend_us_counter(1000000u) == reset_stamp + 1000000u);
+
+    // A reset the host time places after the last timestamp follows it.
+    host_time_ms += 60u * 1000u;
+    uint64_t const host_stamp =
+        device_time->extend_us_counter(1000000u) + 60u * 1000u * 1000u;
+    uint64_t const second_reset = device_time->anchor_us_counter(5u);
+    CHECK(second_reset == host_stamp);
+}
+
+int main(void)
+{
+    test_wraparound();
+    test_reanchor();
+
+    printf("device_time_test: %s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
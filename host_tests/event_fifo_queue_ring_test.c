@@ -0,0 +1,413 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file event_fifo_queue_ring_test.c
+ * Host stress test of the Ex10EventFifoQueue lock-free ring mode: the mode
+ * change checks, ring index wrap, ring overrun and a concurrent producer and
+ * consumer. The board and protocol layers are replaced by the stubs below.
+ *
+ * Build and run on Linux from this directory:
+ *   cc -std=gnu11 -Wall -pthread -DEX10_OSAL_TYPE=EX10_OS_TYPE_POSIX \
+ *       -I ../src -I ../src/include -I ../src/board \
+ *       -o event_fifo_queue_ring_test event_fifo_queue_ring_test.c \
+ *       host_osal_posix.c ../src/src/ex10_api/ex10_event_fifo_queue.c \
+ *       ../src/src/ex10_api/event_packet_parser.c \
+ *       ../src/src/ex10_api/ex10_event_pipeline_monitor.c \
+ *       ../src/src/ex10_api/list_node.c
+ *   ./event_fifo_queue_ring_test
+ * Add -fsanitize=thread to check the ring for data races.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board/ex10_osal.h"
+#include "board/fifo_buffer_pool.h"
+#include "board/time_helpers.h"
+#include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/event_packet_parser.h"
+#include "ex10_api/ex10_device_time.h"
+#include "ex10_api/ex10_event_fifo_queue.h"
+#include "ex10_api/ex10_protocol.h"
+#include "ex10_api/fifo_buffer_list.h"
+#include "ex10_api/list_node.h"
+#include "ex10_api/print_data.h"
+
+/// The ring capacity, EVENT_FIFO_RING_SIZE in ex10_event_fifo_queue.c.
+#define RING_SIZE ((size_t)32u)
+
+/// Enough nodes to overrun the ring.
+#define NODE_COUNT (RING_SIZE + 4u)
+
+/// The number of packets passed between threads by the concurrent test.
+#define CONCURRENT_PACKETS ((uint32_t)200000u)
+
+/// Each node holds one Custom packet, whose us_counter is the sequence.
+#define PACKET_WORDS ((size_t)3u)
+
+static struct FifoBufferNode nodes[NODE_COUNT];
+static uint32_t              node_storage[NODE_COUNT][PACKET_WORDS];
+
+static struct FifoBufferNode* free_nodes[NODE_COUNT];
+static size_t                 free_count = 0u;
+static ex10_mutex_t           free_mutex = EX10_MUTEX_INITIALIZER;
+
+static int failures = 0;
+
+#define CHECK(condition)                                                 \
+    do                                                                   \
+    {                                                                    \
+        if (!(condition))                                                \
+        {                                                                \
+            printf("%s:%d: check failed: %s\n",                          \
+                   __FILE__,                                             \
+                   __LINE__,                                             \
+                   #condition);                                          \
+            failures += 1;                                               \
+        }                                                                \
+    } while (0)
+
+// Stubs of the board and protocol layers used by the EventFifo queue.
+
+bool ex10_release_buffer_node(struct FifoBufferNode* fifo_buffer_node)
+{
+    ex10_mutex_lock(&free_mutex);
+    free_nodes[free_count] = fifo_buffer_node;
+    free_count += 1u;
+    ex10_mutex_unlock(&free_mutex);
+    return false;
+}
+
+struct FifoBufferNode* make_ex10_result_fifo_packet(
+    struct Ex10Result ex10_result,
+    uint32_t          us_counter)
+{
+    (void)ex10_result;
+    (void)us_counter;
+    return NULL;
+}
+
+struct Ex10Protocol const* get_ex10_protocol(void)
+{
+    return NULL;
+}
+
+/// The pool sizes of the Zephyr board.
+static struct FifoBufferPool const event_fifo_buffer_pool = {
+    .buffer_count = 16u};
+static struct FifoBufferPool const result_buffer_pool = {.buffer_count = 4u};
+
+/// A pool which does not fit in the ring.
+static struct FifoBufferPool const oversized_buffer_pool = {
+    .buffer_count = RING_SIZE};
+
+static struct FifoBufferPool const* active_event_fifo_buffer_pool =
+    &event_fifo_buffer_pool;
+
+struct FifoBufferPool const* get_ex10_event_fifo_buffer_pool(void)
+{
+    return active_event_fifo_buffer_pool;
+}
+
+struct FifoBufferPool const* get_ex10_result_buffer_pool(void)
+{
+    return &result_buffer_pool;
+}
+
+struct Ex10Result make_ex10_success(void)
+{
+    struct Ex10Result ex10_result;
+    memset(&ex10_result, 0, sizeof(ex10_result));
+    return ex10_result;
+}
+
+struct Ex10Result make_ex10_sdk_error(enum Ex10Module        module,
+                                      enum Ex10SdkResultCode result_code)
+{
+    struct Ex10Result ex10_result = make_ex10_success();
+    ex10_result.error             = true;
+    ex10_result.module            = module;
+    ex10_result.result_code.sdk   = result_code;
+    return ex10_result;
+}
+
+static uint64_t extend_us_counter(uint32_t us_counter)
+{
+    return us_counter;
+}
+
+static struct Ex10DeviceTime device_time = {
+    .extend_us_counter = extend_us_counter,
+};
+
+struct Ex10DeviceTime* get_ex10_device_time(void)
+{
+    return &device_time;
+}
+
+static uint32_t time_now_us(void)
+{
+    return 0u;
+}
+
+static struct Ex10TimeHelpers time_helpers = {
+    .time_now_us = time_now_us,
+};
+
+struct Ex10TimeHelpers* get_ex10_time_helpers(void)
+{
+    return &time_helpers;
+}
+
+int ex10_empty_printf(const char* format, ...)
+{
+    (void)format;
+    return 0;
+}
+
+void ex10_print_data(void const* data, size_t length, enum DataPrefix prefix)
+{
+    (void)data;
+    (void)length;
+    (void)prefix;
+}
+
+// Test helpers.
+
+static void init_nodes(void)
+{
+    struct Ex10EventParser const* parser = get_ex10_event_parser();
+    struct PacketHeader const header = parser->make_packet_header(Custom);
+
+    free_count = 0u;
+    for (size_t iter = 0u; iter < NODE_COUNT; ++iter)
+    {
+        struct FifoBufferNode* node = &nodes[iter];
+        memset(node, 0, sizeof(*node));
+        memcpy(node_storage[iter], &header, sizeof(header));
+        node->raw_buffer.data   = (uint8_t*)node_storage[iter];
+        node->raw_buffer.length = sizeof(node_storage[iter]);
+        node->fifo_data.data    = (uint8_t const*)node_storage[iter];
+        node->fifo_data.length  = header.packet_length * sizeof(uint32_t);
+        get_ex10_list_node_helper()->init(&node->list_node);
+        node->list_node.data = node;
+        ex10_release_buffer_node(node);
+    }
+}
+
+static struct FifoBufferNode* take_node(void)
+{
+    ex10_mutex_lock(&free_mutex);
+    struct FifoBufferNode* node = NULL;
+    if (free_count > 0u)
+    {
+        free_count -= 1u;
+        node = free_nodes[free_count];
+    }
+    ex10_mutex_unlock(&free_mutex);
+    return node;
+}
+
+static size_t get_free_count(void)
+{
+    ex10_mutex_lock(&free_mutex);
+    size_t const count = free_count;
+    ex10_mutex_unlock(&free_mutex);
+    return count;
+}
+
+static void push_packet(struct FifoBufferNode* node, uint32_t sequence)
+{
+    struct PacketHeader* header = (struct PacketHeader*)node->raw_buffer.data;
+    header->us_counter          = sequence;
+    get_ex10_event_fifo_queue()->list_node_push_back(node);
+}
+
+/**
+ * Read the next packet and check it is the expected Custom packet.
+ *
+ * @return bool true if a packet was read.
+ */
+static bool pop_packet(uint32_t expected_sequence)
+{
+    struct Ex10EventFifoQueue const* queue  = get_ex10_event_fifo_queue();
+    struct EventFifoPacket const*    packet = queue->packet_peek();
+    if (packet == NULL)
+    {
+        return false;
+    }
+    CHECK(packet->packet_type == Custom);
+    CHECK(packet->us_counter == expected_sequence);
+    queue->packet_remove();
+    return true;
+}
+
+static void reset_queue(bool ring_mode)
+{
+    struct Ex10EventFifoQueue const* queue = get_ex10_event_fifo_queue();
+    init_nodes();
+    queue->init();
+    CHECK(queue->enable_ring_mode(ring_mode).error == false);
+}
+
+// Tests.
+
+static void test_mode_change(void)
+{
+    struct Ex10EventFifoQueue const* queue = get_ex10_event_fifo_queue();
+    reset_queue(false);
+
+    // The ring must be larger than the buffer pools.
+    active_event_fifo_buffer_pool = &oversized_buffer_pool;
+    struct Ex10Result ex10_result = queue->enable_ring_mode(true);
+    CHECK(ex10_result.error);
+    CHECK(ex10_result.result_code.sdk == Ex10SdkErrorBadParamLength);
+    active_event_fifo_buffer_pool = &event_fifo_buffer_pool;
+
+    // The mode can not be changed while the queue holds packets.
+    push_packet(take_node(), 1u);
+    ex10_result = queue->enable_ring_mode(true);
+    CHECK(ex10_result.error);
+    CHECK(ex10_result.result_code.sdk == Ex10SdkErrorInvalidState);
+    CHECK(pop_packet(1u));
+    CHECK(queue->packet_peek() == NULL);
+
+    CHECK(queue->enable_ring_mode(true).error == false);
+    CHECK(queue->enable_ring_mode(false).error == false);
+}
+
+static void test_wrap(void)
+{
+    reset_queue(true);
+
+    // Pass bursts of varying size through the ring so that the indices
+    // wrap at every position within the ring.
+    uint32_t pushed = 0u;
+    uint32_t popped = 0u;
+    for (size_t burst = 1u; burst <= 3u * RING_SIZE; ++burst)
+    {
+        size_t const burst_length = (burst % (RING_SIZE - 1u)) + 1u;
+        for (size_t iter = 0u; iter < burst_length; ++iter)
+        {
+            struct FifoBufferNode* node = take_node();
+            CHECK(node != NULL);
+            if (node != NULL)
+            {
+                push_packet(node, pushed);
+                pushed += 1u;
+            }
+        }
+        while (pop_packet(popped))
+        {
+            popped += 1u;
+        }
+    }
+
+    CHECK(popped == pushed);
+    CHECK(get_free_count() == NODE_COUNT);
+}
+
+static void test_overrun(void)
+{
+    reset_queue(true);
+
+    // A push onto a full ring drops and releases the node.
+    for (uint32_t sequence = 0u; sequence <= RING_SIZE; ++sequence)
+    {
+        push_packet(take_node(), sequence);
+    }
+    CHECK(get_free_count() == NODE_COUNT - RING_SIZE);
+
+    uint32_t popped = 0u;
+    while (pop_packet(popped))
+    {
+        popped += 1u;
+    }
+    CHECK(popped == RING_SIZE);
+    CHECK(get_free_count() == NODE_COUNT);
+}
+
+static void* producer(void* unused)
+{
+    (void)unused;
+    for (uint32_t sequence = 0u; sequence < CONCURRENT_PACKETS;)
+    {
+        struct FifoBufferNode* node = take_node();
+        if (node != NULL)
+        {
+            push_packet(node, sequence);
+            sequence += 1u;
+        }
+    }
+    return NULL;
+}
+
+static void test_concurrent_drain(void)
+{
+    struct Ex10EventFifoQueue const* queue = get_ex10_event_fifo_queue();
+    reset_queue(true);
+
+    // Only use as many nodes as the buffer pools declare.
+    for (size_t iter = 0u; iter < NODE_COUNT - 16u; ++iter)
+    {
+        (void)take_node();
+    }
+    size_t const pool_free_count = get_free_count();
+
+    pthread_t producer_thread;
+    pthread_create(&producer_thread, NULL, producer, NULL);
+
+    // Alternate between per packet and batch reads while draining.
+    uint32_t expected = 0u;
+    while (expected < CONCURRENT_PACKETS)
+    {
+        queue->packet_wait_with_timeout(1000u);
+        if ((expected / 1000u) % 2u == 0u)
+        {
+            if (pop_packet(expected))
+            {
+                expected += 1u;
+            }
+            continue;
+        }
+
+        struct EventFifoPacket const* packets = NULL;
+        size_t const count = queue->packet_peek_batch(&packets);
+        for (size_t iter = 0u; iter < count; ++iter)
+        {
+            CHECK(packets[iter].us_counter == expected);
+            expected += 1u;
+        }
+        queue->packet_remove_batch();
+    }
+    pthread_join(producer_thread, NULL);
+
+    CHECK(queue->packet_peek() == NULL);
+    CHECK(get_free_count() == pool_free_count);
+}
+
+int main(void)
+{
+    test_mode_change();
+    test_wrap();
+    test_overrun();
+    test_concurrent_drain();
+
+    printf("event_fifo_queue_ring_test: %s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file host_osal_posix.c
+ * The POSIX OSAL functions which board/ex10_osal_posix.h declares but does
+ * not define, for the host tests in this directory. Build the host tests
+ * with -DEX10_OSAL_TYPE=EX10_OS_TYPE_POSIX.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#include "board/ex10_osal.h"
+
+int ex10_cond_timed_wait_us(ex10_cond_t*  cond,
+                            ex10_mutex_t* mutex,
+                            uint32_t      timeout_us)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    uint64_t const nsec = (uint64_t)deadline.tv_nsec + timeout_us * 1000ull;
+    deadline.tv_sec += (time_t)(nsec / 1000000000ull);
+    deadline.tv_nsec = (long)(nsec % 1000000000ull);
+    return pthread_cond_timedwait(cond, mutex, &deadline);
+}
+
+int ex10_memcpy(void*       dst_ptr,
+                size_t      dst_size,
+                const void* src_ptr,
+                size_t      src_size)
+{
+    if (dst_ptr == NULL || src_ptr == NULL || src_size > dst_size)
+    {
+        return EINVAL;
+    }
+    memcpy(dst_ptr, src_ptr, src_size);
+    return 0;
+}
+
+int ex10_memset(void* dst_ptr, size_t dst_size, int value, size_t count)
+{
+    if (dst_ptr == NULL || count > dst_size)
+    {
+        return EINVAL;
+    }
+    memset(dst_ptr, value, count);
+    return 0;
+}
+
+void ex10_memzero(void* dst_ptr, size_t dst_size)
+{
+    if (dst_ptr != NULL)
+    {
+        memset(dst_ptr, 0, dst_size);
+    }
+}
@@ -0,0 +1,217 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file stored_crc_set_test.c
+ * Host test of the Gen2X StoredCRC set: a probe run filled to
+ * STORED_CRC_SET_PROBE_LIMIT, eviction of the least recently inserted
+ * member, and expiry of members by their round stamps.
+ *
+ * Build and run on Linux from this directory:
+ *   cc -std=gnu11 -Wall -pthread -DEX10_OSAL_TYPE=EX10_OS_TYPE_POSIX \
+ *       -I ../src -I ../src/include -I ../src/board \
+ *       -o stored_crc_set_test stored_crc_set_test.c host_osal_posix.c \
+ *       ../src/src_gen2x/ex10_api/ex10_stored_crc_set_gen2x.c
+ *   ./stored_crc_set_test
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "include_gen2x/ex10_api/ex10_stored_crc_set_gen2x.h"
+#include "src_gen2x/ex10_api/ex10_stored_crc_hash_gen2x.h"
+
+#define ENTRY_COUNT ((size_t)64u)
+
+/// One more StoredCRC than fits in a probe run.
+#define COLLIDING_COUNT (STORED_CRC_SET_PROBE_LIMIT + 1u)
+
+static struct StoredCrcSetEntryGen2X entries[ENTRY_COUNT];
+static struct StoredCrcSetGen2X      set;
+
+/// StoredCRCs which all hash to the same first slot.
+static uint16_t colliding[COLLIDING_COUNT];
+static size_t   colliding_slot = 0u;
+
+static int failures = 0;
+
+#define CHECK(condition)                                                 \
+    do                                                                   \
+    {                                                                    \
+        if (!(condition))                                                \
+        {                                                                \
+            printf("%s:%d: check failed: %s\n",                          \
+                   __FILE__,                                             \
+                   __LINE__,                                             \
+                   #condition);                                          \
+            failures += 1;                                               \
+        }                                                                \
+    } while (0)
+
+// Stubs of the result functions used by the set.
+
+struct Ex10Result make_ex10_success(void)
+{
+    struct Ex10Result ex10_result;
+    memset(&ex10_result, 0, sizeof(ex10_result));
+    return ex10_result;
+}
+
+struct Ex10Result make_ex10_sdk_error(enum Ex10Module        module,
+                                      enum Ex10SdkResultCode result_code)
+{
+    struct Ex10Result ex10_result = make_ex10_success();
+    ex10_result.error             = true;
+    ex10_result.module            = module;
+    ex10_result.result_code.sdk   = result_code;
+    return ex10_result;
+}
+
+static void find_colliding_crcs(void)
+{
+    uint8_t const shift = stored_crc_hash_shift(ENTRY_COUNT);
+    size_t        count = 0u;
+    colliding_slot      = stored_crc_hash_first_slot(0x1234u, shift);
+    for (uint32_t crc = 0x1234u; count < COLLIDING_COUNT; ++crc)
+    {
+        if (stored_crc_hash_first_slot((uint16_t)crc, shift) ==
+            colliding_slot)
+        {
+            colliding[count] = (uint16_t)crc;
+            count += 1u;
+        }
+    }
+}
+
+static bool all_present(size_t first, size_t end)
+{
+    struct Ex10StoredCrcSetGen2X const* crc_set =
+        get_ex10_stored_crc_set_gen2x();
+    for (size_t iter = first; iter < end; ++iter)
+    {
+        if (crc_set->contains(&set, colliding[iter]) == false)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Fill the probe run of one slot, one member per round, then insert one
+ * more StoredCRC with the same first slot. The member inserted longest ago
+ * is evicted; a member re-inserted since survives.
+ */
+static void test_probe_limit(void)
+{
+    struct Ex10StoredCrcSetGen2X const* crc_set =
+        get_ex10_stored_crc_set_gen2x();
+    CHECK(crc_set->init(&set, entries, ENTRY_COUNT, 100u).error == false);
+
+    for (size_t iter = 0u; iter < STORED_CRC_SET_PROBE_LIMIT; ++iter)
+    {
+        crc_set->insert(&set, colliding[iter]);
+        crc_set->advance_round(&set);
+    }
+    CHECK(all_present(0u, STORED_CRC_SET_PROBE_LIMIT));
+    CHECK(set.evictions == 0u);
+
+    // Re-inserting the first member makes the second the oldest.
+    crc_set->insert(&set, colliding[0]);
+    crc_set->insert(&set, colliding[STORED_CRC_SET_PROBE_LIMIT]);
+    CHECK(set.evictions == 1u);
+    CHECK(crc_set->contains(&set, colliding[0]));
+    CHECK(crc_set->contains(&set, colliding[1]) == false);
+    CHECK(all_present(2u, COLLIDING_COUNT));
+
+    // Exactly STORED_CRC_SET_PROBE_LIMIT of the run's slots are used.
+    size_t used = 0u;
+    for (size_t slot = 0u; slot < ENTRY_COUNT; ++slot)
+    {
+        used += (entries[slot].round_stamp != 0u) ? 1u : 0u;
+    }
+    CHECK(used == STORED_CRC_SET_PROBE_LIMIT);
+}
+
+/**
+ * A member expires max_age_rounds rounds after its round stamp, and its
+ * stale slot is reused by the next insert in the run without an eviction.
+ */
+static void test_stale_stamps(void)
+{
+    struct Ex10StoredCrcSetGen2X const* crc_set =
+        get_ex10_stored_crc_set_gen2x();
+    uint32_t const max_age_rounds = 2u;
+    CHECK(crc_set->init(&set, entries, ENTRY_COUNT, max_age_rounds).error ==
+          false);
+
+    // The first half of the run is inserted one round before the second,
+    // so that after two more rounds only the first half has expired.
+    size_t const half = STORED_CRC_SET_PROBE_LIMIT / 2u;
+    for (size_t iter = 0u; iter < STORED_CRC_SET_PROBE_LIMIT; ++iter)
+    {
+        if (iter == half)
+        {
+            crc_set->advance_round(&set);
+        }
+        crc_set->insert(&set, colliding[iter]);
+    }
+    CHECK(all_present(0u, STORED_CRC_SET_PROBE_LIMIT));
+    crc_set->advance_round(&set);
+    crc_set->advance_round(&set);
+    CHECK(all_present(half, STORED_CRC_SET_PROBE_LIMIT));
+    for (size_t iter = 0u; iter < half; ++iter)
+    {
+        CHECK(crc_set->contains(&set, colliding[iter]) == false);
+    }
+
+    // The new member takes the first stale slot rather than evicting.
+    crc_set->insert(&set, colliding[STORED_CRC_SET_PROBE_LIMIT]);
+    CHECK(set.evictions == 0u);
+    CHECK(entries[colliding_slot].stored_crc ==
+          colliding[STORED_CRC_SET_PROBE_LIMIT]);
+    CHECK(crc_set->contains(&set, colliding[STORED_CRC_SET_PROBE_LIMIT]));
+
+    // A member is kept for max_age_rounds rounds, then expires.
+    for (uint32_t round = 0u; round < max_age_rounds; ++round)
+    {
+        crc_set->advance_round(&set);
+        CHECK(crc_set->contains(&set,
+                                colliding[STORED_CRC_SET_PROBE_LIMIT]));
+    }
+    crc_set->advance_round(&set);
+    CHECK(crc_set->contains(&set, colliding[STORED_CRC_SET_PROBE_LIMIT]) ==
+          false);
+
+    // expire_all() ends the membership of members stamped this round.
+    crc_set->insert(&set, colliding[0]);
+    CHECK(crc_set->contains(&set, colliding[0]));
+    crc_set->expire_all(&set);
+    CHECK(crc_set->contains(&set, colliding[0]) == false);
+    crc_set->insert(&set, colliding[0]);
+    CHECK(crc_set->contains(&set, colliding[0]));
+    CHECK(set.evictions == 0u);
+}
+
+int main(void)
+{
+    find_colliding_crcs();
+    test_probe_limit();
+    test_stale_stamps();
+
+    printf("stored_crc_set_test: %s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,235 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file tag_dedup_table_test.c
+ * Host test of the Ex10TagDedupTable: backward-shift deletion from the
+ * middle of a probe cluster, and the least recently read eviction order.
+ *
+ * Build and run on Linux from this directory:
+ *   cc -std=gnu11 -Wall -pthread -DEX10_OSAL_TYPE=EX10_OS_TYPE_POSIX \
+ *       -I ../src -I ../src/include -I ../src/board \
+ *       -o tag_dedup_table_test tag_dedup_table_test.c host_osal_posix.c \
+ *       ../src/src/ex10_api/ex10_tag_dedup_table.c
+ *   ./tag_dedup_table_test
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ex10_api/ex10_tag_dedup_table.h"
+
+/// The table size of the cluster test; the mask of its slot indices.
+#define CLUSTER_ENTRIES ((size_t)16u)
+
+/// The table size of the eviction order test; 6 tags fill it to 3/4.
+#define LRU_ENTRIES ((size_t)8u)
+
+#define EPC_LENGTH ((size_t)12u)
+
+static struct Ex10TagDedupEntry entries[CLUSTER_ENTRIES];
+
+static int failures = 0;
+
+#define CHECK(condition)                                                 \
+    do                                                                   \
+    {                                                                    \
+        if (!(condition))                                                \
+        {                                                                \
+            printf("%s:%d: check failed: %s\n",                          \
+                   __FILE__,                                             \
+                   __LINE__,                                             \
+                   #condition);                                          \
+            failures += 1;                                               \
+        }                                                                \
+    } while (0)
+
+// Stubs of the result functions used by the table.
+
+struct Ex10Result make_ex10_success(void)
+{
+    struct Ex10Result ex10_result;
+    memset(&ex10_result, 0, sizeof(ex10_result));
+    return ex10_result;
+}
+
+struct Ex10Result make_ex10_sdk_error(enum Ex10Module        module,
+                                      enum Ex10SdkResultCode result_code)
+{
+    struct Ex10Result ex10_result = make_ex10_success();
+    ex10_result.error             = true;
+    ex10_result.module            = module;
+    ex10_result.result_code.sdk   = result_code;
+    return ex10_result;
+}
+
+/// Tag key number tag has an EPC holding the number in its first 2 bytes.
+static void make_epc(uint16_t tag, uint8_t epc[EPC_LENGTH])
+{
+    memset(epc, 0xA5, EPC_LENGTH);
+    epc[0] = (uint8_t)(tag >> 8u);
+    epc[1] = (uint8_t)tag;
+}
+
+static struct Ex10TagDedupEntry const* record(uint16_t tag,
+                                              uint64_t timestamp_us)
+{
+    uint8_t epc[EPC_LENGTH];
+    make_epc(tag, epc);
+    struct Ex10TagDedupRead const read = {
+        .pc            = 0x3000u,
+        .epc           = epc,
+        .epc_length    = EPC_LENGTH,
+        .us_counter    = (uint32_t)timestamp_us,
+        .timestamp_us  = timestamp_us,
+        .rssi_cdbm     = -6000,
+        .antenna       = 1u,
+        .channel_index = 3u,
+    };
+    return get_ex10_tag_dedup_table()->record_read(&read, NULL);
+}
+
+/// Returns the slot of a tag, or CLUSTER_ENTRIES if it is not held.
+static size_t slot_of(uint16_t tag)
+{
+    uint8_t epc[EPC_LENGTH];
+    make_epc(tag, epc);
+    struct Ex10TagDedupEntry const* entry =
+        get_ex10_tag_dedup_table()->find(0x3000u, epc, EPC_LENGTH);
+    return (entry == NULL) ? CLUSTER_ENTRIES : (size_t)(entry - entries);
+}
+
+/// Returns the home slot of a tag, the slot it takes in an empty table.
+static size_t home_of(uint16_t tag)
+{
+    get_ex10_tag_dedup_table()->init(entries, CLUSTER_ENTRIES, 0u);
+    return (size_t)(record(tag, 0u) - entries);
+}
+
+/// Returns the first tag after previous whose home slot is home.
+static uint16_t next_tag_with_home(uint16_t previous, size_t home)
+{
+    uint16_t tag = (uint16_t)(previous + 1u);
+    while (home_of(tag) != home)
+    {
+        tag += 1u;
+    }
+    return tag;
+}
+
+static uint16_t snapshot_tag(struct Ex10TagDedupEntry const* entry)
+{
+    return (uint16_t)((entry->epc[0] << 8u) | entry->epc[1]);
+}
+
+/**
+ * Tags A, B and C share home slot h, D has home h + 1 and F home h + 4:
+ *   h: A, h+1: B, h+2: C, h+3: D, h+4: F
+ * Removing A must shift B, C and D back one slot each, and leave F, which
+ * is in its home slot, in place.
+ */
+static void test_delete_in_cluster(void)
+{
+    struct Ex10TagDedupTable const* dedup = get_ex10_tag_dedup_table();
+
+    size_t const   h     = 5u;
+    size_t const   mask  = CLUSTER_ENTRIES - 1u;
+    uint16_t const tag_a = next_tag_with_home(0u, h);
+    uint16_t const tag_b = next_tag_with_home(tag_a, h);
+    uint16_t const tag_c = next_tag_with_home(tag_b, h);
+    uint16_t const tag_d = next_tag_with_home(0u, (h + 1u) & mask);
+    uint16_t const tag_f = next_tag_with_home(0u, (h + 4u) & mask);
+
+    dedup->init(entries, CLUSTER_ENTRIES, 0u);
+    record(tag_a, 1000u);
+    record(tag_b, 2000u);
+    record(tag_c, 3000u);
+    record(tag_d, 4000u);
+    record(tag_f, 5000u);
+    CHECK(slot_of(tag_a) == h);
+    CHECK(slot_of(tag_b) == ((h + 1u) & mask));
+    CHECK(slot_of(tag_c) == ((h + 2u) & mask));
+    CHECK(slot_of(tag_d) == ((h + 3u) & mask));
+    CHECK(slot_of(tag_f) == ((h + 4u) & mask));
+
+    // Only A, the least recently read, is older than 3.5 ms at 5 ms.
+    CHECK(dedup->evict_older_than(5000u, 3500u) == 1u);
+    CHECK(slot_of(tag_a) == CLUSTER_ENTRIES);
+    CHECK(slot_of(tag_b) == h);
+    CHECK(slot_of(tag_c) == ((h + 1u) & mask));
+    CHECK(slot_of(tag_d) == ((h + 2u) & mask));
+    CHECK(slot_of(tag_f) == ((h + 4u) & mask));
+    CHECK(entries[(h + 3u) & mask].in_use == false);
+    CHECK(dedup->get_unique_count() == 4u);
+
+    // The moved entries keep their place in the LRU list.
+    struct Ex10TagDedupEntry copies[CLUSTER_ENTRIES];
+    size_t const count = dedup->snapshot(copies, CLUSTER_ENTRIES);
+    CHECK(count == 4u);
+    CHECK(snapshot_tag(&copies[0]) == tag_f);
+    CHECK(snapshot_tag(&copies[1]) == tag_d);
+    CHECK(snapshot_tag(&copies[2]) == tag_c);
+    CHECK(snapshot_tag(&copies[3]) == tag_b);
+
+    // A read of a shifted entry finds it rather than adding a duplicate.
+    CHECK(record(tag_c, 6000u)->read_count == 2u);
+    CHECK(dedup->get_unique_count() == 4u);
+    CHECK(dedup->get_multi_read_count() == 1u);
+}
+
+/**
+ * Six tags fill an 8 entry table to 3/4. Re-reading the oldest tag moves it
+ * to the front, so the next two new tags evict the second and third oldest.
+ */
+static void test_lru_eviction_order(void)
+{
+    struct Ex10TagDedupTable const* dedup = get_ex10_tag_dedup_table();
+
+    CHECK(dedup->init(entries, LRU_ENTRIES, 0u).error == false);
+    for (uint16_t tag = 0u; tag < 6u; ++tag)
+    {
+        record(tag, 1000u * (tag + 1u));
+    }
+    record(0u, 7000u);
+    record(6u, 8000u);
+    record(7u, 9000u);
+
+    struct Ex10TagDedupStats stats;
+    dedup->get_stats(&stats);
+    CHECK(stats.lru_evictions == 2u);
+    CHECK(stats.unique_tags == 6u);
+    CHECK(slot_of(1u) == CLUSTER_ENTRIES);
+    CHECK(slot_of(2u) == CLUSTER_ENTRIES);
+    CHECK(slot_of(0u) != CLUSTER_ENTRIES);
+
+    uint16_t const expected[] = {7u, 6u, 0u, 5u, 4u, 3u};
+    struct Ex10TagDedupEntry copies[LRU_ENTRIES];
+    size_t const count = dedup->snapshot(copies, LRU_ENTRIES);
+    CHECK(count == 6u);
+    for (size_t iter = 0u; iter < count && iter < 6u; ++iter)
+    {
+        CHECK(snapshot_tag(&copies[iter]) == expected[iter]);
+    }
+}
+
+int main(void)
+{
+    test_delete_in_cluster();
+    test_lru_eviction_order();
+
+    printf("tag_dedup_table_test: %s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
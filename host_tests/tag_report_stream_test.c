@@ -0,0 +1,239 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file tag_report_stream_test.c
+ * Host round trip test of the binary tag report stream: tag reads are
+ * written with Ex10TagReportStream, hex encoded into "TR:" log lines as the
+ * Gen2X continuous inventory example does, and decoded with
+ * toi-process/tag_report_decode.c. The decoded CSV must match the lines
+ * the example prints when TOI_LOGS_BINARY is clear. A small ring buffer
+ * and a sink which takes only part of each flush exercise the ring wrap.
+ *
+ * Build and run on Linux from this directory:
+ *   cc -std=gnu11 -Wall -pthread -DEX10_OSAL_TYPE=EX10_OS_TYPE_POSIX \
+ *       -I ../src -I ../src/include -I ../src/board \
+ *       -o tag_report_stream_test tag_report_stream_test.c \
+ *       host_osal_posix.c ../src/src/ex10_api/ex10_tag_report_stream.c
+ *   ./tag_report_stream_test
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAG_REPORT_DECODE_NO_MAIN
+#include "../toi-process/tag_report_decode.c"
+
+/// Smaller than two of the longest records, so the ring wraps.
+#define RING_SIZE ((size_t)160u)
+
+/// The most bytes the sink takes per call.
+#define SINK_CHUNK ((size_t)40u)
+
+/// The bytes left in the ring after each write, so that records wrap.
+#define RING_BACKLOG ((size_t)30u)
+
+/// The stream bytes per log line, as in the example.
+#define LOG_LINE_BYTES ((size_t)48u)
+
+#define REPORT_COUNT ((size_t)24u)
+
+static uint8_t ring[RING_SIZE];
+
+/// The "TR:" log written by the sink.
+static char   log_text[64u * 1024u];
+static size_t log_length = 0u;
+
+static int failures = 0;
+
+#define CHECK(condition)                                                 \
+    do                                                                   \
+    {                                                                    \
+        if (!(condition))                                                \
+        {                                                                \
+            printf("%s:%d: check failed: %s\n",                          \
+                   __FILE__,                                             \
+                   __LINE__,                                             \
+                   #condition);                                          \
+            failures += 1;                                               \
+        }                                                                \
+    } while (0)
+
+/// Hex encode up to SINK_CHUNK bytes into log lines, like a slow UART.
+static size_t partial_log_sink(void const* data, size_t length)
+{
+    uint8_t const* bytes = (uint8_t const*)data;
+    size_t const   taken = (length < SINK_CHUNK) ? length : SINK_CHUNK;
+    for (size_t offset = 0u; offset < taken; offset += LOG_LINE_BYTES)
+    {
+        size_t const count = (taken - offset < LOG_LINE_BYTES)
+                                 ? taken - offset
+                                 : LOG_LINE_BYTES;
+        log_length += (size_t)snprintf(&log_text[log_length],
+                                       sizeof(log_text) - log_length,
+                                       TAG_REPORT_LOG_PREFIX);
+        for (size_t iter = 0u; iter < count; ++iter)
+        {
+            log_length += (size_t)snprintf(&log_text[log_length],
+                                           sizeof(log_text) - log_length,
+                                           "%02X",
+                                           bytes[offset + iter]);
+        }
+        log_text[log_length++] = '\n';
+    }
+    return taken;
+}
+
+/**
+ * Fill in tag read number index. Reads cycle through 3 channels; every
+ * fourth is a nickname read and every third carries a TID.
+ */
+static void make_report(size_t                index,
+                        struct Ex10TagReport* report,
+                        uint8_t               id[TAG_REPORT_ID_MAX_LENGTH],
+                        uint8_t               tid[TAG_REPORT_TID_MAX_LENGTH])
+{
+    bool const   nickname  = (index % 4u == 3u);
+    size_t const id_length = nickname ? 2u : 12u + 2u * (index % 3u);
+    for (size_t iter = 0u; iter < id_length; ++iter)
+    {
+        id[iter] = (uint8_t)(index * 31u + iter);
+    }
+    size_t const tid_length = (index % 3u == 0u) ? 12u : 0u;
+    for (size_t iter = 0u; iter < tid_length; ++iter)
+    {
+        tid[iter] = (uint8_t)(0xE2u + iter);
+    }
+
+    struct Ex10TagReport const tag_report = {
+        .us_counter            = 4000000000u + (uint32_t)index * 1234567u,
+        .rf_mode               = (uint16_t)(222u + index % 2u),
+        .rssi_cdbm             = (int16_t)(-7000 + (int)index * 25),
+        .phase_begin           = (uint16_t)(index * 3u),
+        .phase_end             = (uint16_t)(1000u - index),
+        .channel_index         = (channel_index_t)(index % 3u),
+        .channel_frequency_khz = 902750u + 500u * (uint32_t)(index % 3u),
+        .antenna               = (uint8_t)(1u + index % 2u),
+        .target                = (index % 2u) ? 'B' : 'A',
+        .packet_type           = 2u,
+        .epc_length            = (uint8_t)id_length,
+        .flags                 = nickname ? TAG_REPORT_FLAG_NICKNAME : 0u,
+        .id                    = id,
+        .id_length             = id_length,
+        .tid                   = tid,
+        .tid_length            = tid_length,
+    };
+    *report = tag_report;
+}
+
+/// Print a report as the example does when TOI_LOGS_BINARY is clear.
+static void print_expected(FILE* output, struct Ex10TagReport const* report)
+{
+    fprintf(output,
+            "%u,%c,%u,%u,%u,T%u,%u,",
+            report->us_counter,
+            report->target,
+            report->channel_frequency_khz,
+            report->antenna,
+            report->rf_mode,
+            report->packet_type,
+            report->epc_length);
+    if (report->flags & TAG_REPORT_FLAG_NICKNAME)
+    {
+        fprintf(output, "0x%02X%02X,", report->id[0], report->id[1]);
+    }
+    else
+    {
+        for (size_t iter = 0u; iter < report->id_length; ++iter)
+        {
+            fprintf(output, "%02X", report->id[iter]);
+        }
+        fprintf(output, ",");
+    }
+    fprintf(output,
+            "%u,%u,%i\n",
+            report->phase_begin,
+            report->phase_end,
+            report->rssi_cdbm);
+}
+
+static void test_round_trip(void)
+{
+    struct Ex10TagReportStream const* stream = get_ex10_tag_report_stream();
+    stream->init(ring, sizeof(ring), partial_log_sink);
+
+    char*  expected        = NULL;
+    size_t expected_length = 0u;
+    FILE*  expected_file   = open_memstream(&expected, &expected_length);
+    for (size_t index = 0u; index < REPORT_COUNT; ++index)
+    {
+        uint8_t              id[TAG_REPORT_ID_MAX_LENGTH];
+        uint8_t              tid[TAG_REPORT_TID_MAX_LENGTH];
+        struct Ex10TagReport report;
+        make_report(index, &report, id, tid);
+        CHECK(stream->write_tag_read(&report));
+        print_expected(expected_file, &report);
+
+        // A record does not fit after one partial flush of a full ring,
+        // so the ring is drained to a small backlog between writes.
+        while (stream->flush() > RING_BACKLOG)
+        {
+            continue;
+        }
+    }
+    fclose(expected_file);
+
+    // The partial sink takes one chunk per flush.
+    size_t flushes = 0u;
+    while ((stream->flush() > 0u) && (flushes < 100u))
+    {
+        flushes += 1u;
+    }
+    CHECK(stream->flush() == 0u);
+
+    struct Ex10TagReportStats stats;
+    stream->get_stats(&stats);
+    CHECK(stats.tag_reads == REPORT_COUNT);
+    CHECK(stats.dropped == 0u);
+
+    char*  decoded        = NULL;
+    size_t decoded_length = 0u;
+    FILE*  decoded_file   = open_memstream(&decoded, &decoded_length);
+    size_t const prefix_length = strlen(TAG_REPORT_LOG_PREFIX);
+    for (char* line = strtok(log_text, "\n"); line != NULL;
+         line       = strtok(NULL, "\n"))
+    {
+        CHECK(strncmp(line, TAG_REPORT_LOG_PREFIX, prefix_length) == 0);
+        CHECK(append_hex(decoded_file, &line[prefix_length]));
+        decode_records(decoded_file);
+    }
+    fclose(decoded_file);
+
+    CHECK(stream_length == 0u);
+    CHECK(decoded_length == expected_length);
+    CHECK(strcmp(decoded, expected) == 0);
+    free(decoded);
+    free(expected);
+}
+
+int main(void)
+{
+    test_round_trip();
+
+    printf("tag_report_stream_test: %s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,83 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+
+#include "ex10_api/ex10_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct Ex10CalibrationStore
+ * Persistent host storage holding one calibration snapshot, so that the
+ * parsed calibration can be restored at boot. The snapshot is an opaque
+ * block of bytes; its contents are validated by the calibration layer.
+ */
+struct Ex10CalibrationStore
+{
+    /**
+     * Read the start of the stored snapshot.
+     *
+     * @param buffer The destination of the bytes read.
+     * @param length The number of bytes to read.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the bytes were read. Bytes read from an
+     *         empty or erased store are not an error; the caller must
+     *         validate them.
+     */
+    struct Ex10Result (*read)(void* buffer, size_t length);
+
+    /**
+     * Replace the stored snapshot.
+     *
+     * @param buffer The snapshot bytes.
+     * @param length The number of bytes in buffer.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the snapshot was written.
+     */
+    struct Ex10Result (*write)(void const* buffer, size_t length);
+
+    /**
+     * Remove the stored snapshot.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the snapshot was removed.
+     */
+    struct Ex10Result (*erase)(void);
+};
+
+/**
+ * The MCU flash backend, provided by board/zephyr_rtos.
+ *
+ * @return The store, or NULL if the board has no flash partition for it.
+ */
+struct Ex10CalibrationStore const* get_ex10_calibration_store_flash(void);
+
+/**
+ * The file backend for POSIX hosts, provided by
+ * board/ex10_calibration_store_file.c. The snapshot is kept in the file
+ * named by EX10_CALIBRATION_STORE_FILE_PATH.
+ *
+ * @return The store.
+ */
+struct Ex10CalibrationStore const* get_ex10_calibration_store_file(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,98 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file ex10_calibration_store_file.c
+ * A calibration store kept in a file, for POSIX hosts. It allows the
+ * calibration snapshot to be exercised on Linux without MCU flash.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "board/ex10_calibration_store.h"
+#include "board/ex10_osal.h"
+
+#ifndef EX10_CALIBRATION_STORE_FILE_PATH
+#define EX10_CALIBRATION_STORE_FILE_PATH "ex10_calibration_snapshot.bin"
+#endif
+
+static struct Ex10Result read(void* buffer, size_t length)
+{
+    if (buffer == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorNullPointer);
+    }
+
+    // A missing or short file reads as an erased store.
+    ex10_memzero(buffer, length);
+
+    FILE* file = fopen(EX10_CALIBRATION_STORE_FILE_PATH, "rb");
+    if (file != NULL)
+    {
+        (void)fread(buffer, 1u, length, file);
+        fclose(file);
+    }
+    return make_ex10_success();
+}
+
+static struct Ex10Result write(void const* buffer, size_t length)
+{
+    if (buffer == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorNullPointer);
+    }
+
+    FILE* file = fopen(EX10_CALIBRATION_STORE_FILE_PATH, "wb");
+    if (file == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorInvalidState);
+    }
+
+    size_t const written = fwrite(buffer, 1u, length, file);
+    int const    closed  = fclose(file);
+
+    return (written == length && closed == 0)
+               ? make_ex10_success()
+               : make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                     Ex10SdkErrorInvalidState);
+}
+
+static struct Ex10Result erase(void)
+{
+    if (remove(EX10_CALIBRATION_STORE_FILE_PATH) != 0)
+    {
+        FILE* file = fopen(EX10_CALIBRATION_STORE_FILE_PATH, "rb");
+        if (file != NULL)
+        {
+            fclose(file);
+            return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                       Ex10SdkErrorInvalidState);
+        }
+    }
+    return make_ex10_success();
+}
+
+static struct Ex10CalibrationStore const ex10_calibration_store_file = {
+    .read  = read,
+    .write = write,
+    .erase = erase,
+};
+
+struct Ex10CalibrationStore const* get_ex10_calibration_store_file(void)
+{
+    return &ex10_calibration_store_file;
+}
@@ -31,11 +31,21 @@ extern "C" {
 #define RESULT_FIFO_BUFFER_SIZE_BYTES \
     (sizeof(struct PacketHeader) + sizeof(struct Ex10Result))
 
+/**
+ * @struct FifoBufferPool
+ * The memory used by a FifoBufferList.
+ *
+ * When arena is NULL, fifo_buffers holds buffer_count fixed size buffers,
+ * one for each of the fifo_buffer_nodes. When arena is set, fifo_buffers is
+ * unused and the buffer_count fifo_buffer_nodes are allocated from the arena,
+ * each sized to the EventFifo data it holds.
+ */
 struct FifoBufferPool
 {
     struct FifoBufferNode* fifo_buffer_nodes;
     struct ByteSpan const* fifo_buffers;
     size_t const           buffer_count;
+    struct ByteSpan const* arena;
 };
 
 struct FifoBufferPool const* get_ex10_event_fifo_buffer_pool(void);
@@ -17,6 +17,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "ex10_api/gpio_interface.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -151,6 +153,16 @@ struct Ex10GpioDriver
      */
     bool (*irq_monitor_callback_is_enabled)(void);
 
+    /**
+     * Set a callback which the IRQ_N monitor thread calls periodically,
+     * whether or not IRQ_N asserts. It is called only while the registered
+     * IRQ_N callback is enabled, and never at the same time as it.
+     *
+     * @param cb_func   The function to call, or NULL to stop the calls.
+     * @param period_ms The interval between calls. Zero stops the calls.
+     */
+    void (*set_irq_tick_callback)(void (*cb_func)(void), uint32_t period_ms);
+
     /**
      * Locks or unlocks access to the host (SPI) and GPIO interfaces to guard
      * against pre-emptive access to the hardware interfaces.
@@ -229,6 +241,28 @@ struct Ex10GpioDriver
      */
     int32_t (*busy_wait_ready_n)(uint32_t timeout_ms);
 
+    /**
+     * Waits for the READY_N pin to assert LOW with a specified timeout,
+     * using the requested wait method.
+     *
+     * When wait_mode is ReadyNWaitInterrupt the READY_N line is polled for
+     * an adaptive interval, sized from the duration of recent waits, before
+     * the calling thread blocks on the READY_N edge interrupt. Short waits
+     * therefore keep the polling latency while long waits release the CPU.
+     *
+     * Every wait, including those made through busy_wait_ready_n(), is
+     * accumulated into the statistics returned by get_ready_n_wait_stats().
+     *
+     * @param timeout_ms The amount of time to wait, in milliseconds, for
+     *                   READY_N to assert.
+     * @param wait_mode  The method used to wait for READY_N.
+     *
+     * @return int32_t Indicates success or failure.
+     * @retval         0 The call was successful.
+     * @retval        -1 READY_N did not assert before the timeout expired.
+     */
+    int32_t (*wait_ready_n)(uint32_t timeout_ms, enum ReadyNWaitMode wait_mode);
+
     /**
      * Get the state of the READY_N GPI line.
      *
@@ -236,6 +270,19 @@ struct Ex10GpioDriver
      */
     int32_t (*ready_n_pin_get)(void);
 
+    /**
+     * Get a copy of the accumulated READY_N wait statistics.
+     *
+     * @param stats The statistics structure to fill in.
+     */
+    void (*get_ready_n_wait_stats)(struct ReadyNWaitStats* stats);
+
+    /**
+     * Clear the accumulated READY_N wait statistics.
+     * The adaptive polling interval is retained.
+     */
+    void (*reset_ready_n_wait_stats)(void);
+
     /**
      * Get the voltage level of the pin.
      *
@@ -47,6 +47,63 @@ struct Ex10SpiDriver
      * If not all bytes are received properly, a -1 is returned.
      */
     int32_t (*spi_read)(void* rx_buff, size_t length);
+
+    /**
+     * Start a write transaction and return without waiting for it to
+     * complete. CS is deasserted as soon as the transfer completes; its
+     * result is collected by spi_wait_async(). If a previous asynchronous
+     * transfer is still outstanding it is completed before this one is
+     * started.
+     *
+     * @param tx_buff Buffer containing the data to be written. It must
+     *                remain valid until spi_wait_async() returns.
+     * @param length  The number of bytes to write from tx_buff
+     *
+     * @return 0 if the transfer was started, -1 on failure.
+     */
+    int32_t (*spi_write_async)(const void* tx_buff, size_t length);
+
+    /**
+     * Start a read transaction and return without waiting for it to
+     * complete. The same rules apply as for spi_write_async().
+     *
+     * @param rx_buff Buffer in which to place incoming data. It must
+     *                remain valid until spi_wait_async() returns.
+     * @param length  The number of bytes to read into rx_buff
+     *
+     * @return 0 if the transfer was started, -1 on failure.
+     */
+    int32_t (*spi_read_async)(void* rx_buff, size_t length);
+
+    /**
+     * Block until the outstanding asynchronous transfer completes. The
+     * calling thread sleeps on the SPI completion signal. CS is deasserted
+     * by the SPI interrupt when the transfer completes, not by this call, so
+     * the Ex10 can act on an asynchronously written command before the
+     * caller collects it.
+     *
+     * @return The number of bytes transferred, 0 if there was no
+     *         outstanding transfer, or -1 if the transfer failed.
+     */
+    int32_t (*spi_wait_async)(void);
+
+    /**
+     * The number of CS framed transfers started since the program started.
+     * The count wraps around.
+     *
+     * @return The number of transfers started.
+     */
+    uint32_t (*spi_get_transfer_count)(void);
+
+    /**
+     * The clock speeds at which the SPI peripheral runs the bus.
+     *
+     * @param clock_rates_hz Set to the clock speeds in Hz, in ascending
+     *                       order.
+     *
+     * @return The number of entries in clock_rates_hz.
+     */
+    size_t (*spi_get_clock_rates)(uint32_t const** clock_rates_hz);
 };
 
 struct Ex10SpiDriver const* get_ex10_spi_driver(void);
@@ -42,6 +42,16 @@ struct Ex10TimeHelpers
      */
     uint32_t (*time_elapsed)(uint32_t start_time);
 
+    /**
+     * Grabs the current time with microsecond resolution, for measuring
+     * short intervals. The value wraps around after about 71 minutes; take
+     * the unsigned difference of two values to get the elapsed time.
+     *
+     * @return uint32_t The number of microseconds elapsed since the
+     *                  start of the program.
+     */
+    uint32_t (*time_now_us)(void);
+
     /**
      * Wait for a specific number of milliseconds.
      *
@@ -19,15 +19,20 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "board/board_spec.h"
+#include "board/ex10_calibration_store.h"
+#include "board/ex10_osal.h"
 #include "board/zephyr_rtos/calibration.h"
 #include "board/zephyr_rtos/calibration_v5.h"
 #include "board/zephyr_rtos/rssi_compensation_lut.h"
 #include "board/ex10_rx_baseband_filter.h"
 #include "ex10_api/application_registers.h"
+#include "ex10_api/crc16.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_boot_profiler.h"
 #include "ex10_api/ex10_macros.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_rf_power.h"
@@ -49,6 +54,79 @@ static uint16_t non_drm_analog_freq_khz[NUM_NON_DRM_CAL_MODES] = {0};
 static struct RssiCompensationLut const*  rssi_comp          = NULL;
 static struct Ex10RxBasebandFilter const* rx_baseband_filter = NULL;
 
+/**
+ * The RSSI gain and RF mode offset of a receive configuration, cached so
+ * that compensating each tag read does not search the RF mode table and
+ * interpolate the baseband offsets again.
+ */
+struct RxOffsetCacheEntry
+{
+    bool                       valid;
+    enum RfModes               rf_mode;
+    uint8_t                    antenna;
+    enum RfFilter              rf_band;
+    struct RxGainControlFields rx_settings;
+    int32_t                    offset;
+};
+
+/// The number of receive configurations held in rx_offset_cache.
+#define RX_OFFSET_CACHE_ENTRIES 4u
+
+static struct RxOffsetCacheEntry rx_offset_cache[RX_OFFSET_CACHE_ENTRIES];
+static size_t                    rx_offset_cache_next = 0;
+
+/// Marks a power config cache level or channel without an entry.
+#define POWER_CONFIG_NO_ENTRY UINT8_MAX
+
+/**
+ * The power configs of one channel table entry at one TX power level,
+ * computed for a temperature bucket of POWER_CONFIG_TEMP_BUCKET_ADC
+ * temperature ADC counts.
+ */
+struct PowerConfigCacheEntry
+{
+    /// The power_config_levels index; POWER_CONFIG_NO_ENTRY when unused.
+    uint8_t             level;
+    channel_index_t     channel_index;
+    uint32_t            frequency_khz;
+    uint16_t            temperature_bucket;
+    struct PowerConfigs power_configs;
+};
+
+/**
+ * A TX power level, and everything else compute_power_control_params()
+ * depends on apart from the channel and temperature. Only the channels
+ * which are used hold an entry, so that ramping up on a channel again does
+ * not repeat the calibration table interpolation.
+ */
+struct PowerConfigCacheLevel
+{
+    bool              valid;
+    int16_t           tx_power_cdbm;
+    int16_t           max_power_cdbm;
+    bool              with_boost;
+    bool              temp_comp_enabled;
+    enum RfFilter     rf_band;
+    enum Ex10RegionId region_id;
+    /// The power_config_entries index of each channel.
+    uint8_t entries[MAX_CHANNELS];
+};
+
+/// The width of a power config temperature bucket in temperature ADC counts.
+#define POWER_CONFIG_TEMP_BUCKET_ADC ((uint16_t)4u)
+
+static struct PowerConfigCacheLevel
+    power_config_levels[POWER_CONTROL_CACHE_LEVELS];
+static size_t power_config_level_next = 0;
+
+static struct PowerConfigCacheEntry
+              power_config_entries[POWER_CONTROL_CACHE_ENTRIES];
+static size_t power_config_entry_next = 0;
+
+/// The unused power_config_entries indices.
+static uint8_t power_config_free_entries[POWER_CONTROL_CACHE_ENTRIES];
+static size_t  power_config_free_count = 0;
+
 /**
  * This function calculates interpolated value (x_new, y_new) from
  * existing points (x, y).
@@ -516,51 +594,6 @@ static uint16_t cdbm_to_log2(struct Ex10CalibrationParamsV5 const* cal_params,
     return (uint16_t)log2_val;
 }
 
-/**
- * Compensates RSSI value for temperature, analog settings, and RF mode
- * based on calibration table.
- *
- * @param rssi_raw      Raw RSSI_LOG_2 value from firmware op
- * @param rf_mode       RF mode
- * @param rx_settings   Settings corresponding to RxGainControl register
- * @param antenna       Antenna port used
- * @param rf_band       Which RF band we are using
- * @param temp_adc      Temperature ADC code
- * @param baseband_freq The baseband frequency at which we expect the signal
- *
- * @return int16_t     Compensated RSSI value in cdBm
- */
-static int16_t get_compensated_rssi_baseband_freq_offset(
-    uint16_t                          rssi_raw,
-    enum RfModes                      rf_mode,
-    const struct RxGainControlFields* rx_settings,
-    uint8_t                           antenna,
-    enum RfFilter                     rf_band,
-    uint16_t                          temp_adc,
-    int16_t                           baseband_freq)
-{
-    if (cal_version != 0x05)
-    {
-        return (int16_t)rssi_raw;
-    }
-
-    struct Ex10CalibrationParamsV5 const* cal_params =
-        get_ex10_cal_v5()->get_params();
-
-    int16_t const gain_offset =
-        get_gain_offset(cal_params, rx_settings, antenna, rf_band);
-    int16_t const mode_offset = get_mode_rssi_offset(rf_mode, baseband_freq);
-    int16_t const temp_offset = get_temp_offset(cal_params, temp_adc);
-
-    int32_t const rssi_log2_compensated =
-        rssi_raw - gain_offset - mode_offset - temp_offset;
-
-    int16_t const rssi_cdbm =
-        log2_to_cdbm(cal_params, (uint16_t)rssi_log2_compensated);
-
-    return rssi_cdbm;
-}
-
 static uint16_t get_rf_mode_baseband_freq_khz(enum RfModes rf_mode)
 {
     if (rssi_comp == NULL)
@@ -581,86 +614,115 @@ static uint16_t get_rf_mode_baseband_freq_khz(enum RfModes rf_mode)
     return 0;
 }
 
+static bool rx_settings_match(struct RxGainControlFields const* lhs,
+                              struct RxGainControlFields const* rhs)
+{
+    return (lhs->rx_atten == rhs->rx_atten) &&
+           (lhs->pga1_gain == rhs->pga1_gain) &&
+           (lhs->pga2_gain == rhs->pga2_gain) &&
+           (lhs->pga3_gain == rhs->pga3_gain) &&
+           (lhs->mixer_gain == rhs->mixer_gain);
+}
+
+static void invalidate_rx_offset_cache(void)
+{
+    for (size_t idx = 0; idx < ARRAY_SIZE(rx_offset_cache); ++idx)
+    {
+        rx_offset_cache[idx].valid = false;
+    }
+    rx_offset_cache_next = 0;
+}
+
 /**
- * Compensates RSSI value for temperature, analog settings, and RF mode
- * based on calibration table.
+ * Get the gain and RF mode offset for RSSI compensation. The offset depends
+ * only on the receive configuration, which rarely changes during a round,
+ * so it is looked up in rx_offset_cache and only computed on a miss.
  *
- * @param rssi_raw     Raw RSSI_LOG_2 value from firmware op
+ * @param cal_params   pointer to the calibration table
  * @param rf_mode      RF mode
  * @param rx_settings  Settings corresponding to RxGainControl register
  * @param antenna      Antenna port used
  * @param rf_band      Which RF band we are using
- * @param temp_adc     Temperature ADC code
  *
- * @return int16_t     Compensated RSSI value in cdBm
+ * @return The summed gain and RF mode offsets in rssi log2 units.
  */
-static int16_t get_compensated_rssi(
-    uint16_t                          rssi_raw,
-    enum RfModes                      rf_mode,
-    const struct RxGainControlFields* rx_settings,
-    uint8_t                           antenna,
-    enum RfFilter                     rf_band,
-    uint16_t                          temp_adc)
+static int32_t get_rx_offset(struct Ex10CalibrationParamsV5 const* cal_params,
+                             enum RfModes                          rf_mode,
+                             const struct RxGainControlFields*     rx_settings,
+                             uint8_t                               antenna,
+                             enum RfFilter                         rf_band)
 {
+    for (size_t idx = 0; idx < ARRAY_SIZE(rx_offset_cache); ++idx)
+    {
+        struct RxOffsetCacheEntry const* entry = &rx_offset_cache[idx];
+        if (entry->valid && entry->rf_mode == rf_mode &&
+            entry->antenna == antenna && entry->rf_band == rf_band &&
+            rx_settings_match(&entry->rx_settings, rx_settings))
+        {
+            return entry->offset;
+        }
+    }
+
     int16_t const baseband_freq =
         (int16_t)get_rf_mode_baseband_freq_khz(rf_mode);
-    int16_t const rssi_cdbm =
-        get_compensated_rssi_baseband_freq_offset(rssi_raw,
-                                                  rf_mode,
-                                                  rx_settings,
-                                                  antenna,
-                                                  rf_band,
-                                                  temp_adc,
-                                                  baseband_freq);
-    return rssi_cdbm;
+    int16_t const gain_offset =
+        get_gain_offset(cal_params, rx_settings, antenna, rf_band);
+    int16_t const mode_offset = get_mode_rssi_offset(rf_mode, baseband_freq);
+
+    // Replace the entries in turn; only a few configurations are active.
+    struct RxOffsetCacheEntry* entry = &rx_offset_cache[rx_offset_cache_next];
+    rx_offset_cache_next =
+        (rx_offset_cache_next + 1) % ARRAY_SIZE(rx_offset_cache);
+
+    entry->valid       = true;
+    entry->rf_mode     = rf_mode;
+    entry->antenna     = antenna;
+    entry->rf_band     = rf_band;
+    entry->rx_settings = *rx_settings;
+    entry->offset      = (int32_t)gain_offset + mode_offset;
+
+    return entry->offset;
 }
 
 /**
- * Convert RSSI value in cdBm back to RSSI log2 counts using the
- * temperature, analog settings, and RF mode.
+ * Compensates RSSI value for temperature, analog settings, and RF mode
+ * based on calibration table.
  *
- * @param rssi_cdbm      Compensated RSSI value in cdBm
- * @param rf_mode        RF mode
- * @param rx_settings    Settings corresponding to RxGainControl register
- * @param antenna        Antenna port used
- * @param rf_band        Which RF band we are using
- * @param temp_adc       Temperature ADC code
- * @param baseband_freq  The baseband frequency at which we expect the signal
+ * @param rssi_raw     Raw RSSI_LOG_2 value from firmware op
+ * @param rf_mode      RF mode
+ * @param rx_settings  Settings corresponding to RxGainControl register
+ * @param antenna      Antenna port used
+ * @param rf_band      Which RF band we are using
+ * @param temp_adc     Temperature ADC code
  *
- * @return RSSI value in LOG2 counts derived from the RSSI value in cdBm
+ * @return int16_t     Compensated RSSI value in cdBm
  */
-static uint16_t get_rssi_log2_baseband_freq_offset(
-    int16_t                           rssi_cdbm,
+static int16_t get_compensated_rssi(
+    uint16_t                          rssi_raw,
     enum RfModes                      rf_mode,
     const struct RxGainControlFields* rx_settings,
     uint8_t                           antenna,
     enum RfFilter                     rf_band,
-    uint16_t                          temp_adc,
-    int16_t                           baseband_freq)
+    uint16_t                          temp_adc)
 {
     if (cal_version != 0x05)
     {
-        return (uint16_t)0u;
+        return (int16_t)rssi_raw;
     }
 
     struct Ex10CalibrationParamsV5 const* cal_params =
         get_ex10_cal_v5()->get_params();
 
-    int16_t const gain_offset =
-        get_gain_offset(cal_params, rx_settings, antenna, rf_band);
-    int16_t const mode_offset = get_mode_rssi_offset(rf_mode, baseband_freq);
+    int32_t const rx_offset =
+        get_rx_offset(cal_params, rf_mode, rx_settings, antenna, rf_band);
     int16_t const temp_offset = get_temp_offset(cal_params, temp_adc);
 
-    uint16_t const rssi_log2_compensated = cdbm_to_log2(cal_params, rssi_cdbm);
+    int32_t const rssi_log2_compensated = rssi_raw - rx_offset - temp_offset;
 
-    int16_t const rssi_log2 = (int16_t)rssi_log2_compensated + gain_offset +
-                              mode_offset + temp_offset;
-    if (rssi_log2 <= 0)
-    {
-        return (uint16_t)0u;
-    }
+    int16_t const rssi_cdbm =
+        log2_to_cdbm(cal_params, (uint16_t)rssi_log2_compensated);
 
-    return (uint16_t)rssi_log2;
+    return rssi_cdbm;
 }
 
 /**
@@ -683,17 +745,28 @@ static uint16_t get_rssi_log2(int16_t                           rssi_cdbm,
                               enum RfFilter                     rf_band,
                               uint16_t                          temp_adc)
 {
-    int16_t const baseband_freq =
-        (int16_t)get_rf_mode_baseband_freq_khz(rf_mode);
-    uint16_t const rssi_log2 =
-        get_rssi_log2_baseband_freq_offset(rssi_cdbm,
-                                           rf_mode,
-                                           rx_settings,
-                                           antenna,
-                                           rf_band,
-                                           temp_adc,
-                                           baseband_freq);
-    return rssi_log2;
+    if (cal_version != 0x05)
+    {
+        return (uint16_t)0u;
+    }
+
+    struct Ex10CalibrationParamsV5 const* cal_params =
+        get_ex10_cal_v5()->get_params();
+
+    int32_t const rx_offset =
+        get_rx_offset(cal_params, rf_mode, rx_settings, antenna, rf_band);
+    int16_t const temp_offset = get_temp_offset(cal_params, temp_adc);
+
+    uint16_t const rssi_log2_compensated = cdbm_to_log2(cal_params, rssi_cdbm);
+
+    int16_t const rssi_log2 = (int16_t)(
+        (int16_t)rssi_log2_compensated + rx_offset + temp_offset);
+    if (rssi_log2 <= 0)
+    {
+        return (uint16_t)0u;
+    }
+
+    return (uint16_t)rssi_log2;
 }
 
 /**
@@ -1613,12 +1686,13 @@ static int16_t get_max_power_cdbm(void)
                                                     : max_board_power;
 }
 
-static struct PowerConfigs get_power_control_params(int16_t  tx_power_cdbm,
-                                                    bool     with_boost,
-                                                    uint32_t frequency_khz,
-                                                    uint16_t temperature_adc,
-                                                    bool     temp_comp_enabled,
-                                                    enum RfFilter rf_band)
+static struct PowerConfigs compute_power_control_params(
+    int16_t       tx_power_cdbm,
+    bool          with_boost,
+    uint32_t      frequency_khz,
+    uint16_t      temperature_adc,
+    bool          temp_comp_enabled,
+    enum RfFilter rf_band)
 {
     if (cal_version == 0xFF)
     {
@@ -1717,6 +1791,451 @@ static struct PowerConfigs get_power_control_params(int16_t  tx_power_cdbm,
     return power_configs;
 }
 
+static void invalidate_power_config_cache(void)
+{
+    for (size_t idx = 0; idx < ARRAY_SIZE(power_config_levels); ++idx)
+    {
+        power_config_levels[idx].valid = false;
+        ex10_memset(power_config_levels[idx].entries,
+                    sizeof(power_config_levels[idx].entries),
+                    POWER_CONFIG_NO_ENTRY,
+                    sizeof(power_config_levels[idx].entries));
+    }
+    for (size_t idx = 0; idx < ARRAY_SIZE(power_config_entries); ++idx)
+    {
+        power_config_entries[idx].level = POWER_CONFIG_NO_ENTRY;
+        power_config_free_entries[idx]  = (uint8_t)idx;
+    }
+    power_config_free_count = ARRAY_SIZE(power_config_entries);
+    power_config_level_next = 0;
+    power_config_entry_next = 0;
+}
+
+static void release_power_config_entry(uint8_t entry_index)
+{
+    struct PowerConfigCacheEntry* entry = &power_config_entries[entry_index];
+    power_config_levels[entry->level].entries[entry->channel_index] =
+        POWER_CONFIG_NO_ENTRY;
+    entry->level = POWER_CONFIG_NO_ENTRY;
+
+    power_config_free_entries[power_config_free_count] = entry_index;
+    power_config_free_count += 1;
+}
+
+/**
+ * Claim an entry for a channel of a level, replacing the entries in turn
+ * once all are in use.
+ */
+static struct PowerConfigCacheEntry* claim_power_config_entry(
+    uint8_t         level_index,
+    channel_index_t channel_index)
+{
+    if (power_config_free_count == 0)
+    {
+        release_power_config_entry((uint8_t)power_config_entry_next);
+        power_config_entry_next =
+            (power_config_entry_next + 1) % ARRAY_SIZE(power_config_entries);
+    }
+
+    power_config_free_count -= 1;
+    uint8_t const entry_index =
+        power_config_free_entries[power_config_free_count];
+    struct PowerConfigCacheEntry* entry = &power_config_entries[entry_index];
+    entry->level                        = level_index;
+    entry->channel_index                = channel_index;
+
+    power_config_levels[level_index].entries[channel_index] = entry_index;
+    return entry;
+}
+
+/**
+ * Find the cached power configs of a TX power level, or claim a level for
+ * them, replacing the levels in turn.
+ *
+ * @return The power_config_levels index. A newly claimed level has no
+ *         channel entries.
+ */
+static uint8_t find_power_config_level(int16_t       tx_power_cdbm,
+                                       bool          with_boost,
+                                       bool          temp_comp_enabled,
+                                       enum RfFilter rf_band)
+{
+    enum Ex10RegionId const region_id =
+        get_ex10_active_region()->get_region_id();
+    int16_t const max_power_cdbm = get_max_power_cdbm();
+
+    for (size_t idx = 0; idx < ARRAY_SIZE(power_config_levels); ++idx)
+    {
+        struct PowerConfigCacheLevel const* level = &power_config_levels[idx];
+        if (level->valid && level->tx_power_cdbm == tx_power_cdbm &&
+            level->max_power_cdbm == max_power_cdbm &&
+            level->with_boost == with_boost &&
+            level->temp_comp_enabled == temp_comp_enabled &&
+            level->rf_band == rf_band && level->region_id == region_id)
+        {
+            return (uint8_t)idx;
+        }
+    }
+
+    uint8_t const level_index = (uint8_t)power_config_level_next;
+    power_config_level_next =
+        (power_config_level_next + 1) % ARRAY_SIZE(power_config_levels);
+
+    struct PowerConfigCacheLevel* level = &power_config_levels[level_index];
+    for (size_t idx = 0; idx < ARRAY_SIZE(level->entries); ++idx)
+    {
+        if (level->entries[idx] != POWER_CONFIG_NO_ENTRY)
+        {
+            release_power_config_entry(level->entries[idx]);
+        }
+    }
+
+    level->valid             = true;
+    level->tx_power_cdbm     = tx_power_cdbm;
+    level->max_power_cdbm    = max_power_cdbm;
+    level->with_boost        = with_boost;
+    level->temp_comp_enabled = temp_comp_enabled;
+    level->rf_band           = rf_band;
+    level->region_id         = region_id;
+
+    return level_index;
+}
+
+static struct PowerConfigs get_power_control_params(int16_t  tx_power_cdbm,
+                                                    bool     with_boost,
+                                                    uint32_t frequency_khz,
+                                                    uint16_t temperature_adc,
+                                                    bool     temp_comp_enabled,
+                                                    enum RfFilter rf_band)
+{
+    channel_index_t const channel_index =
+        get_ex10_active_region()->get_channel_index(frequency_khz);
+
+    // Only the V5 calibration configs are cached, once cal_init() has set
+    // up the cache. The uncalibrated configs are cheap to compute, and
+    // frequencies outside the channel table are not cached.
+    if (cal_version != 0x05 || channel_index >= MAX_CHANNELS)
+    {
+        return compute_power_control_params(tx_power_cdbm,
+                                            with_boost,
+                                            frequency_khz,
+                                            temperature_adc,
+                                            temp_comp_enabled,
+                                            rf_band);
+    }
+
+    // Without temperature compensation the temperature is not used, so all
+    // temperatures share bucket 0.
+    uint16_t const temperature_bucket =
+        temp_comp_enabled ? temperature_adc / POWER_CONFIG_TEMP_BUCKET_ADC : 0u;
+
+    uint8_t const level_index = find_power_config_level(
+        tx_power_cdbm, with_boost, temp_comp_enabled, rf_band);
+    uint8_t const entry_index =
+        power_config_levels[level_index].entries[channel_index];
+
+    struct PowerConfigCacheEntry* entry =
+        (entry_index != POWER_CONFIG_NO_ENTRY)
+            ? &power_config_entries[entry_index]
+            : NULL;
+    if (entry == NULL || entry->frequency_khz != frequency_khz ||
+        entry->temperature_bucket != temperature_bucket)
+    {
+        if (entry == NULL)
+        {
+            entry = claim_power_config_entry(level_index, channel_index);
+        }
+
+        // Compensate for the temperature at the center of the bucket.
+        uint16_t const bucket_temperature_adc =
+            (uint16_t)(temperature_bucket * POWER_CONFIG_TEMP_BUCKET_ADC +
+                       POWER_CONFIG_TEMP_BUCKET_ADC / 2u);
+
+        entry->frequency_khz      = frequency_khz;
+        entry->temperature_bucket = temperature_bucket;
+        entry->power_configs =
+            compute_power_control_params(tx_power_cdbm,
+                                         with_boost,
+                                         frequency_khz,
+                                         bucket_temperature_adc,
+                                         temp_comp_enabled,
+                                         rf_band);
+    }
+
+    return entry->power_configs;
+}
+
+static void prepare_power_control_params(int16_t  tx_power_cdbm,
+                                         bool     with_boost,
+                                         uint16_t temperature_adc,
+                                         bool     temp_comp_enabled)
+{
+    struct Ex10ActiveRegion const* region = get_ex10_active_region();
+
+    channel_size_t const channel_count = region->get_channel_table_size();
+    for (channel_index_t idx = 0; idx < channel_count; ++idx)
+    {
+        uint32_t                frequency_khz = 0;
+        struct Ex10Result const ex10_result =
+            region->get_adjacent_channel_khz(idx, 0, &frequency_khz);
+        if (ex10_result.error)
+        {
+            continue;
+        }
+        get_power_control_params(tx_power_cdbm,
+                                 with_boost,
+                                 frequency_khz,
+                                 temperature_adc,
+                                 temp_comp_enabled,
+                                 region->get_rf_filter());
+    }
+}
+
+/// Identifies a calibration snapshot, "CALS" in little endian byte order.
+#define CALIBRATION_SNAPSHOT_MAGIC ((uint32_t)0x534C4143u)
+
+/// Changed whenever the snapshot layout or the derived tables change.
+#define CALIBRATION_SNAPSHOT_FORMAT ((uint16_t)2u)
+
+/// The SDK version the snapshot is keyed on; set by the build.
+#ifndef EX10_SDK_VERSION
+#define EX10_SDK_VERSION "unknown"
+#endif
+
+// A snapshot is keyed on the Ex10 SerialNumber register, so that a snapshot
+// saved for one device is never used for another. When the serial number
+// matches, the calibration page is not read over SPI, which is where the
+// snapshot saves boot time; the boot profiler reports the page read as its
+// own phase. When the serial number can not be read, or is not programmed,
+// the page is always read and the snapshot is only used if its CRC matches.
+// When true, the page is read and its CRC checked for every boot. This also
+// notices a device recalibrated without changing its calibration versions,
+// but saves only the derived table computation.
+#define CALIBRATION_SNAPSHOT_CHECK_DEVICE_CRC (false)
+
+/**
+ * The parsed calibration and the tables derived from it, as saved in the
+ * calibration store.
+ */
+struct CalibrationSnapshot
+{
+    uint32_t magic;
+    uint16_t format;
+    uint16_t length;
+    uint8_t  cal_version;
+    uint8_t  customer_cal_version;
+    /// The Ex10CalibrationV5.get_crc() value of the device calibration.
+    uint16_t cal_crc;
+    /// The CRC of the RSSI compensation LUT used to derive the tables.
+    uint16_t rssi_comp_crc;
+    /// The CRC of the EX10_SDK_VERSION string of the build which saved it.
+    uint16_t sdk_version_crc;
+    /// The SerialNumber register of the device, or zeros if it was unknown.
+    uint8_t serial_number[SERIAL_NUMBER_REG_LENGTH];
+
+    struct Ex10CalibrationParamsV5 params;
+
+    int16_t  drm_analog_offset[NUM_DRM_CAL_MODES];
+    int16_t  non_drm_analog_offset[NUM_NON_DRM_CAL_MODES];
+    uint16_t drm_analog_freq_khz[NUM_DRM_CAL_MODES];
+    uint16_t non_drm_analog_freq_khz[NUM_NON_DRM_CAL_MODES];
+
+    /// The CRC of all of the preceding bytes.
+    uint16_t snapshot_crc;
+};
+
+static struct Ex10CalibrationStore const* calibration_store = NULL;
+static struct CalibrationSnapshot         calibration_snapshot;
+
+static uint16_t get_snapshot_crc(struct CalibrationSnapshot const* snapshot)
+{
+    return ex10_compute_crc16(snapshot,
+                              offsetof(struct CalibrationSnapshot,
+                                       snapshot_crc));
+}
+
+/**
+ * The CRC of the RSSI compensation LUT fields which the analog offsets are
+ * derived from, so that a snapshot is not used with a different LUT.
+ */
+static uint16_t get_rssi_comp_crc(void)
+{
+    uint16_t crc = UINT16_MAX;
+    crc = ex10_compute_crc16_partial(
+        &rssi_comp->num_modes, sizeof(rssi_comp->num_modes), crc);
+    crc = ex10_compute_crc16_partial(
+        rssi_comp->rf_modes, rssi_comp->num_modes * sizeof(uint16_t), crc);
+    crc = ex10_compute_crc16_partial(rssi_comp->rf_mode_to_rx_mode,
+                                     rssi_comp->num_modes * sizeof(uint16_t),
+                                     crc);
+    crc = ex10_compute_crc16_partial(
+        rssi_comp->drm_cal_modes, sizeof(rssi_comp->drm_cal_modes), crc);
+    crc = ex10_compute_crc16_partial(rssi_comp->non_drm_cal_modes,
+                                     sizeof(rssi_comp->non_drm_cal_modes),
+                                     crc);
+    crc = ex10_compute_crc16_partial(
+        rssi_comp->rx_mode_digital_correction,
+        sizeof(rssi_comp->rx_mode_digital_correction),
+        crc);
+    return crc;
+}
+
+static uint16_t get_sdk_version_crc(void)
+{
+    static char const sdk_version[] = EX10_SDK_VERSION;
+    return ex10_compute_crc16(sdk_version, sizeof(sdk_version) - 1u);
+}
+
+/**
+ * Read the SerialNumber register, which identifies the Ex10 device.
+ *
+ * @param ex10_protocol      The protocol used to read the register.
+ * @param [out] serial_number The serial number read.
+ *
+ * @return bool True if the register was read and is programmed, i.e. is
+ *              neither all zeros nor all ones.
+ */
+static bool read_serial_number(
+    struct Ex10Protocol const* ex10_protocol,
+    uint8_t                    serial_number[SERIAL_NUMBER_REG_LENGTH])
+{
+    struct Ex10Result const ex10_result =
+        ex10_protocol->read(&serial_number_reg, serial_number);
+    if (ex10_result.error)
+    {
+        ex10_memzero(serial_number, SERIAL_NUMBER_REG_LENGTH);
+        return false;
+    }
+
+    bool all_zeros = true;
+    bool all_ones  = true;
+    for (size_t iter = 0u; iter < SERIAL_NUMBER_REG_LENGTH; ++iter)
+    {
+        all_zeros = all_zeros && (serial_number[iter] == 0x00u);
+        all_ones  = all_ones && (serial_number[iter] == 0xFFu);
+    }
+    if (all_zeros || all_ones)
+    {
+        ex10_memzero(serial_number, SERIAL_NUMBER_REG_LENGTH);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Read the snapshot from the calibration store into calibration_snapshot.
+ *
+ * @param serial_number The serial number of the device, or NULL if it is
+ *                      not known and the snapshot is not to be checked
+ *                      against it.
+ *
+ * @return bool True if the snapshot is intact and was saved by this SDK
+ *              version, for this device, for the current calibration
+ *              versions and RSSI compensation LUT.
+ */
+static bool read_calibration_snapshot(uint8_t const* serial_number)
+{
+    struct CalibrationSnapshot* snapshot = &calibration_snapshot;
+
+    struct Ex10Result const ex10_result =
+        calibration_store->read(snapshot, sizeof(*snapshot));
+    if (ex10_result.error)
+    {
+        return false;
+    }
+
+    return snapshot->magic == CALIBRATION_SNAPSHOT_MAGIC &&
+           snapshot->format == CALIBRATION_SNAPSHOT_FORMAT &&
+           snapshot->length == sizeof(*snapshot) &&
+           snapshot->snapshot_crc == get_snapshot_crc(snapshot) &&
+           snapshot->cal_version == cal_version &&
+           snapshot->customer_cal_version == customer_cal_version &&
+           snapshot->rssi_comp_crc == get_rssi_comp_crc() &&
+           snapshot->sdk_version_crc == get_sdk_version_crc() &&
+           (serial_number == NULL ||
+            memcmp(snapshot->serial_number,
+                   serial_number,
+                   sizeof(snapshot->serial_number)) == 0);
+}
+
+static void restore_calibration_snapshot(void)
+{
+    struct CalibrationSnapshot const* snapshot = &calibration_snapshot;
+
+    get_ex10_cal_v5()->load_params(&snapshot->params, snapshot->cal_crc);
+    ex10_memcpy(drm_analog_offset,
+                sizeof(drm_analog_offset),
+                snapshot->drm_analog_offset,
+                sizeof(snapshot->drm_analog_offset));
+    ex10_memcpy(non_drm_analog_offset,
+                sizeof(non_drm_analog_offset),
+                snapshot->non_drm_analog_offset,
+                sizeof(snapshot->non_drm_analog_offset));
+    ex10_memcpy(drm_analog_freq_khz,
+                sizeof(drm_analog_freq_khz),
+                snapshot->drm_analog_freq_khz,
+                sizeof(snapshot->drm_analog_freq_khz));
+    ex10_memcpy(non_drm_analog_freq_khz,
+                sizeof(non_drm_analog_freq_khz),
+                snapshot->non_drm_analog_freq_khz,
+                sizeof(snapshot->non_drm_analog_freq_khz));
+}
+
+/**
+ * Save the current calibration and derived tables to the calibration store.
+ *
+ * @param serial_number The serial number of the device, which is zeros if
+ *                      it is not known.
+ */
+static void save_calibration_snapshot(uint8_t const* serial_number)
+{
+    struct CalibrationSnapshot* snapshot = &calibration_snapshot;
+    ex10_memzero(snapshot, sizeof(*snapshot));
+
+    snapshot->magic                = CALIBRATION_SNAPSHOT_MAGIC;
+    snapshot->format               = CALIBRATION_SNAPSHOT_FORMAT;
+    snapshot->length               = (uint16_t)sizeof(*snapshot);
+    snapshot->cal_version          = cal_version;
+    snapshot->customer_cal_version = customer_cal_version;
+    snapshot->cal_crc              = get_ex10_cal_v5()->get_crc();
+    snapshot->rssi_comp_crc        = get_rssi_comp_crc();
+    snapshot->sdk_version_crc      = get_sdk_version_crc();
+    snapshot->params               = *get_ex10_cal_v5()->get_params();
+    ex10_memcpy(snapshot->serial_number,
+                sizeof(snapshot->serial_number),
+                serial_number,
+                SERIAL_NUMBER_REG_LENGTH);
+    ex10_memcpy(snapshot->drm_analog_offset,
+                sizeof(snapshot->drm_analog_offset),
+                drm_analog_offset,
+                sizeof(drm_analog_offset));
+    ex10_memcpy(snapshot->non_drm_analog_offset,
+                sizeof(snapshot->non_drm_analog_offset),
+                non_drm_analog_offset,
+                sizeof(non_drm_analog_offset));
+    ex10_memcpy(snapshot->drm_analog_freq_khz,
+                sizeof(snapshot->drm_analog_freq_khz),
+                drm_analog_freq_khz,
+                sizeof(drm_analog_freq_khz));
+    ex10_memcpy(snapshot->non_drm_analog_freq_khz,
+                sizeof(snapshot->non_drm_analog_freq_khz),
+                non_drm_analog_freq_khz,
+                sizeof(non_drm_analog_freq_khz));
+    snapshot->snapshot_crc = get_snapshot_crc(snapshot);
+
+    struct Ex10Result const ex10_result =
+        calibration_store->write(snapshot, sizeof(*snapshot));
+    if (ex10_result.error)
+    {
+        ex10_eprintf("Calibration snapshot could not be saved\n");
+    }
+}
+
+static void set_calibration_store(struct Ex10CalibrationStore const* store)
+{
+    calibration_store = store;
+}
+
 static uint8_t get_cal_version(void)
 {
     return cal_version;
@@ -1727,8 +2246,10 @@ static uint8_t get_customer_cal_version(void)
     return customer_cal_version;
 }
 
-static int16_t cal_init(struct Ex10Protocol const* ex10_protocol)
+static int16_t init_calibration(struct Ex10Protocol const* ex10_protocol)
 {
+    struct Ex10BootProfiler const* profiler = get_ex10_boot_profiler();
+
     // Read the cal version and customer cal version so we can parse the cal
     // info correctly
     uint16_t const source_address = calibration_info_reg.address;
@@ -1771,12 +2292,6 @@ static int16_t cal_init(struct Ex10Protocol const* ex10_protocol)
                      customer_cal_version);
     }
 
-    // Read configs in from device
-    if (cal_version == 0x05)
-    {
-        get_ex10_cal_v5()->init(ex10_protocol);
-    }
-
     if (rssi_comp == NULL)
     {
         rssi_comp = get_ex10_rssi_compensation();
@@ -1787,17 +2302,81 @@ static int16_t cal_init(struct Ex10Protocol const* ex10_protocol)
         rx_baseband_filter = get_ex10_rx_baseband_filter();
     }
 
+    // Read configs in from device, unless a snapshot of them was saved for
+    // this device by an earlier boot. The page is always read when the
+    // device could not be identified.
+    uint8_t serial_number[SERIAL_NUMBER_REG_LENGTH];
+    bool    device_identified = false;
+    bool    snapshot_read     = false;
+    if (cal_version == 0x05 && calibration_store != NULL)
+    {
+        profiler->begin_phase("Calibration snapshot read");
+        device_identified = read_serial_number(ex10_protocol, serial_number);
+        snapshot_read     = read_calibration_snapshot(
+            device_identified ? serial_number : NULL);
+        profiler->end_phase();
+    }
+    bool const page_read =
+        (cal_version == 0x05) &&
+        (snapshot_read == false || device_identified == false ||
+         CALIBRATION_SNAPSHOT_CHECK_DEVICE_CRC);
+    if (page_read)
+    {
+        profiler->begin_phase("Calibration page read");
+        ex10_result = get_ex10_cal_v5()->init(ex10_protocol);
+        profiler->end_phase();
+        if (ex10_result.error)
+        {
+            ex10_eprintf("Calibration read failed, default settings used\n");
+            cal_version = 0xFF;
+        }
+    }
+
+    bool const snapshot_used =
+        snapshot_read && cal_version == 0x05 &&
+        (page_read == false ||
+         get_ex10_cal_v5()->get_crc() == calibration_snapshot.cal_crc);
+
+    invalidate_rx_offset_cache();
+    invalidate_power_config_cache();
+
+    if (snapshot_used)
+    {
+        restore_calibration_snapshot();
+        return cal_version;
+    }
+
     // Run initialization of arrays used in this layer
     // Note:
     // If the version is not supported, default configurations will be used.
+    profiler->begin_phase("Analog offsets");
     int16_t init_analog_offsets_result = init_analog_offsets();
+    profiler->end_phase();
     if (init_analog_offsets_result == -1)
     {
         return -1;
     }
+
+    if (cal_version == 0x05 && calibration_store != NULL)
+    {
+        profiler->begin_phase("Calibration snapshot write");
+        save_calibration_snapshot(serial_number);
+        profiler->end_phase();
+    }
     return (cal_version != 0x05) ? (int16_t)-1 : cal_version;
 }
 
+static int16_t cal_init(struct Ex10Protocol const* ex10_protocol)
+{
+    struct Ex10BootProfiler const* profiler = get_ex10_boot_profiler();
+
+    profiler->begin_phase("Calibration init");
+    int16_t const cal_init_result = init_calibration(ex10_protocol);
+    profiler->end_phase();
+
+    return cal_init_result;
+}
+
 static struct RssiCompensationLut const* get_rssi_compensation_lut(void)
 {
     return rssi_comp;
@@ -1807,6 +2386,7 @@ static void set_rssi_compensation_lut(
     struct RssiCompensationLut const* new_rssi_comp)
 {
     rssi_comp = new_rssi_comp;
+    invalidate_rx_offset_cache();
 }
 
 static struct Ex10RxBasebandFilter const* get_rx_baseband_filter(void)
@@ -1818,23 +2398,26 @@ static void set_rx_baseband_filter(
     struct Ex10RxBasebandFilter const* new_filter)
 {
     rx_baseband_filter = new_filter;
+    invalidate_rx_offset_cache();
 }
 
 static const struct Ex10Calibration ex10_calibration = {
-    .init                      = cal_init,
-    .deinit                    = NULL,
-    .power_to_adc              = power_to_adc,
-    .reverse_power_to_adc      = reverse_power_to_adc,
-    .get_power_control_params  = get_power_control_params,
-    .get_compensated_rssi      = get_compensated_rssi,
-    .get_rssi_log2             = get_rssi_log2,
-    .get_compensated_lbt_rssi  = get_compensated_lbt_rssi,
-    .get_cal_version           = get_cal_version,
-    .get_customer_cal_version  = get_customer_cal_version,
-    .get_rssi_compensation_lut = get_rssi_compensation_lut,
-    .set_rssi_compensation_lut = set_rssi_compensation_lut,
-    .get_rx_baseband_filter    = get_rx_baseband_filter,
-    .set_rx_baseband_filter    = set_rx_baseband_filter,
+    .init                         = cal_init,
+    .deinit                       = NULL,
+    .power_to_adc                 = power_to_adc,
+    .reverse_power_to_adc         = reverse_power_to_adc,
+    .get_power_control_params     = get_power_control_params,
+    .prepare_power_control_params = prepare_power_control_params,
+    .get_compensated_rssi         = get_compensated_rssi,
+    .get_rssi_log2                = get_rssi_log2,
+    .get_compensated_lbt_rssi     = get_compensated_lbt_rssi,
+    .get_cal_version              = get_cal_version,
+    .get_customer_cal_version     = get_customer_cal_version,
+    .get_rssi_compensation_lut    = get_rssi_compensation_lut,
+    .set_rssi_compensation_lut    = set_rssi_compensation_lut,
+    .get_rx_baseband_filter       = get_rx_baseband_filter,
+    .set_rx_baseband_filter       = set_rx_baseband_filter,
+    .set_calibration_store        = set_calibration_store,
 };
 
 struct Ex10Calibration const* get_ex10_calibration(void)
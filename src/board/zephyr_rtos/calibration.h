@@ -17,6 +17,7 @@
 #include <sys/types.h>
 
 #include "board/zephyr_rtos/rssi_compensation_lut.h"
+#include "board/ex10_calibration_store.h"
 #include "board/ex10_rx_baseband_filter.h"
 #include "ex10_api/ex10_ops.h"
 #include "ex10_api/ex10_regulatory.h"
@@ -31,6 +32,15 @@ extern "C" {
  * coincide with actual ADC readings. */
 #define CAL_FUNC_NOT_SUPPORTED ((uint16_t)0xFFFF)
 
+/**
+ * The TX power levels held by the power control params cache. Levels with
+ * and without boost are held separately.
+ */
+#define POWER_CONTROL_CACHE_LEVELS ((size_t)16u)
+
+/// The channels' power control params held by the cache across all levels.
+#define POWER_CONTROL_CACHE_ENTRIES ((size_t)128u)
+
 struct Ex10Calibration
 {
     /**
@@ -113,6 +123,30 @@ struct Ex10Calibration
                                                     bool     temp_comp_enabled,
                                                     enum RfFilter rf_band);
 
+    /**
+     * Compute and cache the power control params of every channel in the
+     * active region's channel table, so that later calls to
+     * get_power_control_params() for these channels are table lookups.
+     * Call when the region or TX power level is set, outside the time
+     * critical path of a channel hop.
+     *
+     * @note Cached params are reused while the temperature ADC stays in the
+     *       same small temperature bucket, and are recomputed for a channel
+     *       when it is next used in a different bucket.
+     * @note Each call uses one of the POWER_CONTROL_CACHE_LEVELS levels and
+     *       one of the POWER_CONTROL_CACHE_ENTRIES entries per channel. When
+     *       the cache is full, the oldest levels and entries are replaced.
+     *
+     * @param tx_power_cdbm     Target Tx power in cdBm.
+     * @param with_boost        Use the gen2v3 boost calculations
+     * @param temperature_adc   The reading from the temp ADC
+     * @param temp_comp_enabled Whether to compensate for temperature
+     */
+    void (*prepare_power_control_params)(int16_t  tx_power_cdbm,
+                                         bool     with_boost,
+                                         uint16_t temperature_adc,
+                                         bool     temp_comp_enabled);
+
     /**
      * Compensates RSSI value for temperature, analog settings, and RF mode
      * based on calibration table.
@@ -224,6 +258,17 @@ struct Ex10Calibration
      */
     void (*set_rx_baseband_filter)(
         struct Ex10RxBasebandFilter const* new_filter);
+
+    /**
+     * Sets the store used to keep a snapshot of the parsed calibration and
+     * the tables derived from it. When set before init(), init() restores
+     * the calibration from a matching snapshot instead of deriving it again,
+     * and saves a new snapshot when there is none or it does not match.
+     *
+     * @param store The calibration store, or NULL to disable snapshots,
+     *              which is the default.
+     */
+    void (*set_calibration_store)(struct Ex10CalibrationStore const* store);
 };
 
 struct Ex10Calibration const* get_ex10_calibration(void);
@@ -14,8 +14,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "board/ex10_osal.h"
 #include "board/zephyr_rtos/calibration_v5.h"
+#include "board_spec_constants.h"
 #include "ex10_api/application_registers.h"
+#include "ex10_api/crc16.h"
 
 // clang-format off
 // Impinj_calgen | gen_calibration_v5_c {
@@ -385,21 +388,113 @@ static struct CalibrationOffset const offset_table[] =
 // Impinj_calgen }
 // clang-format on
 
-static void init(struct Ex10Protocol const* ex10_protocol)
+/// The most calibration bytes read in one SPI transaction.
+#define CALIBRATION_READ_CHUNK_SIZE ((size_t)(EX10_SPI_BURST_SIZE - 1u))
+
+/// The CRC-16 of the calibration bytes read by the last init().
+static uint16_t calibration_crc = 0u;
+
+/**
+ * Copy the part of each calibration field held in a chunk of the
+ * calibration info page into calibration_parameters.
+ *
+ * @param chunk        The calibration bytes read.
+ * @param chunk_source The offset of chunk within the calibration info page.
+ * @param chunk_length The number of bytes in chunk.
+ */
+static void unpack_chunk(uint8_t const* chunk,
+                         size_t         chunk_source,
+                         size_t         chunk_length)
 {
-    uint16_t const source_base      = calibration_info_reg.address;
     uint8_t* const destination_base = (uint8_t*)&calibration_parameters;
     size_t const offset_count = sizeof(offset_table) / sizeof(offset_table[0u]);
+    size_t const chunk_end    = chunk_source + chunk_length;
+
+    for (struct CalibrationOffset const* offset = &offset_table[0u];
+         offset < &offset_table[offset_count];
+         ++offset)
+    {
+        size_t const field_end = offset->source + offset->length;
+        if (field_end <= chunk_source || offset->source >= chunk_end)
+        {
+            continue;
+        }
+
+        // A field may straddle two chunks; copy the part in this chunk.
+        size_t const copy_start = (offset->source > chunk_source)
+                                      ? offset->source
+                                      : chunk_source;
+        size_t const copy_end = (field_end < chunk_end) ? field_end : chunk_end;
+        uint8_t* const destination_pointer = destination_base +
+                                             offset->destination +
+                                             (copy_start - offset->source);
+        ex10_memcpy(destination_pointer,
+                    field_end - copy_start,
+                    &chunk[copy_start - chunk_source],
+                    copy_end - copy_start);
+    }
+}
+
+static struct Ex10Result init(struct Ex10Protocol const* ex10_protocol)
+{
+    size_t const offset_count = sizeof(offset_table) / sizeof(offset_table[0u]);
 
+    // The calibration fields are read from the start of the calibration info
+    // page through the end of the last field.
+    size_t load_length = 0u;
     for (struct CalibrationOffset const* offset = &offset_table[0u];
          offset < &offset_table[offset_count];
          ++offset)
     {
-        uint16_t const source_address = source_base + offset->source;
-        uint8_t* destination_pointer  = destination_base + offset->destination;
-        ex10_protocol->read_partial(
-            source_address, (uint16_t)offset->length, destination_pointer);
+        size_t const field_end = offset->source + offset->length;
+        load_length = (field_end > load_length) ? field_end : load_length;
+    }
+
+    // Read the fields in as few maximal bursts as fit the command buffers,
+    // rather than one read per field, and unpack them from RAM.
+    static uint8_t chunk[CALIBRATION_READ_CHUNK_SIZE];
+    uint16_t       crc         = UINT16_MAX;
+    size_t         load_offset = 0u;
+    while (load_offset < load_length)
+    {
+        size_t const remaining    = load_length - load_offset;
+        size_t const chunk_length = (remaining < sizeof(chunk))
+                                        ? remaining
+                                        : sizeof(chunk);
+
+        struct Ex10Result const ex10_result = ex10_protocol->read_partial(
+            (uint16_t)(calibration_info_reg.address + load_offset),
+            (uint16_t)chunk_length,
+            chunk);
+        if (ex10_result.error)
+        {
+            // Fall back to the default parameters rather than use a partial
+            // calibration.
+            calibration_parameters.calibration_version.cal_file_version =
+                calibration_parameters_default.calibration_version
+                    .cal_file_version;
+            return ex10_result;
+        }
+
+        crc = ex10_compute_crc16_partial(chunk, chunk_length, crc);
+        unpack_chunk(chunk, load_offset, chunk_length);
+        load_offset += chunk_length;
     }
+
+    calibration_crc = crc;
+    return make_ex10_success();
+}
+
+static uint16_t get_crc(void)
+{
+    return calibration_crc;
+}
+
+static void load_params(struct Ex10CalibrationParamsV5 const* params,
+                        uint16_t                              crc)
+{
+    calibration_parameters = *params;
+    calibration_crc        = crc;
 }
 
 static struct Ex10CalibrationParamsV5 const* get_params(void)
@@ -417,8 +512,10 @@ static struct Ex10CalibrationParamsV5 const* get_params(void)
 }
 
 static struct Ex10CalibrationV5 const ex10_cal_v5 = {
-    .init       = init,
-    .get_params = get_params,
+    .init        = init,
+    .get_params  = get_params,
+    .get_crc     = get_crc,
+    .load_params = load_params,
 };
 
 struct Ex10CalibrationV5 const* get_ex10_cal_v5(void)
@@ -246,18 +246,41 @@ struct Ex10CalibrationV5
 {
     /**
      * Read the calibration parameters from the Ex10 into the C library
-     * struct CalibrationParameters store.
+     * struct CalibrationParameters store. The calibration info page is read
+     * in as few SPI bursts as possible and unpacked in RAM.
      *
      * @param ex10_protocol The protocol object used to communicate with the
      * Ex10.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the calibration was read. If not, the
+     *         default parameters are used.
      */
-    void (*init)(struct Ex10Protocol const* ex10_protocol);
+    struct Ex10Result (*init)(struct Ex10Protocol const* ex10_protocol);
 
     /**
      * @return struct CalibrationParameters const* The pointer to the C library
      * struct CalibrationParameters store.
      */
     struct Ex10CalibrationParamsV5 const* (*get_params)(void);
+
+    /**
+     * @return uint16_t The CRC-16-CCITT of the calibration info page bytes
+     * read by the last successful init(), from the start of the page
+     * through the last calibration field. The CRC identifies the device's
+     * calibration, for example to check that a saved copy is current.
+     */
+    uint16_t (*get_crc)(void);
+
+    /**
+     * Use previously read calibration parameters instead of reading them
+     * from the Ex10, for example when restoring a saved snapshot.
+     *
+     * @param params The calibration parameters to use.
+     * @param crc    The CRC that get_crc() returned when params were read.
+     */
+    void (*load_params)(struct Ex10CalibrationParamsV5 const* params,
+                        uint16_t                              crc);
 };
 
 struct Ex10CalibrationV5 const* get_ex10_cal_v5(void);
@@ -42,6 +42,7 @@ struct Ex10DriverList* get_ex10_board_driver_list(void)
         driver_list.gpio_if.assert_ready_n    = gpio_driver->assert_ready_n;
         driver_list.gpio_if.release_ready_n   = gpio_driver->release_ready_n;
         driver_list.gpio_if.busy_wait_ready_n = gpio_driver->busy_wait_ready_n;
+        driver_list.gpio_if.wait_ready_n      = gpio_driver->wait_ready_n;
         driver_list.gpio_if.ready_n_pin_get   = gpio_driver->ready_n_pin_get;
         driver_list.gpio_if.reset_device      = gpio_driver->reset_device;
 
@@ -56,6 +57,13 @@ struct Ex10DriverList* get_ex10_board_driver_list(void)
             gpio_driver->irq_monitor_callback_enable;
         driver_list.gpio_if.irq_monitor_callback_is_enabled =
             gpio_driver->irq_monitor_callback_is_enabled;
+        driver_list.gpio_if.set_irq_tick_callback =
+            gpio_driver->set_irq_tick_callback;
+
+        driver_list.gpio_if.get_ready_n_wait_stats =
+            gpio_driver->get_ready_n_wait_stats;
+        driver_list.gpio_if.reset_ready_n_wait_stats =
+            gpio_driver->reset_ready_n_wait_stats;
 
         struct Ex10SpiDriver const* spi_driver = get_ex10_spi_driver();
 
@@ -64,6 +72,14 @@ struct Ex10DriverList* get_ex10_board_driver_list(void)
         driver_list.host_if.read  = spi_driver->spi_read;
         driver_list.host_if.write = spi_driver->spi_write;
 
+        driver_list.host_if.read_async  = spi_driver->spi_read_async;
+        driver_list.host_if.write_async = spi_driver->spi_write_async;
+        driver_list.host_if.wait_async  = spi_driver->spi_wait_async;
+
+        driver_list.host_if.get_transfer_count =
+            spi_driver->spi_get_transfer_count;
+        driver_list.host_if.get_clock_rates = spi_driver->spi_get_clock_rates;
+
         struct Ex10UartDriver const* uart_driver = get_ex10_uart_driver();
 
         driver_list.uart_if.open  = uart_driver->uart_open;
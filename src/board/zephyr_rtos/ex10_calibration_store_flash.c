@@ -0,0 +1,192 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+
+#include "board/ex10_calibration_store.h"
+#include "board/ex10_osal.h"
+
+// The flash partition which holds the calibration snapshot. The pages at the
+// start of the partition are erased whenever a new snapshot is written, so
+// it must not be shared.
+#define CALIBRATION_STORE_PARTITION storage_partition
+
+#if defined(CONFIG_EX10_CALIBRATION_SNAPSHOT) && \
+    FIXED_PARTITION_EXISTS(CALIBRATION_STORE_PARTITION)
+
+#define CALIBRATION_STORE_AREA_ID \
+    FIXED_PARTITION_ID(CALIBRATION_STORE_PARTITION)
+
+/// The largest flash write alignment supported for the last partial word.
+#define CALIBRATION_STORE_MAX_ALIGN ((size_t)16u)
+
+static struct Ex10Result open_area(struct flash_area const** area,
+                                   size_t                    length)
+{
+    if (flash_area_open(CALIBRATION_STORE_AREA_ID, area) != 0)
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorInvalidState);
+    }
+    if (length > (*area)->fa_size)
+    {
+        flash_area_close(*area);
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorBadParamLength);
+    }
+    return make_ex10_success();
+}
+
+/**
+ * Erase the whole flash pages at the start of the area which hold length
+ * bytes, rather than the whole area.
+ *
+ * @return int 0 on success, otherwise a negative errno value.
+ */
+static int erase_pages(struct flash_area const* area, size_t length)
+{
+    struct device const* flash_dev = flash_area_get_device(area);
+
+    size_t erase_length = 0u;
+    while (erase_length < length)
+    {
+        struct flash_pages_info page_info;
+        int const               info_result = flash_get_page_info_by_offs(
+            flash_dev, area->fa_off + erase_length, &page_info);
+        if (info_result != 0)
+        {
+            return info_result;
+        }
+        erase_length =
+            page_info.start_offset + page_info.size - area->fa_off;
+    }
+
+    if (erase_length > area->fa_size)
+    {
+        return -EINVAL;
+    }
+    return (erase_length > 0u) ? flash_area_erase(area, 0, erase_length) : 0;
+}
+
+static struct Ex10Result read(void* buffer, size_t length)
+{
+    if (buffer == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorNullPointer);
+    }
+
+    struct flash_area const* area        = NULL;
+    struct Ex10Result const  ex10_result = open_area(&area, length);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    int const read_result = flash_area_read(area, 0, buffer, length);
+    flash_area_close(area);
+
+    return (read_result == 0) ? make_ex10_success()
+                              : make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                                    Ex10SdkErrorInvalidState);
+}
+
+static struct Ex10Result write(void const* buffer, size_t length)
+{
+    if (buffer == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorNullPointer);
+    }
+
+    struct flash_area const* area        = NULL;
+    struct Ex10Result const  ex10_result = open_area(&area, length);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    // Flash is written in whole words; the last partial word is padded.
+    size_t const align        = flash_area_align(area);
+    size_t const whole_length = length - (length % align);
+    size_t const tail_length  = length - whole_length;
+    size_t const write_length =
+        whole_length + ((tail_length > 0u) ? align : 0u);
+
+    int write_result = (align > CALIBRATION_STORE_MAX_ALIGN)
+                           ? -1
+                           : erase_pages(area, write_length);
+    if (write_result == 0 && whole_length > 0u)
+    {
+        write_result = flash_area_write(area, 0, buffer, whole_length);
+    }
+    if (write_result == 0 && tail_length > 0u)
+    {
+        uint8_t tail[CALIBRATION_STORE_MAX_ALIGN];
+        ex10_memzero(tail, sizeof(tail));
+        ex10_memcpy(tail,
+                    sizeof(tail),
+                    (uint8_t const*)buffer + whole_length,
+                    tail_length);
+        write_result = flash_area_write(area, whole_length, tail, align);
+    }
+    flash_area_close(area);
+
+    return (write_result == 0) ? make_ex10_success()
+                               : make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                                     Ex10SdkErrorInvalidState);
+}
+
+static struct Ex10Result erase(void)
+{
+    struct flash_area const* area        = NULL;
+    struct Ex10Result const  ex10_result = open_area(&area, 0u);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    // The snapshot header is in the first page; erasing it removes the
+    // snapshot.
+    int const erase_result = erase_pages(area, 1u);
+    flash_area_close(area);
+
+    return (erase_result == 0) ? make_ex10_success()
+                               : make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                                     Ex10SdkErrorInvalidState);
+}
+
+static struct Ex10CalibrationStore const ex10_calibration_store_flash = {
+    .read  = read,
+    .write = write,
+    .erase = erase,
+};
+
+struct Ex10CalibrationStore const* get_ex10_calibration_store_flash(void)
+{
+    return &ex10_calibration_store_flash;
+}
+
+#else
+
+struct Ex10CalibrationStore const* get_ex10_calibration_store_flash(void)
+{
+    return NULL;
+}
+
+#endif
@@ -16,46 +16,38 @@
 #include "ex10_api/ex10_macros.h"
 
 /**
- * Each buffer needs to be large enough to contain the full contents of
- * the ReadFifo command (4096 bytes), plus the 1-byte result code,
- * and maintain Fifo packet 4-byte alignment.
+ * EventFifo buffers are allocated from a single arena, each sized to the
+ * number of bytes drained from the EventFifo plus a 32-bit word for the
+ * ReadFifo response code and the packet index; see FIFO_ARENA_SLAB_SIZE.
+ * The arena must be able to hold at least one full ReadFifo (4096 bytes)
+ * with its header and index.
+ *
+ * @note that the arena size and the number of nodes should be changed based
+ * on the expected event FIFO traffic and available memory on your host
+ * controller. For example, if the arena is too small and a large number of
+ * tags are read in a short window of time, you may not have enough space to
+ * pull them from the device, and thus the device-side event FIFO buffer could
+ * overfill. The node count limits the number of drains held at once; these
+ * are typically much smaller than the full EventFifo.
  */
-#define EVENT_FIFO_BUFFER_SIZE (EX10_EVENT_FIFO_SIZE + FIFO_HEADER_SPACE)
+#define EVENT_FIFO_ARENA_SIZE (3u * FIFO_ARENA_SLAB_SIZE(EX10_EVENT_FIFO_SIZE))
+#define EVENT_FIFO_NODE_COUNT 16u
 
-/**
- * @note that the number of buffers should be changed based on the expected
- * event FIFO traffic and available memory on your host controller. For example,
- * if you have too few buffers and a large number of tags in a short window of
- * time, you may not have enough space to pull them from the device, and thus
- * the device-side event FIFO buffer could overfill.
- */
-static uint8_t buffer_0[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_1[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_2[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_3[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_4[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_5[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_6[EVENT_FIFO_BUFFER_SIZE];
-static uint8_t buffer_7[EVENT_FIFO_BUFFER_SIZE];
+static uint32_t
+    event_fifo_arena_buffer[EVENT_FIFO_ARENA_SIZE / sizeof(uint32_t)];
 
-static struct ByteSpan const event_fifo_buffers[] = {
-    {.data = buffer_0, .length = sizeof(buffer_0)},
-    {.data = buffer_1, .length = sizeof(buffer_1)},
-    {.data = buffer_2, .length = sizeof(buffer_2)},
-    {.data = buffer_3, .length = sizeof(buffer_3)},
-    {.data = buffer_4, .length = sizeof(buffer_4)},
-    {.data = buffer_5, .length = sizeof(buffer_5)},
-    {.data = buffer_6, .length = sizeof(buffer_6)},
-    {.data = buffer_7, .length = sizeof(buffer_7)},
+static struct ByteSpan const event_fifo_arena = {
+    .data   = (uint8_t*)event_fifo_arena_buffer,
+    .length = sizeof(event_fifo_arena_buffer),
 };
 
-static struct FifoBufferNode
-    event_fifo_buffer_nodes[ARRAY_SIZE(event_fifo_buffers)];
+static struct FifoBufferNode event_fifo_buffer_nodes[EVENT_FIFO_NODE_COUNT];
 
 static struct FifoBufferPool const event_fifo_buffer_pool = {
     .fifo_buffer_nodes = event_fifo_buffer_nodes,
-    .fifo_buffers      = event_fifo_buffers,
-    .buffer_count      = ARRAY_SIZE(event_fifo_buffers)};
+    .fifo_buffers      = NULL,
+    .buffer_count      = ARRAY_SIZE(event_fifo_buffer_nodes),
+    .arena             = &event_fifo_arena};
 
 struct FifoBufferPool const* get_ex10_event_fifo_buffer_pool(void)
 {
@@ -89,7 +81,8 @@ static struct FifoBufferNode result_buffer_nodes[ARRAY_SIZE(result_buffers)];
 static struct FifoBufferPool const result_buffer_pool = {
     .fifo_buffer_nodes = result_buffer_nodes,
     .fifo_buffers      = result_buffers,
-    .buffer_count      = ARRAY_SIZE(result_buffers)};
+    .buffer_count      = ARRAY_SIZE(result_buffers),
+    .arena             = NULL};
 
 struct FifoBufferPool const* get_ex10_result_buffer_pool(void)
 {
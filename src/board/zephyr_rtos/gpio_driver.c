@@ -37,6 +37,13 @@ extern struct k_mutex irq_n_callback_lock;
 // IRQ callback function.
 static void (*irq_n_cb)(void) = NULL;
 
+// Periodic callback function, called by the IRQ_N monitor thread every
+// irq_tick_period_ms while irq_n_cb is enabled. Protected by
+// irq_n_callback_lock.
+static void (*irq_tick_cb)(void) = NULL;
+static uint32_t irq_tick_period_ms = 0;
+static uint32_t irq_tick_last_ms   = 0;
+
 // We only init the GPIO IRQ ints one time..
 static volatile bool is_irq_gpio_initialized = false;
 
@@ -58,6 +65,25 @@ static volatile int unhandled_irq_count = 0;
 // Semaphore for signaling interrupt handling thread when irq GPIO goes low. 
 K_SEM_DEFINE(yukon_irq_sem, 0, 1);
 
+// Semaphore for signaling a thread blocked in wait_ready_n() that the
+// READY_N line has asserted.
+K_SEM_DEFINE(ready_n_sem, 0, 1);
+
+// Bounds on the adaptive interval that READY_N is polled before blocking.
+// Note that the cycle counter on this target runs from the 32 kHz RTC, so
+// durations have a resolution of roughly 31 us.
+#define READY_N_SPIN_MIN_US   ((uint32_t)30u)
+#define READY_N_SPIN_MAX_US   ((uint32_t)500u)
+#define READY_N_SPIN_START_US ((uint32_t)60u)
+
+// While blocked, the READY_N line is re-sampled at this interval. This covers
+// an edge which occurs between the end of polling and arming the interrupt.
+#define READY_N_BLOCK_SLICE_US ((uint32_t)1000u)
+
+static struct ReadyNWaitStats ready_n_wait_stats = {
+    .spin_budget_us = READY_N_SPIN_START_US,
+};
+
 static void irq_gpio_callback(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
 {
     if (irq_monitor_callback_enable_flag && irq_n_cb) {
@@ -66,10 +92,31 @@ static void irq_gpio_callback(const struct device *dev, struct gpio_callback *cb
     }
 }
 
+static void ready_n_gpio_callback(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+    k_sem_give(&ready_n_sem);
+}
+
 // Monitors IRQ line status and calls callbacks when enabled.
 static void irq_handler_thread(void *arg1, void *arg2, void *arg3) {
     while (1) {
-        k_sem_take(&yukon_irq_sem, K_FOREVER);
+        k_mutex_lock(&irq_n_callback_lock, K_FOREVER);
+        k_timeout_t const timeout =
+            irq_tick_cb ? K_MSEC(irq_tick_period_ms) : K_FOREVER;
+        k_mutex_unlock(&irq_n_callback_lock);
+        k_sem_take(&yukon_irq_sem, timeout);
+
+        // Run the periodic callback when its period has elapsed, whether or
+        // not the wait ended with an IRQ.
+        k_mutex_lock(&irq_n_callback_lock, K_FOREVER);
+        if (irq_tick_cb && irq_n_cb && irq_monitor_callback_enable_flag) {
+            uint32_t const now_ms = k_uptime_get_32();
+            if (now_ms - irq_tick_last_ms >= irq_tick_period_ms) {
+                irq_tick_last_ms = now_ms;
+                irq_tick_cb();
+            }
+        }
+        k_mutex_unlock(&irq_n_callback_lock);
 
         // Skip callback if IRQ not active or enabled.
         //if (gpio_pin_get_dt(&GPI_IRQ_N) != 0) continue; // This is the preferred approach but it seems that (at this time) setting the GPIO up for interrupts disables it as an input so it always returns 0.
@@ -119,6 +166,12 @@ static void gpio_initialize(bool board_power_on, bool ex10_enable, bool reset)
         gpio_init_callback(&gpio_cb, irq_gpio_callback, BIT(GPI_IRQ_N.pin));
         gpio_add_callback_dt(&GPI_IRQ_N, &gpio_cb);
         gpio_pin_interrupt_configure_dt(&GPI_IRQ_N, GPIO_INT_EDGE_FALLING);
+
+        // The READY_N interrupt is only armed while a thread is blocked
+        // in wait_ready_n().
+        static struct gpio_callback ready_n_cb;
+        gpio_init_callback(&ready_n_cb, ready_n_gpio_callback, BIT(GPIO_READY_INT_N.pin));
+        gpio_add_callback_dt(&GPIO_READY_INT_N, &ready_n_cb);
     }
 }
 
@@ -205,6 +258,17 @@ static void irq_monitor_callback_enable(bool enable)
     }
 }
 
+static void set_irq_tick_callback(void (*cb_func)(void), uint32_t period_ms)
+{
+    k_mutex_lock(&irq_n_callback_lock, K_FOREVER);
+    irq_tick_cb        = (period_ms > 0) ? cb_func : NULL;
+    irq_tick_period_ms = period_ms;
+    irq_tick_last_ms   = k_uptime_get_32();
+    k_mutex_unlock(&irq_n_callback_lock);
+    // Wake the IRQ_N monitor thread so that it waits with the new period.
+    k_sem_give(&yukon_irq_sem);
+}
+
 static bool irq_monitor_callback_is_enabled(void)
 {
     k_mutex_lock(&irq_n_callback_lock, K_FOREVER);
@@ -258,20 +322,132 @@ static int ready_n_pin_get(void)
     return pinval != 0;
 }
 
-static int busy_wait_ready_n(uint32_t timeout_ms)
+static uint32_t cycles_elapsed_us(uint32_t start_cycles)
 {
-    uint64_t start_ms = k_uptime_get();
-    bool timed_out = false;
-    while (!ready_n_pin_get())
-    {
-        if ((k_uptime_get() - start_ms) >= timeout_ms) {
-            printk("Wait for ready_n timed out!\n");
+    return k_cyc_to_us_floor32(k_cycle_get_32() - start_cycles);
+}
+
+// Poll READY_N until it asserts or spin_us has elapsed.
+static bool spin_ready_n(uint32_t start_cycles, uint32_t spin_us)
+{
+    while (!ready_n_pin_get()) {
+        if (cycles_elapsed_us(start_cycles) >= spin_us) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Block on the READY_N edge interrupt until it asserts or timeout_ms elapses.
+// An edge before the interrupt is armed is not reported, so the pin is read
+// again once it is armed; the nRF GPIO input stays connected while a pin is
+// configured for interrupts.
+static int block_ready_n(uint32_t start_cycles, uint32_t timeout_ms)
+{
+    while (1) {
+        k_sem_reset(&ready_n_sem);
+        gpio_pin_interrupt_configure_dt(&GPIO_READY_INT_N, GPIO_INT_EDGE_TO_ACTIVE);
+        if (ready_n_pin_get()) {
+            gpio_pin_interrupt_configure_dt(&GPIO_READY_INT_N, GPIO_INT_DISABLE);
+            return 0;
+        }
+        int const taken = k_sem_take(&ready_n_sem, K_USEC(READY_N_BLOCK_SLICE_US));
+        gpio_pin_interrupt_configure_dt(&GPIO_READY_INT_N, GPIO_INT_DISABLE);
+
+        if (taken == 0 || ready_n_pin_get()) {
+            return 0;
+        }
+        if (cycles_elapsed_us(start_cycles) / 1000u >= timeout_ms) {
             return -1;
         }
-//        k_usleep(1);
     }
+}
 
-    return 0;
+// Grow the polling interval when blocking caught a wait that polling
+// slightly longer would have, and shrink it when the waits are long enough
+// that polling only wastes CPU time.
+static void adapt_spin_budget(uint32_t wait_us)
+{
+    uint32_t budget = ready_n_wait_stats.spin_budget_us;
+    if (wait_us < READY_N_SPIN_MAX_US) {
+        budget = MAX(budget * 2u, wait_us);
+    } else {
+        budget /= 2u;
+    }
+    ready_n_wait_stats.spin_budget_us = CLAMP(budget, READY_N_SPIN_MIN_US, READY_N_SPIN_MAX_US);
+}
+
+static void record_ready_n_wait(uint32_t wait_us, uint32_t blocked_us, bool blocked, int result)
+{
+    struct ReadyNWaitStats* stats = &ready_n_wait_stats;
+    stats->wait_count++;
+    if (result != 0) {
+        stats->timeout_count++;
+    } else if (blocked) {
+        stats->block_count++;
+    } else {
+        stats->spin_complete_count++;
+    }
+    stats->last_wait_us = wait_us;
+    stats->max_wait_us = MAX(stats->max_wait_us, wait_us);
+    stats->total_wait_us += wait_us;
+    stats->total_blocked_us += blocked_us;
+
+    size_t bin = 0;
+    for (uint32_t bin_us = wait_us; bin_us != 0; bin_us >>= 1) {
+        bin++;
+    }
+    stats->wait_histogram[MIN(bin, READY_N_WAIT_HISTOGRAM_BINS - 1)]++;
+}
+
+static int wait_ready_n(uint32_t timeout_ms, enum ReadyNWaitMode wait_mode)
+{
+    uint32_t const start_cycles = k_cycle_get_32();
+    uint32_t const timeout_us = (timeout_ms > UINT32_MAX / 1000u) ? UINT32_MAX : timeout_ms * 1000u;
+    uint32_t const spin_us = (wait_mode == ReadyNWaitInterrupt) ? ready_n_wait_stats.spin_budget_us : timeout_us;
+
+    int result = 0;
+    bool blocked = false;
+    uint32_t blocked_us = 0;
+    if (!spin_ready_n(start_cycles, spin_us)) {
+        if (wait_mode == ReadyNWaitInterrupt) {
+            uint32_t const block_cycles = k_cycle_get_32();
+            blocked = true;
+            result = block_ready_n(start_cycles, timeout_ms);
+            blocked_us = cycles_elapsed_us(block_cycles);
+        } else {
+            result = -1;
+        }
+    }
+
+    uint32_t const wait_us = cycles_elapsed_us(start_cycles);
+    if (blocked && result == 0) {
+        adapt_spin_budget(wait_us);
+    }
+    record_ready_n_wait(wait_us, blocked_us, blocked, result);
+
+    if (result != 0) {
+        printk("Wait for ready_n timed out!\n");
+    }
+    return result;
+}
+
+static int busy_wait_ready_n(uint32_t timeout_ms)
+{
+    return wait_ready_n(timeout_ms, ReadyNWaitSpin);
+}
+
+static void get_ready_n_wait_stats(struct ReadyNWaitStats* stats)
+{
+    *stats = ready_n_wait_stats;
+}
+
+static void reset_ready_n_wait_stats(void)
+{
+    uint32_t const spin_budget_us = ready_n_wait_stats.spin_budget_us;
+    ready_n_wait_stats = (struct ReadyNWaitStats){
+        .spin_budget_us = spin_budget_us,
+    };
 }
 
 static bool get_test_pin_level(uint8_t pin_no)
@@ -332,6 +508,7 @@ static struct Ex10GpioDriver const ex10_gpio_driver = {
     .deregister_irq_callback         = deregister_irq_callback,
     .irq_monitor_callback_enable     = irq_monitor_callback_enable,
     .irq_monitor_callback_is_enabled = irq_monitor_callback_is_enabled,
+    .set_irq_tick_callback           = set_irq_tick_callback,
     .irq_enable                      = irq_enable_func,
     .thread_is_irq_monitor           = thread_is_irq_monitor,
     .assert_reset_n                  = assert_reset_n,
@@ -340,7 +517,10 @@ static struct Ex10GpioDriver const ex10_gpio_driver = {
     .assert_ready_n                  = assert_ready_n,
     .reset_device                    = reset_device,
     .busy_wait_ready_n               = busy_wait_ready_n,
+    .wait_ready_n                    = wait_ready_n,
     .ready_n_pin_get                 = ready_n_pin_get,
+    .get_ready_n_wait_stats          = get_ready_n_wait_stats,
+    .reset_ready_n_wait_stats        = reset_ready_n_wait_stats,
     .get_test_pin_level              = get_test_pin_level,
     .debug_pin_get_count             = debug_pin_get_count,
     .debug_pin_get                   = debug_pin_get,
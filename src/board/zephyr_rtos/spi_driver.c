@@ -73,112 +73,173 @@ static int32_t nrf5340_spi_open(uint32_t clock_freq_hz)
     return 0;
 }
 
-static void nrf5340_spi_close(void)
+#ifdef CONFIG_SPI_ASYNC
+static struct k_poll_event spi_done_evt = K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &spi_done_sig);
+
+// Called from the SPI interrupt when a transfer completes. CS is released
+// here rather than in spi_transfer_wait(), so that the Ex10 starts on a
+// command as soon as it has been clocked out, while the thread which started
+// the transfer carries on with other work.
+static void spi_transfer_done(const struct device *dev, int result, void *data)
 {
+    gpio_pin_set_dt(&GPO_SPI_CS_N, 0);
+    k_poll_signal_raise(&spi_done_sig, result);
 }
+#endif /* CONFIG_SPI_ASYNC */
 
-static int32_t nrf5340_spi_write(const void* tx_buff, size_t length)
-{
-    int32_t result = length;
+// The buffers handed to the SPI driver must remain valid until the transfer
+// completes, so they are kept here rather than on the caller's stack.
+static struct spi_buf xfer_buf;
+static struct spi_buf_set xfer_buf_set = {
+    .buffers = &xfer_buf,
+    .count = 1,
+};
 
-    // Perform SPI write operation
-    struct spi_buf tx_buf = {
-        .buf = tx_buff,
-        .len = length,
-    };
+// Tracks the transfer started by spi_write_async() or spi_read_async() which
+// has not yet been collected by spi_wait_async().
+static struct {
+    bool pending;
+    size_t length;
+} async_xfer = {
+    .pending = false,
+    .length = 0,
+};
 
-    struct spi_buf_set tx = {
-        .buffers = &tx_buf,
-        .count = 1,
-    };
+// The number of transfers started by spi_transfer_start().
+static uint32_t transfer_count = 0;
 
-	// Start write transaction
+// Assert CS and start a transfer. When CONFIG_SPI_ASYNC is set the transfer
+// runs in the background, CS is released when it completes, and
+// spi_transfer_wait() must be called to collect its result; otherwise the
+// transfer is complete on return.
+static int32_t spi_transfer_start(void* buff, size_t length, bool is_write)
+{
+    xfer_buf.buf = buff;
+    xfer_buf.len = length;
+    struct spi_buf_set const* tx = is_write ? &xfer_buf_set : NULL;
+    struct spi_buf_set const* rx = is_write ? NULL : &xfer_buf_set;
+
+    transfer_count++;
     gpio_pin_set_dt(&GPO_SPI_CS_N, 1);
     int error;
 #ifdef CONFIG_SPI_ASYNC
-    error = spi_write_signal(spi_dev, spi_cfg(), &tx, &spi_done_sig);
-	if(error != 0){
-		printk("SPI write error: %i\n", error);
-		result = -1;
-    } else {
-        // Wait for transaction to end.
-        int spi_signaled, spi_result;
-        k_poll_signal_check(&spi_done_sig, &spi_signaled, &spi_result);
-        while (spi_signaled == 0) {
-            k_usleep(50);
-            k_poll_signal_check(&spi_done_sig, &spi_signaled, &spi_result);
-        }
-        result = spi_result ? -1 : length;
-    }
+    k_poll_signal_reset(&spi_done_sig);
+    error = spi_transceive_cb(spi_dev, spi_cfg(), tx, rx, spi_transfer_done, NULL);
 #else
-    error = spi_write(spi_dev, spi_cfg(), &tx);	
-	if(error != 0){
-		printk("SPI write error: %i\n", error);
-		result = -1;
-    }
+    error = spi_transceive(spi_dev, spi_cfg(), tx, rx);
 #endif /* CONFIG_SPI_ASYNC */
+    if (error != 0) {
+        printk("SPI %s error: %i\n", is_write ? "write" : "read", error);
+        gpio_pin_set_dt(&GPO_SPI_CS_N, 0);
+        return -1;
+    }
+    return 0;
+}
 
+// Block until the transfer started by spi_transfer_start() completes, and
+// CS is deasserted.
+static int32_t spi_transfer_wait(void)
+{
+    int spi_result = 0;
+#ifdef CONFIG_SPI_ASYNC
+    // spi_transfer_done() raises spi_done_sig; sleep until it does.
+    k_poll(&spi_done_evt, 1, K_FOREVER);
+    spi_done_evt.state = K_POLL_STATE_NOT_READY;
+
+    unsigned int spi_signaled;
+    k_poll_signal_check(&spi_done_sig, &spi_signaled, &spi_result);
+#else
     gpio_pin_set_dt(&GPO_SPI_CS_N, 0);
-	return result;
+#endif /* CONFIG_SPI_ASYNC */
+    return spi_result ? -1 : 0;
+}
+
+static int32_t nrf5340_spi_wait_async(void)
+{
+    if (!async_xfer.pending) {
+        return 0;
+    }
+    async_xfer.pending = false;
+    int32_t const error = spi_transfer_wait();
+    return error ? -1 : (int32_t)async_xfer.length;
+}
+
+static void nrf5340_spi_close(void)
+{
+    nrf5340_spi_wait_async();
+}
+
+static int32_t spi_transfer_start_async(void* buff, size_t length, bool is_write)
+{
+    // Only one transfer can be on the bus at a time; collect the previous
+    // one before queueing the next.
+    if (nrf5340_spi_wait_async() < 0) {
+        return -1;
+    }
+    if (spi_transfer_start(buff, length, is_write) != 0) {
+        return -1;
+    }
+    async_xfer.pending = true;
+    async_xfer.length = length;
+    return 0;
+}
+
+static int32_t nrf5340_spi_write_async(const void* tx_buff, size_t length)
+{
+    return spi_transfer_start_async((void*)tx_buff, length, true);
+}
+
+static int32_t nrf5340_spi_read_async(void* rx_buff, size_t length)
+{
+    return spi_transfer_start_async(rx_buff, length, false);
+}
+
+static int32_t nrf5340_spi_write(const void* tx_buff, size_t length)
+{
+    if (spi_transfer_start_async((void*)tx_buff, length, true) != 0) {
+        return -1;
+    }
+    return nrf5340_spi_wait_async();
 }
 
 static int32_t nrf5340_spi_read(void* rx_buff, size_t length)
 {
-    int32_t result = length;
-/*
-    uint8_t tx_buff[32] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-
-    // Perform SPI write operation
-    struct spi_buf tx_buf = {
-        .buf = &tx_buff,
-        .len = length,
-    };
-
-    struct spi_buf_set tx = {
-        .buffers = &tx_buf,
-        .count = 1,
-    };
-*/
-
-    // Perform SPI read operation
-    struct spi_buf rx_buf = {
-        .buf = rx_buff,
-        .len = length,
-    };
-
-    struct spi_buf_set rx = {
-        .buffers = &rx_buf,
-        .count = 1,
-    };
-
-	// Start read transaction
-    gpio_pin_set_dt(&GPO_SPI_CS_N, 1);
-    int error;
-#ifdef CONFIG_SPI_ASYNC
-//    error = spi_transceive_signal(spi_dev, spi_cfg(), &tx, &rx, &spi_done_sig);
-    error = spi_read_signal(spi_dev, spi_cfg(), &rx, &spi_done_sig);
-	if (error != 0){
-		printk("SPI read error: %i\n", error);
-		result = -1;
-    } else {
-        // Wait for transaction to end.
-        int spi_signaled, spi_result;
-        k_poll_signal_check(&spi_done_sig, &spi_signaled, &spi_result);
-        while(spi_signaled == 0) {
-            k_usleep(50);
-            k_poll_signal_check(&spi_done_sig, &spi_signaled, &spi_result);
-        }
-        result = spi_result ? -1 : length;
+    if (spi_transfer_start_async(rx_buff, length, false) != 0) {
+        return -1;
     }
-#else
-    error = spi_read(spi_dev, spi_cfg(), &rx);	
-	if (error != 0){
-		printk("SPI read error: %i\n", error);
-		result = -1;
+    return nrf5340_spi_wait_async();
+}
+
+static uint32_t nrf5340_spi_get_transfer_count(void)
+{
+    return transfer_count;
+}
+
+// The SPIM peripherals divide their clock down to these discrete rates; any
+// other requested frequency is rounded down to one of them. Only SPIM4 runs
+// at 16 and 32 MHz, so the devicetree max-frequency of spiex10 limits the
+// rates reported.
+#define SPIEX10_MAX_FREQUENCY_HZ \
+    DT_PROP_OR(DT_NODELABEL(spiex10), max_frequency, 8000000)
+
+static uint32_t const spim_clock_rates_hz[] = {
+    1000000,
+    2000000,
+    4000000,
+    8000000,
+    16000000,
+    32000000,
+};
+
+static size_t nrf5340_spi_get_clock_rates(uint32_t const** clock_rates_hz)
+{
+    size_t count = 0;
+    while (count < ARRAY_SIZE(spim_clock_rates_hz) &&
+           spim_clock_rates_hz[count] <= SPIEX10_MAX_FREQUENCY_HZ) {
+        count++;
     }
-#endif /* CONFIG_SPI_ASYNC */
-    gpio_pin_set_dt(&GPO_SPI_CS_N, 0);
-	return result;
+    *clock_rates_hz = spim_clock_rates_hz;
+    return count;
 }
 
 static struct Ex10SpiDriver const ex10_spi_driver = {
@@ -186,6 +247,13 @@ static struct Ex10SpiDriver const ex10_spi_driver = {
     .spi_close = nrf5340_spi_close,
     .spi_write = nrf5340_spi_write,
     .spi_read  = nrf5340_spi_read,
+
+    .spi_write_async = nrf5340_spi_write_async,
+    .spi_read_async  = nrf5340_spi_read_async,
+    .spi_wait_async  = nrf5340_spi_wait_async,
+
+    .spi_get_transfer_count = nrf5340_spi_get_transfer_count,
+    .spi_get_clock_rates    = nrf5340_spi_get_clock_rates,
 };
 
 struct Ex10SpiDriver const* get_ex10_spi_driver(void)
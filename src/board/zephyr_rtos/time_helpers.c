@@ -40,6 +40,11 @@ static uint32_t ex10_time_elapsed(uint32_t start_time)
     return time_elapsed;
 }
 
+static uint32_t ex10_time_now_us(void)
+{
+    return (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
 static void ex10_busy_wait_ms(uint32_t msec_to_wait)
 {
     uint64_t end_time_ms = k_uptime_get() + msec_to_wait;
@@ -57,6 +62,7 @@ static void ex10_wait_ms(uint32_t msec_to_wait)
 static struct Ex10TimeHelpers ex10_time_helpers = {
     .time_now     = ex10_time_now,
     .time_elapsed = ex10_time_elapsed,
+    .time_now_us  = ex10_time_now_us,
     .busy_wait_ms = ex10_busy_wait_ms,
     .wait_ms      = ex10_wait_ms,
 };
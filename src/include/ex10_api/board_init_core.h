@@ -25,12 +25,43 @@ static uint32_t const DEFAULT_SPI_CLOCK_HZ = 4000000u;
 /// A reduced clock speed is required when running the Bootloader.
 static uint32_t const BOOTLOADER_SPI_CLOCK_HZ = 1000000u;
 
+/// Pass as the ex10_core_board_setup() spi_clock_hz to negotiate the clock.
+static uint32_t const NEGOTIATE_SPI_CLOCK_HZ = 0u;
+
+/**
+ * The highest SPI clock speed tried when negotiating the SPI clock. The host
+ * interface clock rates may limit the speed further.
+ */
+static uint32_t const MAX_NEGOTIATED_SPI_CLOCK_HZ = 16000000u;
+
+/**
+ * @struct Ex10SpiClockNegotiation
+ * The outcome of the most recent SPI clock negotiation.
+ * @see ex10_core_board_negotiate_spi_clock()
+ */
+struct Ex10SpiClockNegotiation
+{
+    /// The SPI clock speed selected for use with the Application.
+    uint32_t selected_clock_hz;
+    /// The highest SPI clock speed tested without errors.
+    uint32_t highest_passing_hz;
+    /// The lowest SPI clock speed tested with errors; 0 if none failed.
+    uint32_t first_failing_hz;
+    /// The number of bytes in error and failed transfers at first_failing_hz.
+    uint32_t error_count;
+    /// The number of TransferTest commands run at each clock speed.
+    uint32_t transfers_per_clock;
+};
+
 /**
  * Initialize the Impinj Reader Chip core SDK.  This includes the
  * Ops and protocol layers, and any board bring up.
  *
  * @param region_id    The region to initialize the active region with
- * @param spi_clock_hz The SPI inteface clock speed in Hz
+ * @param spi_clock_hz The SPI inteface clock speed in Hz used when running
+ *                     the Application. Pass NEGOTIATE_SPI_CLOCK_HZ to select
+ *                     the speed using ex10_core_board_negotiate_spi_clock()
+ *                     up to MAX_NEGOTIATED_SPI_CLOCK_HZ.
  *
  * @return struct Ex10Result
  *         Indicates whether the function call passed or failed.
@@ -38,6 +69,34 @@ static uint32_t const BOOTLOADER_SPI_CLOCK_HZ = 1000000u;
 struct Ex10Result ex10_core_board_setup(enum Ex10RegionId region_id,
                                         uint32_t          spi_clock_hz);
 
+/**
+ * Find the fastest reliable SPI clock speed for this board.
+ * The SPI clock is stepped upward from DEFAULT_SPI_CLOCK_HZ, running a set
+ * of TransferTest command patterns at each speed, until a transfer fails or
+ * max_clock_hz is reached. The speeds stepped through are those reported by
+ * HostInterface.get_clock_rates(), so only speeds the bus runs at are tried.
+ * Each speed must pass the patterns several times in a row; the highest
+ * speed to do so is selected and set as the Application SPI clock. On the
+ * nRF5340 SPIM this allows 8 MHz to be selected when the link supports it.
+ *
+ * @note The Impinj Reader Chip must be running the Application, and no
+ *       operations may be running.
+ *
+ * @param max_clock_hz The highest SPI clock speed to try.
+ *
+ * @return struct Ex10Result
+ *         Indicates whether the function call passed or failed.
+ *         If no speed passes, the Application SPI clock is left unchanged.
+ */
+struct Ex10Result ex10_core_board_negotiate_spi_clock(uint32_t max_clock_hz);
+
+/**
+ * @return struct Ex10SpiClockNegotiation const*
+ *         The results of the most recent SPI clock negotiation.
+ */
+struct Ex10SpiClockNegotiation const*
+    ex10_core_board_get_spi_clock_negotiation(void);
+
 /**
  * Initialize the Impinj Reader Chip and its associated Ex10 host interfaces
  * in a minimal configuration for communication with the bootloader. This
@@ -98,6 +98,65 @@ struct Ex10CommandTransactor
                                              void*       response_buffer,
                                              size_t      response_buffer_length,
                                              uint32_t    ready_n_timeout_ms);
+
+    /**
+     * Select how send_command() and receive_response() wait for the Ex10
+     * READY_N line to assert. The default is ReadyNWaitSpin.
+     * Callers that can tolerate a small amount of added latency, such as
+     * long running inventory, may select ReadyNWaitInterrupt to release the
+     * CPU to lower priority threads while the Ex10 is busy.
+     *
+     * @param wait_mode The READY_N wait method to use for all subsequent
+     *                  transactions.
+     *
+     * @return enum ReadyNWaitMode The previously selected wait method, so
+     *         that a call site may restore it when done.
+     */
+    enum ReadyNWaitMode (*set_ready_n_wait_mode)(enum ReadyNWaitMode wait_mode);
+
+    /**
+     * Sends a command from the host to the Ex10 without waiting for the
+     * host interface transfer to complete. Blocks until READY_N is asserted
+     * by Ex10, starts the transfer and returns, allowing the caller to do
+     * other work while the bytes are clocked out and the Ex10 processes the
+     * command.
+     *
+     * The command_buffer must remain unmodified until the transfer is
+     * completed by wait_transfer_complete(), or implicitly by the next
+     * transactor call. If the host interface does not support asynchronous
+     * transfers this behaves as send_command().
+     *
+     * @see send_command() for parameters and errors reported.
+     */
+    struct Ex10Result (*send_command_async)(const void* command_buffer,
+                                            size_t      command_length,
+                                            uint32_t    ready_n_timeout_ms);
+
+    /**
+     * Receives a response from the Ex10 without waiting for the host
+     * interface transfer to complete. Blocks until READY_N is asserted by
+     * Ex10, starts the transfer and returns.
+     *
+     * The response_buffer contents are not valid until
+     * wait_transfer_complete() returns successfully. The received length
+     * is checked at that time. If the host interface does not support
+     * asynchronous transfers this behaves as receive_response().
+     *
+     * @see receive_response() for parameters and errors reported.
+     */
+    struct Ex10Result (*receive_response_async)(void*  response_buffer,
+                                                size_t response_buffer_length,
+                                                uint32_t ready_n_timeout_ms);
+
+    /**
+     * Wait for the transfer started by send_command_async() or
+     * receive_response_async() to complete.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the transfer passed or failed. Success is
+     *         returned when no transfer is outstanding.
+     */
+    struct Ex10Result (*wait_transfer_complete)(void);
 };
 
 struct Ex10CommandTransactor const* get_ex10_command_transactor(void);
@@ -216,6 +216,39 @@ struct Ex10Commands
     struct Ex10Result (*read_fifo)(enum FifoSelection selection,
                                    struct ByteSpan*   byte_span);
 
+    /**
+     * Send a ReadFifo command without waiting for the transfer to complete.
+     * The command is clocked out while the caller continues, for instance
+     * to hand previously read EventFifo bytes up the stack. The response
+     * must be collected with read_fifo_chunk_finish() before any other
+     * command is issued.
+     *
+     * @param selection Which FIFO to read from.
+     * @param fifo_len  The number of bytes to read. This must not exceed
+     *                  EX10_SPI_BURST_SIZE - 1.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*read_fifo_chunk_start)(enum FifoSelection selection,
+                                               size_t             fifo_len);
+
+    /**
+     * Receive the response to the ReadFifo command sent by
+     * read_fifo_chunk_start().
+     *
+     * @param data     Where the fifo bytes are placed. The byte at data[-1]
+     *                 receives the response code and is restored before
+     *                 returning, so it must be writable.
+     * @param fifo_len The length passed to read_fifo_chunk_start().
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     *         Can return a device_response error if the response code is
+     *         not Success.
+     */
+    struct Ex10Result (*read_fifo_chunk_finish)(uint8_t* data, size_t fifo_len);
+
     /**
      * Erase and write to an info page.
      *
@@ -417,8 +417,14 @@ union PacketData
 
 struct EventFifoPacket
 {
-    enum EventPacketType    packet_type;
-    uint32_t                us_counter;
+    enum EventPacketType packet_type;
+    uint32_t             us_counter;
+    /**
+     * The us_counter extended to 64 bits by Ex10DeviceTime
+     * extend_us_counter(). It is set for packets returned by the
+     * Ex10EventFifoQueue, and is zero for packets from other sources.
+     */
+    uint64_t                timestamp_us;
     union PacketData const* static_data;
     size_t                  static_data_length;
     uint8_t const*          dynamic_data;
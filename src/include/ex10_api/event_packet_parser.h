@@ -80,6 +80,44 @@ struct Ex10EventParser
      */
     struct PacketHeader (*make_packet_header)(
         enum EventPacketType event_packet_type);
+
+    /**
+     * Set the packet types delivered by skip_unsubscribed_packets().
+     * Packets which drive the use case state machines are always delivered:
+     * InventoryRoundSummary, ContinuousInventorySummary, AggregateOpSummary,
+     * Halted, InvalidPacket, FifoOverflowPacket and Ex10ResultPacket.
+     * Packets of unknown type are also delivered, so that parse_event_packet()
+     * reports them.
+     *
+     * The filter is read within the IRQ_N monitor thread context and must
+     * only be changed while no operation is producing EventFifo data.
+     *
+     * @param packet_types The packet types to deliver. If NULL, the filter is
+     *                     cleared and all packets are delivered.
+     * @param count        The number of entries in packet_types.
+     */
+    void (*set_packet_type_filter)(enum EventPacketType const* packet_types,
+                                   size_t                      count);
+
+    /**
+     * Returns whether packets of the passed type pass the packet type filter.
+     *
+     * @param packet_type The Event packet type.
+     */
+    bool (*get_packet_type_subscribed)(enum EventPacketType packet_type);
+
+    /**
+     * Advance a packet stream past the packets removed by the packet type
+     * filter. Only the PacketHeader of each skipped packet is read. Skipping
+     * stops at the first delivered packet, or at the first packet whose
+     * header does not describe a well formed packet; that packet is left for
+     * parse_event_packet() to validate.
+     *
+     * @param bytes [in/out] The packet stream to advance.
+     *
+     * @return size_t The number of packets skipped.
+     */
+    size_t (*skip_unsubscribed_packets)(struct ConstByteSpan* bytes);
 };
 
 struct Ex10EventParser const* get_ex10_event_parser(void);
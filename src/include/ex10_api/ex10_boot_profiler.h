@@ -0,0 +1,105 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The most phases recorded between start() and stop().
+#define BOOT_PROFILER_MAX_PHASES ((size_t)24u)
+
+/// The deepest nesting of phases which is recorded.
+#define BOOT_PROFILER_MAX_DEPTH ((size_t)4u)
+
+/**
+ * @struct Ex10BootPhase
+ * The time spent, and the SPI transfers made, in one phase of the boot.
+ */
+struct Ex10BootPhase
+{
+    /// The name passed to begin_phase(); a string literal.
+    char const* name;
+    /// The phases this one is nested within; 0 for a top level phase.
+    uint8_t depth;
+    /// The time_now_us() value when the phase began.
+    uint32_t start_us;
+    /// The duration of the phase, including its nested phases.
+    uint32_t duration_us;
+    /**
+     * The CS framed host interface transfers made during the phase. This is
+     * zero if the host interface does not count its transfers.
+     */
+    uint32_t spi_transfers;
+};
+
+/**
+ * @struct Ex10BootProfiler
+ * Records a per phase breakdown of the time from power-on to the first
+ * inventory. The SDK reports the phases of ex10_core_board_setup() and the
+ * board calibration reports its own; applications add their phases around
+ * these. Nothing is recorded until start() is called, so the phase reports
+ * cost only a test when profiling is not in use.
+ *
+ * Phases must be begun and ended from a single thread. SPI transfers are
+ * counted by the host interface, so those made by the IRQ_N monitor
+ * thread during a phase are included in its count.
+ */
+struct Ex10BootProfiler
+{
+    /// Clear the recorded phases and start recording.
+    void (*start)(void);
+
+    /// Stop recording. Phases still open are ended.
+    void (*stop)(void);
+
+    /**
+     * Begin a phase. Phases begun before the current phase is ended are
+     * nested within it. Phases beyond BOOT_PROFILER_MAX_PHASES or
+     * BOOT_PROFILER_MAX_DEPTH are counted as dropped.
+     *
+     * @param name The phase name, which must remain valid; typically a
+     *             string literal.
+     */
+    void (*begin_phase)(char const* name);
+
+    /// End the most recently begun phase which has not yet been ended.
+    void (*end_phase)(void);
+
+    /// @return size_t The number of phases recorded.
+    size_t (*get_phase_count)(void);
+
+    /**
+     * @param index The phase index, in the order the phases were begun.
+     *
+     * @return The phase, or NULL if index is out of range. A phase which
+     *         has not been ended has a duration_us of zero.
+     */
+    struct Ex10BootPhase const* (*get_phase)(size_t index);
+
+    /// @return size_t The number of phases which could not be recorded.
+    size_t (*get_dropped_count)(void);
+
+    /// Print the recorded phases as a table, nested phases indented.
+    void (*print_phases)(void);
+};
+
+struct Ex10BootProfiler const* get_ex10_boot_profiler(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -51,6 +51,42 @@ struct Ex10DeviceTime
      * @param msec_to_wait The number of milliseconds to wait.
      */
     struct Ex10Result (*wait_ms)(uint32_t msec_to_wait);
+
+    /**
+     * Anchor the 64-bit timestamps returned by extend_us_counter() to a
+     * device us_counter value which was just read from the Impinj Reader
+     * Chip. The first anchor ties the device counter to the host uptime
+     * reported by Ex10TimeHelpers time_now(). Later anchors keep the existing
+     * timeline unless the device counter no longer agrees with it, as after
+     * an Impinj Reader Chip reset, in which case it is re-tied to host time.
+     * A re-tied timeline never starts at or before a timestamp already
+     * returned, so timestamps do not move backward across a reset.
+     *
+     * Anchor at least once every 49 days, the wrap period of the host
+     * uptime. The anchor is guarded by a mutex, so it may be set while
+     * extend_us_counter() runs on the IRQ_N monitor thread. Packets read
+     * before a reset but extended after it are placed on the new timeline,
+     * so anchor while no operation is producing EventFifo data.
+     *
+     * @param us_counter The current device microsecond counter.
+     *
+     * @return uint64_t The 64-bit timestamp of us_counter.
+     */
+    uint64_t (*anchor_us_counter)(uint32_t us_counter);
+
+    /**
+     * Extend a 32-bit device microsecond counter value, such as a
+     * PacketHeader us_counter, to a 64-bit timestamp in microseconds on the
+     * anchored host uptime timeline. The counter wrap is resolved using the
+     * host time elapsed since the anchor, so values up to about 35 minutes
+     * either side of the current time are extended correctly. If no anchor
+     * has been set, us_counter is used as the anchor.
+     *
+     * @param us_counter The device microsecond counter value.
+     *
+     * @return uint64_t The 64-bit timestamp in microseconds.
+     */
+    uint64_t (*extend_us_counter)(uint32_t us_counter);
 };
 
 struct Ex10DeviceTime* get_ex10_device_time(void);
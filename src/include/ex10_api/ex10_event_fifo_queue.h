@@ -13,15 +13,20 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#include "ex10_api/ex10_result.h"
 #include "ex10_api/fifo_buffer_list.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/// The maximum number of packets returned by packet_peek_batch().
+#define EVENT_FIFO_PACKET_BATCH_SIZE ((size_t)32u)
+
 
 struct Ex10EventFifoQueue
 {
@@ -40,7 +45,8 @@ struct Ex10EventFifoQueue
     void (*list_node_push_back)(struct FifoBufferNode* fifo_buffer_node);
 
     /**
-     * Return the packet at the front of the packet queue.
+     * Return the packet at the front of the packet queue. Packets removed by
+     * the Ex10EventParser packet type filter are skipped and never returned.
      *
      * @return An EventFifoPacket or NULL if none available.
      */
@@ -64,6 +70,29 @@ struct Ex10EventFifoQueue
      */
     void (*packet_remove)(void);
 
+    /**
+     * Return the packets at the front of the packet queue as an array. The
+     * array holds the front packet and the packets following it in the same
+     * FifoBufferNode, up to EVENT_FIFO_PACKET_BATCH_SIZE packets; it never
+     * spans two nodes. Calling this again before packet_remove_batch()
+     * returns the same packets.
+     *
+     * @note Once packet_peek_batch() has been called, packet_remove_batch()
+     *       must be called before calling packet_peek() or packet_remove().
+     *
+     * @param [out] packets Set to the first packet of the batch, or NULL.
+     *
+     * @return size_t The number of packets in the batch, 0 if no packets are
+     *                available.
+     */
+    size_t (*packet_peek_batch)(struct EventFifoPacket const** packets);
+
+    /**
+     * Delete all packets returned by packet_peek_batch(). As with
+     * packet_remove(), the packet pointers become invalid.
+     */
+    void (*packet_remove_batch)(void);
+
     /**
      * Wait, blocking until packets are ready for reading.
      * When packets are available to read, this function will unblock.
@@ -87,6 +116,30 @@ struct Ex10EventFifoQueue
      *       that is waiting for packets.
      */
     void (*packet_unwait)(void);
+
+    /**
+     * Select how FifoBufferNode elements are passed from the IRQ_N monitor
+     * thread to the packet consumer. By default a mutex protected list is
+     * used. In ring mode a lock-free single producer, single consumer ring
+     * is used instead; the list mutex is only taken when the consumer blocks
+     * in packet_wait() and the producer must wake it.
+     *
+     * @note In ring mode list_node_push_back() must only be called from the
+     *       IRQ_N monitor thread and the packet functions from a single
+     *       consumer thread.
+     * @note The mode can only be changed while the queue holds no packets;
+     *       e.g. after init() and before starting an inventory. init()
+     *       returns the queue to list mode.
+     *
+     * @param enable If true, use the lock-free ring.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the mode was changed.
+     * @retval Ex10SdkErrorInvalidState  The queue holds packets.
+     * @retval Ex10SdkErrorBadParamLength The buffer pools hold more nodes
+     *         than the ring can contain.
+     */
+    struct Ex10Result (*enable_ring_mode)(bool enable);
 };
 
 const struct Ex10EventFifoQueue* get_ex10_event_fifo_queue(void);
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2020 - 2024 Impinj, Inc. All rights reserved.               *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/fifo_buffer_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The number of bins in Ex10EventPipelineStats.drain_histogram.
+#define EVENT_PIPELINE_DRAIN_HISTOGRAM_BINS ((size_t)10u)
+
+/// The drain length, in bytes, counted by the first histogram bin.
+#define EVENT_PIPELINE_DRAIN_HISTOGRAM_MIN ((size_t)16u)
+
+/**
+ * @struct Ex10EventPipelineStats
+ * Counters describing the flow of EventFifo data from the IRQ_N monitor
+ * thread, through the EventFifo queue, to the thread publishing packets.
+ */
+struct Ex10EventPipelineStats
+{
+    /// IRQ_N interrupts handled by Ex10Protocol.
+    uint32_t irq_count;
+    /// Interrupts which read data from the EventFifo.
+    uint32_t drain_count;
+    /// The total number of EventFifo bytes read.
+    uint64_t drain_bytes;
+    /// The largest number of bytes read by a single drain.
+    uint32_t drain_bytes_max;
+    /**
+     * Bin 0 counts drains shorter than EVENT_PIPELINE_DRAIN_HISTOGRAM_MIN
+     * bytes. Each following bin counts drains shorter than twice the limit
+     * of the bin before it. The last bin counts all longer drains.
+     */
+    uint32_t drain_histogram[EVENT_PIPELINE_DRAIN_HISTOGRAM_BINS];
+    /**
+     * The fewest free EventFifo buffers left in the FifoBufferList after a
+     * buffer was taken for a drain. SIZE_MAX if no buffer has been taken.
+     */
+    size_t free_list_low_water;
+    /// The number of times no free EventFifo buffer was available.
+    uint32_t free_list_empty_count;
+    /// The most FifoBufferNodes held in the EventFifo queue at once.
+    size_t queue_depth_high_water;
+    /// FifoOverflowPacket packets removed from the EventFifo queue.
+    uint32_t overflow_packets;
+    /// FifoBufferNodes whose IRQ_N to dequeue latency was measured.
+    uint32_t latency_count;
+    /// The sum of the measured IRQ_N to dequeue latencies.
+    uint64_t latency_total_us;
+    /// The longest measured IRQ_N to dequeue latency.
+    uint32_t latency_max_us;
+};
+
+/**
+ * @struct Ex10EventPipelineMonitor
+ * Collects Ex10EventPipelineStats. The record functions are called by the
+ * SDK from the IRQ_N monitor thread and from the packet consumer thread.
+ * Each counter is written from only one of those threads, so no locking is
+ * used; a copy taken with get_stats() while EventFifo data is flowing may
+ * mix counts from before and after an interrupt.
+ */
+struct Ex10EventPipelineMonitor
+{
+    /// Clear the statistics.
+    void (*init)(void);
+
+    /// Count an IRQ_N interrupt.
+    void (*record_irq)(void);
+
+    /**
+     * Count an EventFifo drain.
+     *
+     * @param num_bytes The number of bytes read from the EventFifo.
+     */
+    void (*record_drain)(size_t num_bytes);
+
+    /**
+     * Record the number of free EventFifo buffers left after taking one.
+     *
+     * @param free_count The number of buffers remaining in the free list.
+     */
+    void (*record_free_list_size)(size_t free_count);
+
+    /// Count a failure to take a free EventFifo buffer.
+    void (*record_free_list_empty)(void);
+
+    /**
+     * Record the EventFifo queue depth after a node was added to it.
+     *
+     * @param depth The number of FifoBufferNodes in the queue.
+     */
+    void (*record_queue_depth)(size_t depth);
+
+    /// Count a FifoOverflowPacket removed from the EventFifo queue.
+    void (*record_overflow_packet)(void);
+
+    /**
+     * Record the latency from the IRQ_N interrupt which read a node to the
+     * start of its processing by the packet consumer.
+     *
+     * @param fifo_buffer_node The node being processed. Nodes without an
+     *                         IRQ_N timestamp are ignored.
+     */
+    void (*record_dequeue)(struct FifoBufferNode const* fifo_buffer_node);
+
+    /**
+     * Copy the current statistics.
+     *
+     * @param stats The structure to fill in.
+     */
+    void (*get_stats)(struct Ex10EventPipelineStats* stats);
+
+    /// Clear the statistics.
+    void (*reset_stats)(void);
+
+    /// Print the current statistics.
+    void (*print_stats)(void);
+};
+
+struct Ex10EventPipelineMonitor const* get_ex10_event_pipeline_monitor(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -68,6 +68,62 @@ struct Ex10FirmwareVersion
     uint32_t build_number;
 };
 
+/**
+ * @struct Ex10EventFifoThresholdLimits
+ * The configuration of the adaptive EventFifo threshold controller.
+ * @see Ex10Protocol.enable_adaptive_event_fifo_threshold()
+ */
+struct Ex10EventFifoThresholdLimits
+{
+    /// The lowest threshold in bytes, used when few tags are being read.
+    uint16_t min_threshold;
+    /// The highest threshold in bytes, used at high tag rates.
+    uint16_t max_threshold;
+    /// The time in milliseconds the EventFifo should take to fill to the
+    /// threshold at the observed byte rate.
+    uint32_t target_latency_ms;
+    /// The period in milliseconds over which drains are measured before the
+    /// threshold is re-evaluated.
+    uint32_t window_ms;
+    /// The TagRead and TagReadExtended packet rate below which the threshold
+    /// is set straight to min_threshold, so that the few tags in the field
+    /// are reported with the least latency.
+    uint32_t min_tags_per_s;
+};
+
+/**
+ * @struct Ex10EventFifoThresholdStats
+ * The decisions made by the adaptive EventFifo threshold controller.
+ */
+struct Ex10EventFifoThresholdStats
+{
+    /// The EventFifo threshold currently written to the Impinj Reader Chip.
+    uint16_t threshold;
+    /// EventFifo drains observed while the controller was enabled.
+    uint32_t drains;
+    /// Windows at the end of which the threshold was re-evaluated.
+    uint32_t evaluations;
+    /// Evaluations made by the window_ms timer rather than by a drain.
+    uint32_t timer_evaluations;
+    /// Evaluations which set min_threshold because of a low tag rate.
+    uint32_t low_tag_rate_lowers;
+    /// Evaluations which raised the threshold.
+    uint32_t raises;
+    /// Evaluations which lowered the threshold.
+    uint32_t lowers;
+    /// Evaluations which left the threshold unchanged.
+    uint32_t holds;
+    /// Threshold register writes which failed.
+    uint32_t write_errors;
+    /// The EventFifo byte rate measured in the last window.
+    uint32_t bytes_per_s;
+    /// The TagRead and TagReadExtended packet rate measured in the last
+    /// window.
+    uint32_t tags_per_s;
+    /// The mean number of bytes per drain in the last window.
+    uint32_t mean_drain_bytes;
+};
+
 /**
  * @struct Ex10Protocol
  * Ex10 Protocol interface.
@@ -162,6 +218,24 @@ struct Ex10Protocol
      */
     void (*enable_interrupt_handlers)(bool enable);
 
+    /**
+     * Select how the EventFifo is drained when the interrupt handler reads
+     * it. By default the whole EventFifo is read into one FifoBufferNode
+     * before it is passed to the fifo data callback.
+     *
+     * When enabled, the EventFifo is read in ReadFifo command sized chunks,
+     * and each ReadFifo command is sent while the complete packets from the
+     * previous chunks are passed to the fifo data callback in their own
+     * FifoBufferNode. This reduces the time from IRQ_N to the first packet
+     * reaching the callback, at the cost of using more buffers.
+     *
+     * @note In this mode the fifo data callback is called while a ReadFifo
+     *       command is outstanding; it must not issue Ex10 commands.
+     *
+     * @param enable If true, drain the EventFifo in pipelined chunks.
+     */
+    void (*enable_pipelined_fifo_drain)(bool enable);
+
     /**
      * Read an Ex10 Register.
      *
@@ -461,6 +535,45 @@ struct Ex10Protocol
      */
     struct Ex10Result (*set_event_fifo_threshold)(size_t threshold);
 
+    /**
+     * Enable or disable the adaptive EventFifo threshold controller.
+     *
+     * While enabled, the IRQ_N monitor thread measures the size and rate of
+     * EventFifo drains. At the end of each window the threshold is moved
+     * towards the number of bytes the EventFifo receives in
+     * target_latency_ms, by at most a factor of two, and kept between
+     * min_threshold (low latency) and max_threshold (fewer interrupts and
+     * register reads per packet). When the tag rate is below
+     * min_tags_per_s the threshold is set to min_threshold at once.
+     *
+     * Windows are ended by drains and, when the threshold is too high for
+     * the EventFifo to fill and be drained, by a window_ms timer on the
+     * IRQ_N monitor thread.
+     *
+     * @note A call to set_event_fifo_threshold() while the controller is
+     *       enabled sets the threshold the controller continues from.
+     *
+     * @param enable If true, enable the controller. If false, disable it and
+     *               restore DEFAULT_EVENT_FIFO_THRESHOLD.
+     * @param limits The controller configuration, or NULL to use the SDK
+     *               defaults. Ignored when enable is false.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*enable_adaptive_event_fifo_threshold)(
+        bool                                       enable,
+        struct Ex10EventFifoThresholdLimits const* limits);
+
+    /**
+     * Copy the adaptive EventFifo threshold controller counters. The
+     * counters are cleared when the controller is enabled.
+     *
+     * @param [out] stats The structure to fill in.
+     */
+    void (*get_adaptive_event_fifo_threshold_stats)(
+        struct Ex10EventFifoThresholdStats* stats);
+
     /**
      * Insert a host defined event in the event fifo stream.
      *
@@ -659,6 +772,10 @@ struct Ex10Protocol
      * Read the device information register from the Impinj Reader Chip.
      * This will return information about the silicon revision.
      *
+     * @note This value, along with the firmware versions, image validity,
+     *       SKU and the last info page read, is read from the device once
+     *       and then served from a cache. @see invalidate_read_cache
+     *
      * @param [out] struct DeviceInfoFields
      *              The device information register fields.
      *
@@ -688,10 +805,10 @@ struct Ex10Protocol
     /**
      * Read the version information for the Impinj Reader Chip Bootloader image.
      *
-     * @note Calling this function will result in a reset into the Bootloader,
-     *       reading of the Bootloader version information registers, and
-     *       then, if the original call was made from the Application, a reset
-     *       back to the Application.
+     * @note Unless the version is already cached, calling this function will
+     *       result in a reset into the Bootloader, reading of the Bootloader
+     *       version information registers, and then, if the original call was
+     *       made from the Application, a reset back to the Application.
      *
      * @param [out] firmware_version
      *              The Bootloader firmware version information.
@@ -731,6 +848,34 @@ struct Ex10Protocol
      * @return enum ProductSku The Ex10 device product SKU.
      */
     enum ProductSku (*get_sku)(void);
+
+    /**
+     * Discard the cached device information, firmware versions, image
+     * validity, SKU and info page contents. The cache is invalidated by
+     * reset(), upload_complete() and write_info_page(); this must also be
+     * called when the Impinj Reader Chip is restarted by other means, such as
+     * toggling its power or RESET_N line.
+     */
+    void (*invalidate_read_cache)(void);
+
+    /**
+     * Set the SPI clock rate used while the Impinj Reader Chip is running the
+     * Application. The host interface is reopened at this rate immediately,
+     * and after each reset or power up into the Application. The rate is
+     * returned to DEFAULT_SPI_CLOCK_HZ by init().
+     *
+     * @note This must only be called when the Impinj Reader Chip is running
+     *       the Application. The Bootloader requires BOOTLOADER_SPI_CLOCK_HZ.
+     *
+     * @param clock_hz The SPI clock rate in Hz.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*set_application_spi_clock)(uint32_t clock_hz);
+
+    /// @return uint32_t The SPI clock rate in Hz used for the Application.
+    uint32_t (*get_application_spi_clock)(void);
 };
 
 struct Ex10Protocol const* get_ex10_protocol(void);
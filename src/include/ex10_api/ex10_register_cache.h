@@ -0,0 +1,141 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2020 - 2024 Impinj, Inc. All rights reserved.               *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/application_register_definitions.h"
+#include "ex10_api/ex10_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct Ex10RegisterCacheStats
+ * Counters describing how the register cache has filtered register writes.
+ * Each count is in register write segments, i.e. one per register (or
+ * partial register) passed to Ex10Protocol.write_multiple().
+ */
+struct Ex10RegisterCacheStats
+{
+    /// Segments sent to the Impinj Reader Chip.
+    uint32_t writes_issued;
+    /// Segments dropped because the cached value matched the written value.
+    uint32_t writes_skipped;
+    /// Issued segments merged into an address adjacent preceding segment.
+    uint32_t writes_merged;
+    /// Write commands sent to the Impinj Reader Chip while enabled.
+    uint32_t write_commands;
+    /// Number of times the whole cache was invalidated.
+    uint32_t invalidations;
+};
+
+/**
+ * @struct Ex10RegisterCache
+ * A shadow copy of the host configured Impinj Reader Chip application
+ * registers. When enabled, Ex10Protocol register writes are filtered through
+ * the cache: writes that do not change a cached register value are dropped
+ * and address adjacent cached registers are merged into a single write
+ * segment.
+ *
+ * Only registers which are configured by the host and are not modified by
+ * the Impinj Reader Chip firmware are cached. Writes to all other registers
+ * pass through unchanged.
+ *
+ * The cache contents are invalidated whenever the Impinj Reader Chip is
+ * reset, powered up or powered down, and when an AggregateOp is started.
+ * Any other path which modifies cached registers without going through
+ * Ex10Protocol must call invalidate().
+ */
+struct Ex10RegisterCache
+{
+    /// Invalidate the cache, clear the statistics and disable the cache.
+    void (*init)(void);
+
+    /**
+     * Enable or disable write filtering. The cache is disabled by default.
+     * Enabling the cache invalidates it, so the first write to each register
+     * is always sent to the Impinj Reader Chip.
+     *
+     * @param enable If true, writes are filtered through the cache.
+     */
+    void (*enable)(bool enable);
+
+    /// @return bool true if write filtering is enabled.
+    bool (*is_enabled)(void);
+
+    /// Mark all cached register values as unknown.
+    void (*invalidate)(void);
+
+    /**
+     * Mark the cached register bytes within an address range as unknown.
+     *
+     * @param address The first register address to invalidate.
+     * @param length  The number of bytes to invalidate.
+     */
+    void (*invalidate_range)(uint16_t address, uint16_t length);
+
+    /**
+     * Write a list of registers through the cache. Segments which do not
+     * change the cached register contents are dropped, adjacent cached
+     * segments are merged and the remaining segments are passed to write_fn.
+     * If write_fn fails, the cached values for the segments are invalidated.
+     *
+     * @param reg_list The list of registers to write.
+     * @param buffers  The data to write, one buffer per register.
+     * @param num_regs The number of entries in reg_list and buffers.
+     * @param write_fn The uncached write function used to access the device.
+     *
+     * @return struct Ex10Result
+     *         The result of the final write_fn call, or success if all
+     *         segments were skipped.
+     */
+    struct Ex10Result (*write_multiple)(
+        struct RegisterInfo const* const reg_list[],
+        void const*                      buffers[],
+        size_t                           num_regs,
+        struct Ex10Result (*write_fn)(struct RegisterInfo const* const[],
+                                      void const*[],
+                                      size_t));
+
+    /**
+     * Update the cache with register contents read from the device.
+     *
+     * @param reg_list The list of registers read.
+     * @param buffers  The data read, one buffer per register.
+     * @param num_regs The number of entries in reg_list and buffers.
+     */
+    void (*update_from_read)(struct RegisterInfo const* const reg_list[],
+                             void*                            buffers[],
+                             size_t                           num_regs);
+
+    /**
+     * Copy the current cache statistics.
+     *
+     * @param stats The structure to fill in.
+     */
+    void (*get_stats)(struct Ex10RegisterCacheStats* stats);
+
+    /// Clear the cache statistics.
+    void (*reset_stats)(void);
+};
+
+struct Ex10RegisterCache const* get_ex10_register_cache(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,252 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2020 - 2024 Impinj, Inc. All rights reserved.               *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/channel_types.h"
+#include "ex10_api/ex10_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The longest EPC, in bytes, which can be stored in an Ex10TagDedupEntry.
+#define TAG_DEDUP_EPC_MAX_LENGTH ((size_t)32u)
+
+/// The largest number of entries the table can be initialized with.
+#define TAG_DEDUP_MAX_ENTRIES ((size_t)0x8000u)
+
+/// The Ex10TagDedupEntry LRU link value which refers to no entry.
+#define TAG_DEDUP_NO_ENTRY ((uint16_t)0xFFFFu)
+
+/**
+ * @struct Ex10TagDedupRead
+ * A single tag read, as passed to Ex10TagDedupTable.record_read().
+ */
+struct Ex10TagDedupRead
+{
+    /// The tag's Protocol-Control word.
+    uint16_t pc;
+    /// The EPC bytes backscattered by the tag, not including the PC.
+    uint8_t const* epc;
+    /// The number of bytes pointed to by epc.
+    size_t epc_length;
+    /// The Ex10 microsecond counter from the TagRead packet.
+    uint32_t us_counter;
+    /// The 64-bit extended timestamp from the TagRead packet.
+    uint64_t timestamp_us;
+    /// The compensated RSSI of the read.
+    int16_t rssi_cdbm;
+    /// The antenna port the tag was read on.
+    uint8_t antenna;
+    /// The index of the channel the tag was read on.
+    channel_index_t channel_index;
+};
+
+/**
+ * @struct Ex10TagDedupEntry
+ * The statistics kept for one unique PC + EPC. The storage for the entries
+ * is provided by the caller of Ex10TagDedupTable.init().
+ */
+struct Ex10TagDedupEntry
+{
+    /// The tag's Protocol-Control word.
+    uint16_t pc;
+    /// The number of valid bytes in epc.
+    uint8_t epc_length;
+    /// Whether the entry holds a tag.
+    bool in_use;
+    /// The EPC bytes, not including the PC.
+    uint8_t epc[TAG_DEDUP_EPC_MAX_LENGTH];
+    /// The hash of the PC and EPC, used to place the entry in the table.
+    uint32_t hash;
+    /// The number of times the tag was read.
+    uint32_t read_count;
+    /// The Ex10 microsecond counter of the first read.
+    uint32_t first_us_counter;
+    /// The Ex10 microsecond counter of the most recent read.
+    uint32_t last_us_counter;
+    /// The 64-bit extended timestamp of the most recent read.
+    uint64_t last_timestamp_us;
+    /// The sum of the compensated RSSI of all reads.
+    int64_t rssi_sum_cdbm;
+    /// The highest compensated RSSI read.
+    int16_t peak_rssi_cdbm;
+    /// Bit n is set if the tag was read on antenna port n, for n < 32.
+    uint32_t antenna_bitmap;
+    /// Bit n is set if the tag was read on channel index n, for n < 64.
+    uint64_t channel_bitmap;
+    /// The more recently read neighbour in the LRU list.
+    uint16_t lru_prev;
+    /// The less recently read neighbour in the LRU list.
+    uint16_t lru_next;
+};
+
+/**
+ * @struct Ex10TagDedupStats
+ * Counters describing the use of the table since init() or clear().
+ */
+struct Ex10TagDedupStats
+{
+    /// The number of tags currently held in the table.
+    size_t unique_tags;
+    /// The number of tags currently held which have been read more than once.
+    size_t multi_read_tags;
+    /// The number of reads recorded.
+    uint32_t total_reads;
+    /// The number of reads which added a tag to the table.
+    uint32_t new_tags;
+    /// Entries evicted to make room for a new tag.
+    uint32_t lru_evictions;
+    /// Entries evicted because they had not been read within the max age.
+    uint32_t age_evictions;
+    /// Reads not recorded because the EPC was longer than the key.
+    uint32_t rejected_reads;
+};
+
+/**
+ * The callback type used by Ex10TagDedupTable.iterate().
+ *
+ * @param entry   The entry being visited.
+ * @param context The context passed to iterate().
+ */
+typedef void (*tag_dedup_entry_callback_t)(
+    struct Ex10TagDedupEntry const* entry,
+    void*                           context);
+
+/**
+ * @struct Ex10TagDedupTable
+ * A fixed-memory table of the unique tags inventoried, keyed on PC + EPC.
+ * The table uses open addressing with linear probing, so recording a read
+ * takes constant time on average, regardless of the number of tags held.
+ *
+ * Entries are kept in a least recently read order. When a new tag is read
+ * while the table is 3/4 full, the least recently read entry is evicted.
+ * If a max age is set, entries not read within that time of the newest
+ * recorded read are evicted as reads are recorded.
+ *
+ * @note The table is not thread safe; it is intended to be used from the
+ *       packet subscriber callback of a use case.
+ */
+struct Ex10TagDedupTable
+{
+    /**
+     * Initialize the table, discarding all entries.
+     *
+     * @param entries     The storage for the table entries.
+     * @param entry_count The number of entries. Must be a power of two, at
+     *                    least 4 and at most TAG_DEDUP_MAX_ENTRIES.
+     * @param max_age_us  Entries not read for this long are evicted. If 0,
+     *                    entries are only evicted to make room for new tags.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the table was initialized.
+     * @retval Ex10SdkErrorNullPointer   entries is NULL.
+     * @retval Ex10SdkErrorBadParamLength entry_count is not supported.
+     */
+    struct Ex10Result (*init)(struct Ex10TagDedupEntry* entries,
+                              size_t                    entry_count,
+                              uint64_t                  max_age_us);
+
+    /// Remove all entries and clear the statistics.
+    void (*clear)(void);
+
+    /**
+     * Record a tag read, adding the tag to the table if it is not held.
+     *
+     * @param read        The tag read to record.
+     * @param [out] is_new If not NULL, set true if the read added the tag.
+     *
+     * @return The entry of the tag, or NULL if the read was not recorded.
+     *         The pointer is only valid until the next call which changes
+     *         the table.
+     */
+    struct Ex10TagDedupEntry const* (*record_read)(
+        struct Ex10TagDedupRead const* read,
+        bool*                          is_new);
+
+    /**
+     * Find the entry of a tag.
+     *
+     * @param pc         The tag's Protocol-Control word.
+     * @param epc        The EPC bytes, not including the PC.
+     * @param epc_length The number of bytes pointed to by epc.
+     *
+     * @return The entry of the tag, or NULL if the tag is not held.
+     */
+    struct Ex10TagDedupEntry const* (*find)(uint16_t       pc,
+                                            uint8_t const* epc,
+                                            size_t         epc_length);
+
+    /// Returns the number of tags currently held in the table.
+    size_t (*get_unique_count)(void);
+
+    /// Returns the number of tags held which have been read more than once.
+    size_t (*get_multi_read_count)(void);
+
+    /**
+     * Returns the mean compensated RSSI of the reads of an entry.
+     *
+     * @param entry The entry to average.
+     */
+    int16_t (*get_mean_rssi_cdbm)(struct Ex10TagDedupEntry const* entry);
+
+    /**
+     * Call a function for each entry, from the most to the least recently
+     * read. The table must not be changed from within the callback.
+     *
+     * @param callback The function to call.
+     * @param context  Passed to each callback call.
+     *
+     * @return size_t The number of entries visited.
+     */
+    size_t (*iterate)(tag_dedup_entry_callback_t callback, void* context);
+
+    /**
+     * Copy the entries, from the most to the least recently read.
+     *
+     * @param [out] entries The array to copy the entries into.
+     * @param max_entries   The number of entries the array can hold.
+     *
+     * @return size_t The number of entries copied.
+     */
+    size_t (*snapshot)(struct Ex10TagDedupEntry* entries, size_t max_entries);
+
+    /**
+     * Evict the entries which have not been read within an age.
+     *
+     * @param now_us The 64-bit extended timestamp to measure the age from.
+     * @param age_us Entries last read more than this long before now_us are
+     *               evicted.
+     *
+     * @return size_t The number of entries evicted.
+     */
+    size_t (*evict_older_than)(uint64_t now_us, uint64_t age_us);
+
+    /**
+     * Copy the table statistics.
+     *
+     * @param stats The structure to fill in.
+     */
+    void (*get_stats)(struct Ex10TagDedupStats* stats);
+};
+
+struct Ex10TagDedupTable const* get_ex10_tag_dedup_table(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,184 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2020 - 2024 Impinj, Inc. All rights reserved.               *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/channel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file ex10_tag_report_stream.h
+ * A compact binary stream of tag reports. Each record starts with a one
+ * byte record type and a one byte record length, which counts the whole
+ * record. Multi-byte fields are little endian.
+ *
+ * TagReportRecordChannel, 8 bytes, written before the first tag report on
+ * a channel index:
+ *   [0]  record type      [2]  u16 channel index
+ *   [1]  record length    [4]  u32 channel frequency in kHz
+ *
+ * TagReportRecordTagRead, TAG_REPORT_TAG_READ_HEADER_LENGTH bytes followed
+ * by the ID and TID bytes:
+ *   [0]  record type      [12] u16 phase end
+ *   [1]  record length    [14] u16 channel index
+ *   [2]  u32 us_counter   [16] u8  antenna
+ *   [6]  u16 RF mode      [17] u8  target, as an ASCII character
+ *   [8]  i16 RSSI (cdBm)  [18] u8  packet type
+ *   [10] u16 phase start  [19] u8  reported EPC length in bytes
+ *   [20] u8  flags        [21] u8  ID length, then the ID bytes, then
+ *        a u8 TID length, then the TID bytes.
+ *
+ * Records of an unknown type can be skipped using their length.
+ */
+
+/**
+ * The prefix of the log lines which carry the stream as hex digits when
+ * it is written to a text console, as read by toi-process/tag_report_decode.
+ */
+#define TAG_REPORT_LOG_PREFIX "TR:"
+
+/// The tag report record types.
+enum TagReportRecordType
+{
+    TagReportRecordChannel = 0x01,
+    TagReportRecordTagRead = 0x02,
+};
+
+/// The length of a TagReportRecordChannel record.
+#define TAG_REPORT_CHANNEL_RECORD_LENGTH ((size_t)8u)
+
+/// The length of a TagReportRecordTagRead record before its ID bytes.
+#define TAG_REPORT_TAG_READ_HEADER_LENGTH ((size_t)22u)
+
+/// The longest ID stored in a TagReportRecordTagRead record.
+#define TAG_REPORT_ID_MAX_LENGTH ((size_t)0x44u)
+
+/// The longest TID stored in a TagReportRecordTagRead record.
+#define TAG_REPORT_TID_MAX_LENGTH ((size_t)32u)
+
+/// TagReportRecordTagRead flag: the ID is a Gen2X nickname, not an EPC.
+#define TAG_REPORT_FLAG_NICKNAME ((uint8_t)0x01u)
+
+/**
+ * @struct Ex10TagReport
+ * The fields of a tag read written to the stream.
+ */
+struct Ex10TagReport
+{
+    uint32_t        us_counter;
+    uint16_t        rf_mode;
+    int16_t         rssi_cdbm;
+    uint16_t        phase_begin;
+    uint16_t        phase_end;
+    channel_index_t channel_index;
+    /// Written as a TagReportRecordChannel record when first used.
+    uint32_t channel_frequency_khz;
+    uint8_t  antenna;
+    char     target;
+    uint8_t  packet_type;
+    /// The EPC length reported in the CSV output, in bytes.
+    uint8_t epc_length;
+    /// TAG_REPORT_FLAG_ values.
+    uint8_t flags;
+    /// The EPC, or nickname, bytes. Truncated to TAG_REPORT_ID_MAX_LENGTH.
+    uint8_t const* id;
+    size_t         id_length;
+    /// The TID bytes, if read. Truncated to TAG_REPORT_TID_MAX_LENGTH.
+    uint8_t const* tid;
+    size_t         tid_length;
+};
+
+/**
+ * The function which moves stream bytes to the output, such as a log,
+ * UART or RTT channel.
+ *
+ * @param data   The bytes to output.
+ * @param length The number of bytes to output.
+ *
+ * @return size_t The number of bytes taken. Bytes not taken remain in the
+ *                ring buffer and are offered again on the next flush.
+ */
+typedef size_t (*tag_report_sink_t)(void const* data, size_t length);
+
+/**
+ * @struct Ex10TagReportStats
+ * Counters describing the use of the stream since init().
+ */
+struct Ex10TagReportStats
+{
+    /// TagReportRecordTagRead records written to the ring buffer.
+    uint32_t tag_reads;
+    /// Tag reads dropped because the ring buffer was full after a flush.
+    uint32_t dropped;
+    /// The number of sink calls.
+    uint32_t sink_calls;
+    /// The number of bytes taken by the sink.
+    uint32_t sink_bytes;
+};
+
+/**
+ * @struct Ex10TagReportStream
+ * Encodes tag reads into a caller provided ring buffer. The buffer is
+ * passed to the sink when a record does not fit, and when flush() is
+ * called.
+ *
+ * @note The stream is not thread safe; write and flush from one thread.
+ */
+struct Ex10TagReportStream
+{
+    /**
+     * Initialize the stream, discarding any buffered bytes.
+     *
+     * @param buffer      The ring buffer storage.
+     * @param buffer_size The number of bytes in buffer.
+     * @param sink        The function to which buffered bytes are passed.
+     */
+    void (*init)(uint8_t* buffer, size_t buffer_size, tag_report_sink_t sink);
+
+    /**
+     * Encode a tag read into the ring buffer, flushing first if there is
+     * not enough room.
+     *
+     * @param report The tag read to write.
+     *
+     * @return bool true if the record was written, false if it was dropped.
+     */
+    bool (*write_tag_read)(struct Ex10TagReport const* report);
+
+    /**
+     * Pass the buffered bytes to the sink.
+     *
+     * @return size_t The number of bytes still buffered.
+     */
+    size_t (*flush)(void);
+
+    /**
+     * Copy the stream statistics.
+     *
+     * @param stats The structure to fill in.
+     */
+    void (*get_stats)(struct Ex10TagReportStats* stats);
+};
+
+struct Ex10TagReportStream const* get_ex10_tag_report_stream(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,6 +14,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "ex10_api/byte_span.h"
 #include "ex10_api/list_node.h"
@@ -22,6 +23,64 @@
 extern "C" {
 #endif
 
+struct EventFifoPacket;
+
+/**
+ * The smallest EventFifo packet, a struct PacketHeader with no payload, in
+ * bytes. A FifoBufferNode packet index sized to the node's data length
+ * divided by this can hold every packet the node contains.
+ */
+#define FIFO_PACKET_MIN_SIZE ((size_t)8u)
+
+/**
+ * @struct FifoPacketIndexEntry
+ * The location of one validated EventFifo packet within
+ * FifoBufferNode.fifo_data.
+ */
+struct FifoPacketIndexEntry
+{
+    /// The byte offset of the packet header from fifo_data.data.
+    uint16_t offset;
+    /// The EventPacketType of the packet.
+    uint8_t packet_type;
+    /// The length of the static packet data in bytes.
+    uint8_t static_data_length;
+};
+
+/**
+ * The arena bytes used by a buffer of data_length bytes allocated with
+ * free_list_get_sized(): a 32-bit word for the ReadFifo response code, the
+ * data rounded up to 32-bits, and a packet index of one FifoPacketIndexEntry
+ * per FIFO_PACKET_MIN_SIZE bytes of data.
+ */
+#define FIFO_ARENA_SLAB_SIZE(data_length)                                 \
+    (sizeof(uint32_t) + (((data_length) + 3u) / 4u) * 4u +                \
+     (((data_length) + 3u) / 4u) * 4u / FIFO_PACKET_MIN_SIZE *            \
+         sizeof(struct FifoPacketIndexEntry))
+
+/**
+ * @struct FifoPacketIndex
+ * The packets located by the first parsing pass over a FifoBufferNode.
+ * The entries are contiguous from the start of fifo_data and cover the first
+ * indexed_length bytes; any remaining bytes have not been validated.
+ *
+ * The entries are stored with the node's buffer: after the EventFifo data of
+ * an arena slab, or at the end of a fixed size buffer with room beyond
+ * EX10_EVENT_FIFO_SIZE. Nodes without this space have a capacity of zero,
+ * and the consumer parses all of their packets.
+ */
+struct FifoPacketIndex
+{
+    /// The number of valid entries.
+    size_t count;
+    /// The number of fifo_data bytes covered by the entries.
+    size_t indexed_length;
+    /// The number of entries available.
+    size_t capacity;
+    /// The indexed packets, in EventFifo order.
+    struct FifoPacketIndexEntry* entries;
+};
+
 /**
  * @struct FifoBufferNode
  * Used for reading EventFifo data using the ReadFifo command and for passing
@@ -52,11 +111,28 @@ struct FifoBufferNode
      *
      * raw_buffer->length represents the number of bytes allocated by the
      * backing store for reading EventFifo data using the ReadFifo command.
-     * This value must always be >= EX10_EVENT_FIFO_SIZE for the parsing
-     * of EventFifo data to work properly.
+     * For fixed size buffers this value must always be >= EX10_EVENT_FIFO_SIZE
+     * for the parsing of EventFifo data to work properly. Buffers allocated
+     * from an arena are sized to the requested length when allocated, and
+     * these fields are only valid while the node is allocated.
      */
     struct ByteSpan raw_buffer;
 
+    /**
+     * The index of packets within fifo_data. It is cleared when the node is
+     * released to a free list and optionally filled by the fifo data handler
+     * on the IRQ_N thread so that the EventFifo queue does not need to
+     * parse the indexed packets a second time.
+     */
+    struct FifoPacketIndex packet_index;
+
+    /**
+     * The Ex10TimeHelpers time_now_us() value taken when the IRQ_N
+     * interrupt which read this node was handled, or zero if unknown.
+     * It is used to measure the latency of the EventFifo pipeline.
+     */
+    uint32_t irq_time_us;
+
     /// The list node which is used for list insertion operations.
     struct Ex10ListNode list_node;
 };
@@ -96,6 +172,28 @@ struct FifoBufferList
                               struct ByteSpan const* byte_arrays,
                               size_t                 buffer_count);
 
+    /**
+     * Initialize the list to allocate variable sized buffers from a single
+     * arena, in place of the fixed size buffers passed to init(). Buffers
+     * are allocated with free_list_get_sized() and are returned to the arena
+     * in allocation order, so the number of buffers in flight is limited by
+     * the number of bytes held rather than by the buffer count.
+     *
+     * @param fifo_buffer_nodes The FifoBufferNode descriptors to use; these
+     *                          limit the number of buffers allocated at once.
+     * @param node_count        The number of fifo_buffer_nodes, at most 32.
+     * @param arena             The memory from which buffers are allocated.
+     *                          It must hold at least
+     *                          FIFO_ARENA_SLAB_SIZE(EX10_EVENT_FIFO_SIZE)
+     *                          bytes.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*init_arena)(struct FifoBufferNode* fifo_buffer_nodes,
+                                    size_t                 node_count,
+                                    struct ByteSpan const* arena);
+
     /**
      * Add a FifoBufferNode to the free list. Once all ReadFifo events have been
      * read from a the FifoBufferNode struct release the node to the free list
@@ -118,6 +216,19 @@ struct FifoBufferList
      */
     struct FifoBufferNode* (*free_list_get)(void);
 
+    /**
+     * Get a FifoBufferNode able to hold at least length bytes of ReadFifo
+     * data. When the list was initialized with init_arena() the buffer is
+     * sized to length; otherwise this is the same as free_list_get() and the
+     * caller must check raw_buffer.length.
+     *
+     * @param length The number of bytes the buffer must hold.
+     *
+     * @return struct FifoBufferNode* The allocated node.
+     * @retval NULL   If no node or arena space is available.
+     */
+    struct FifoBufferNode* (*free_list_get_sized)(size_t length);
+
     /**
      * @return size_t The number of FifoBufferNode elements contained in the
      * list.
@@ -145,6 +256,24 @@ struct FifoBufferList const* get_ex10_result_buffer_list(void);
  */
 bool ex10_release_buffer_node(struct FifoBufferNode* fifo_buffer_node);
 
+/**
+ * Record a parsed EventFifo packet in the FifoBufferNode packet index.
+ * Packets must be appended in the order they were parsed, starting at
+ * fifo_data offset zero. The packet is not recorded if it is invalid, if it
+ * does not immediately follow the last indexed packet, or if the index is
+ * full; in these cases the packet and those following it are left for the
+ * consumer to parse.
+ *
+ * @param fifo_buffer_node The node containing the packet.
+ * @param packet           The packet returned from parse_event_packet().
+ * @param packet_offset    The byte offset of the packet within fifo_data.
+ *
+ * @return bool true if the packet was recorded in the index.
+ */
+bool fifo_packet_index_append(struct FifoBufferNode*        fifo_buffer_node,
+                              struct EventFifoPacket const* packet,
+                              size_t                        packet_offset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,12 +14,54 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * The method used to wait for the Ex10 READY_N line to assert low.
+ */
+enum ReadyNWaitMode
+{
+    /// Poll the READY_N line until it asserts. Lowest latency, but the
+    /// calling thread holds the CPU for the duration of the wait.
+    ReadyNWaitSpin = 0,
+    /// Poll the READY_N line for an adaptive interval, then block on the
+    /// READY_N edge interrupt, yielding the CPU to other threads.
+    ReadyNWaitInterrupt,
+};
+
+/**
+ * The number of bins in the ReadyNWaitStats.wait_histogram.
+ * Bin 0 counts waits shorter than 1 us, bin n counts waits of
+ * [2^(n-1), 2^n) us, and the last bin also counts all longer waits.
+ */
+#define READY_N_WAIT_HISTOGRAM_BINS ((size_t)18u)
+
+/**
+ * @struct ReadyNWaitStats
+ * Accumulated READY_N wait timing, as reported by the GPIO driver.
+ */
+struct ReadyNWaitStats
+{
+    uint32_t wait_count;           ///< The total number of waits.
+    uint32_t spin_complete_count;  ///< Waits where READY_N asserted while
+                                   ///< polling.
+    uint32_t block_count;          ///< Waits that blocked on the interrupt.
+    uint32_t timeout_count;        ///< Waits that timed out.
+    uint32_t last_wait_us;         ///< The duration of the most recent wait.
+    uint32_t max_wait_us;          ///< The longest wait duration.
+    uint32_t spin_budget_us;       ///< The current adaptive polling interval.
+    uint64_t total_wait_us;        ///< The sum of all wait durations.
+    uint64_t total_blocked_us;     ///< The time spent blocked on the
+                                   ///< interrupt; CPU time given back.
+    /// Wait counts binned by duration, @see READY_N_WAIT_HISTOGRAM_BINS.
+    uint32_t wait_histogram[READY_N_WAIT_HISTOGRAM_BINS];
+};
+
 /**
  * @struct Ex10GpioInterface
  * This interface is a pass-through to the Ex10GpioDriver interface.
@@ -43,6 +85,7 @@ struct Ex10GpioInterface
 
     void (*irq_monitor_callback_enable)(bool enable);
     bool (*irq_monitor_callback_is_enabled)(void);
+    void (*set_irq_tick_callback)(void (*cb_func)(void), uint32_t period_ms);
 
     void (*irq_enable)(bool);
     bool (*thread_is_irq_monitor)(void);
@@ -55,7 +98,12 @@ struct Ex10GpioInterface
     int32_t (*release_ready_n)(void);
 
     int32_t (*busy_wait_ready_n)(uint32_t ready_n_timeout_ms);
+    int32_t (*wait_ready_n)(uint32_t            ready_n_timeout_ms,
+                            enum ReadyNWaitMode wait_mode);
     int32_t (*ready_n_pin_get)(void);
+
+    void (*get_ready_n_wait_stats)(struct ReadyNWaitStats* stats);
+    void (*reset_ready_n_wait_stats)(void);
 };
 
 #ifdef __cplusplus
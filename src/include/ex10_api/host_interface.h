@@ -80,6 +80,71 @@ struct HostInterface
      * @retval -1 The host serial interface hardware faulted.
      */
     int32_t (*write)(const void* data, size_t length);
+
+    /**
+     * Start receiving a byte stream from the Ex10 device without waiting
+     * for it to complete. The data buffer must remain valid until
+     * wait_async() returns. Only one asynchronous transfer may be
+     * outstanding; starting another first completes the previous one.
+     * The transfer is framed by CS on its own: CS is released as soon as
+     * the transfer completes, so the Ex10 acts on a command before
+     * wait_async() is called. May be NULL if the host interface does not
+     * support asynchronous transfers.
+     *
+     * @param data   A pointer to the buffer which will be filled in by the
+     *               byte stream received from the Ex10.
+     * @param length The length of the data buffer in bytes.
+     *
+     * @return int32_t A indicator of success or failure.
+     * @retval  0 The transfer was started.
+     * @retval -1 The host serial interface hardware faulted.
+     */
+    int32_t (*read_async)(void* data, size_t length);
+
+    /**
+     * Start sending a byte stream to the Ex10 device without waiting for
+     * it to complete. The same rules apply as for read_async().
+     *
+     * @param data   A pointer to the byte stream to send to the Ex10.
+     * @param length The number of bytes in the stream to send.
+     *
+     * @return int32_t A indicator of success or failure.
+     * @retval  0 The transfer was started.
+     * @retval -1 The host serial interface hardware faulted.
+     */
+    int32_t (*write_async)(const void* data, size_t length);
+
+    /**
+     * Wait for the outstanding asynchronous transfer to complete.
+     *
+     * @return The number of bytes transferred by the outstanding transfer,
+     *         or zero if there was none.
+     * @retval -1 The host serial interface hardware faulted.
+     */
+    int32_t (*wait_async)(void);
+
+    /**
+     * The number of CS framed transfers started since the program started.
+     * The count wraps around; take the unsigned difference of two values to
+     * get the transfers made in between. May be NULL if the host interface
+     * does not count its transfers.
+     *
+     * @return uint32_t The number of transfers started.
+     */
+    uint32_t (*get_transfer_count)(void);
+
+    /**
+     * The clock speeds at which the host interface runs the bus, limited to
+     * the speeds the board supports. A speed passed to open() which is not
+     * in this list is rounded or capped by the host interface. May be NULL
+     * if the host interface runs the bus at any requested speed.
+     *
+     * @param clock_rates_hz Set to the clock speeds in Hz, in ascending
+     *                       order.
+     *
+     * @return size_t The number of entries in clock_rates_hz.
+     */
+    size_t (*get_clock_rates)(uint32_t const** clock_rates_hz);
 };
 
 #ifdef __cplusplus
@@ -71,6 +71,32 @@ struct Ex10ActivitySequenceUseCase
         void (*packet_subscriber_callback)(struct EventFifoPacket const*,
                                            struct Ex10Result*));
 
+    /**
+     * Register a callback which receives the published packets in batches,
+     * in place of the packet_subscriber_callback. Each call passes the
+     * already parsed packets at the front of the EventFifo queue; a batch
+     * holds at most EVENT_FIFO_PACKET_BATCH_SIZE packets and never spans two
+     * EventFifo buffers. The packet filter set by enable_packet_filter()
+     * applies as it does to the packet_subscriber_callback; a batch in which
+     * no packet is published is not delivered.
+     * The subscriber may stop the sequence by setting an error in the
+     * Ex10Result; an Ex10ResultPacket ends the batch before it and stops
+     * the sequence.
+     *
+     * @note This function must be called before calling
+     *       run_activity_sequence(). Pass NULL to return to per packet
+     *       delivery.
+     *
+     * @param packet_batch_subscriber_callback
+     * A pointer to a function called with a pointer to the first packet of
+     * the batch, the number of packets and the Ex10Result. The packets are
+     * only valid for the duration of the call.
+     */
+    void (*register_packet_batch_subscriber_callback)(
+        void (*packet_batch_subscriber_callback)(struct EventFifoPacket const*,
+                                                 size_t,
+                                                 struct Ex10Result*));
+
     /**
      * Registers a callback to take place before each activity in the activty
      * sequence. This allows for special actions to prepare for activities as
@@ -110,12 +136,14 @@ struct Ex10ActivitySequenceUseCase
                                        struct Ex10Result*));
 
     /**
-     * By default only the TagRead and InventoryRoundSummary packet types are
-     * sent to the packet subscriber.
+     * By default only the TagRead, TagReadExtended and InventoryRoundSummary
+     * packet types are sent to the packet subscriber, or to the batch
+     * subscriber.
      *
      * @param enable_filter If set to false, all packets will be sent to the
      * packet subscriber. If true, the normal behavior of only sending the
-     * TagRead and InventoryRoundSummary packets to the subscriber is enforced.
+     * TagRead, TagReadExtended and InventoryRoundSummary packets to the
+     * subscriber is enforced.
      */
     void (*enable_packet_filter)(bool enable_filter);
 
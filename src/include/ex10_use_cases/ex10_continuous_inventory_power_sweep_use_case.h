@@ -75,12 +75,39 @@ struct Ex10ContinuousInventoryPowerSweepUseCase
                                            struct Ex10Result*));
 
     /**
-     * By default only the TagRead and InventoryRoundSummary packet types are
-     * sent to the packet subscriber.
+     * Register a callback which receives the published packets in batches,
+     * in place of the packet_subscriber_callback. Each call passes the
+     * already parsed packets at the front of the EventFifo queue; a batch
+     * holds at most EVENT_FIFO_PACKET_BATCH_SIZE packets and never spans two
+     * EventFifo buffers. The packet filter set by enable_packet_filter()
+     * applies as it does to the packet_subscriber_callback; a batch in which
+     * no packet is published is not delivered.
+     * The subscriber may stop the inventory by setting an error in the
+     * Ex10Result.
+     *
+     * @note This function must be called before calling
+     *       continuous_inventory(). Pass NULL to return to per packet delivery.
+     *
+     * @param packet_batch_subscriber_callback
+     * A pointer to a function called with a pointer to the first packet of
+     * the batch, the number of packets and the Ex10Result. The packets are
+     * only valid for the duration of the call.
+     */
+    void (*register_packet_batch_subscriber_callback)(
+        void (*packet_batch_subscriber_callback)(struct EventFifoPacket const*,
+                                                 size_t,
+                                                 struct Ex10Result*));
+
+    /**
+     * By default only the TagRead, TagReadExtended,
+     * ContinuousInventorySummary and Gen2Transaction packet types are sent to
+     * the packet subscriber, or to the batch subscriber.
      *
      * @param enable_filter If set to false, all packets will be sent to the
      * packet subscriber. If true, the normal behavior of only sending the
-     * TagRead and InventoryRoundSummary packets to the subscriber is enforced.
+     * packet types above to the subscriber is enforced.
+     * While the filter is enabled, unwanted packets are skipped by the event
+     * parser from their headers alone, without being parsed.
      */
     void (*enable_packet_filter)(bool enable_filter);
 
@@ -111,6 +138,18 @@ struct Ex10ContinuousInventoryPowerSweepUseCase
      */
     void (*enable_abort_on_fail)(bool enable);
 
+    /**
+     * By default the EventFifo threshold is fixed at
+     * DEFAULT_EVENT_FIFO_THRESHOLD. When enabled, each continuous_inventory()
+     * call runs the adaptive EventFifo threshold controller with the SDK
+     * default limits, and DEFAULT_EVENT_FIFO_THRESHOLD is restored when the
+     * inventory ends. The init() function disables it.
+     * @see Ex10Protocol.enable_adaptive_event_fifo_threshold()
+     *
+     * @param enable If true, adapt the EventFifo threshold to the tag rate.
+     */
+    void (*enable_adaptive_event_fifo_threshold)(bool enable);
+
     /**
      * Return the reason that continuous inventory stopped.
      * @return The StopReason.
@@ -67,6 +67,30 @@ struct Ex10ContinuousInventoryStartUseCase
         void (*packet_subscriber_callback)(struct EventFifoPacket const*,
                                            struct Ex10Result*));
 
+    /**
+     * Register a callback which receives the published packets in batches,
+     * in place of the packet_subscriber_callback. Each call passes the
+     * already parsed packets at the front of the EventFifo queue; a batch
+     * holds at most EVENT_FIFO_PACKET_BATCH_SIZE packets and never spans two
+     * EventFifo buffers. Packets removed by the packet filter are skipped by
+     * the event parser, but packets which end or report on the inventory
+     * are always included.
+     * The subscriber may stop the inventory by setting an error in the
+     * Ex10Result.
+     *
+     * @note This function must be called before calling
+     *       continuous_inventory(). Pass NULL to return to per packet delivery.
+     *
+     * @param packet_batch_subscriber_callback
+     * A pointer to a function called with a pointer to the first packet of
+     * the batch, the number of packets and the Ex10Result. The packets are
+     * only valid for the duration of the call.
+     */
+    void (*register_packet_batch_subscriber_callback)(
+        void (*packet_batch_subscriber_callback)(struct EventFifoPacket const*,
+                                                 size_t,
+                                                 struct Ex10Result*));
+
     /**
      * By default only the TagRead and InventoryRoundSummary packet types are
      * sent to the packet subscriber.
@@ -74,6 +98,8 @@ struct Ex10ContinuousInventoryStartUseCase
      * @param enable_filter If set to false, all packets will be sent to the
      * packet subscriber. If true, the normal behavior of only sending the
      * TagRead and InventoryRoundSummary packets to the subscriber is enforced.
+     * While the filter is enabled, unwanted packets are skipped by the event
+     * parser from their headers alone, without being parsed.
      */
     void (*enable_packet_filter)(bool enable_filter);
 
@@ -0,0 +1,162 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/ex10_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The longest EPC, in bytes, held by a StoredCrcEpcEntryGen2X.
+#define STORED_CRC_EPC_MAX_LENGTH ((size_t)32u)
+
+/// The most table slots examined when looking up a StoredCRC.
+#define STORED_CRC_EPC_MAP_PROBE_LIMIT ((size_t)16u)
+
+/**
+ * @enum StoredCrcResolutionGen2X
+ * The result of resolving a StoredCRC to an EPC.
+ */
+enum StoredCrcResolutionGen2X
+{
+    /// The StoredCRC was not read in an unexpired full EPC round.
+    StoredCrcUnresolved = 0,
+    /// The StoredCRC belongs to a single known EPC.
+    StoredCrcResolved,
+    /**
+     * More than one EPC with this StoredCRC was read within the max age,
+     * or the EPC was too long to hold. The entry holds the latest EPC read.
+     */
+    StoredCrcAmbiguous,
+};
+
+/**
+ * @struct StoredCrcEpcEntryGen2X
+ * The EPC of a StoredCRC. The storage is provided by the caller of
+ * Ex10StoredCrcEpcMapGen2X.init().
+ */
+struct StoredCrcEpcEntryGen2X
+{
+    /// The round in which the StoredCRC was last added; 0 if never used.
+    uint32_t round_stamp;
+    /// The last round in which a second EPC was added; 0 if none.
+    uint32_t ambiguous_round;
+    /// The 16-bit StoredCRC value.
+    uint16_t stored_crc;
+    /// The tag's Protocol-Control word.
+    uint16_t pc;
+    /// The number of valid bytes in epc.
+    uint8_t epc_length;
+    /// The EPC bytes, not including the PC.
+    uint8_t epc[STORED_CRC_EPC_MAX_LENGTH];
+};
+
+/**
+ * @struct StoredCrcEpcMapGen2X
+ * Maps StoredCRC values to the EPCs read along with them in full EPC
+ * rounds, so that the StoredCRC only replies of fast inventory rounds can
+ * be reported as EPCs. Entries age by round as a StoredCrcSetGen2X does.
+ *
+ * @note The fields are managed by Ex10StoredCrcEpcMapGen2X.
+ */
+struct StoredCrcEpcMapGen2X
+{
+    struct StoredCrcEpcEntryGen2X* entries;
+    /// The number of entries; a power of two.
+    size_t entry_count;
+    /// The Fibonacci hashing shift which maps a StoredCRC to a slot.
+    uint8_t hash_shift;
+    /// The number of rounds an entry survives without being added.
+    uint32_t max_age_rounds;
+    /// The current round.
+    uint32_t round;
+    /// The number of entries evicted to make room for a new StoredCRC.
+    uint32_t evictions;
+};
+
+/**
+ * @struct Ex10StoredCrcEpcMapGen2X
+ * Operations on a StoredCrcEpcMapGen2X.
+ */
+struct Ex10StoredCrcEpcMapGen2X
+{
+    /**
+     * Initialize an empty map.
+     *
+     * @param map            The map to initialize.
+     * @param entries        The table storage.
+     * @param entry_count    The number of entries. Must be a power of two,
+     *                       from 2 to 65536.
+     * @param max_age_rounds The number of rounds started after an entry was
+     *                       last added before it expires.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the map was initialized.
+     * @retval Ex10SdkErrorNullPointer    map or entries is NULL.
+     * @retval Ex10SdkErrorBadParamLength entry_count is not supported.
+     */
+    struct Ex10Result (*init)(struct StoredCrcEpcMapGen2X*   map,
+                              struct StoredCrcEpcEntryGen2X* entries,
+                              size_t                         entry_count,
+                              uint32_t                       max_age_rounds);
+
+    /**
+     * Start a new round, aging all entries by one round.
+     *
+     * @param map The map to age.
+     */
+    void (*advance_round)(struct StoredCrcEpcMapGen2X* map);
+
+    /**
+     * Record the EPC read with a StoredCRC.
+     *
+     * @param map        The map to add to.
+     * @param stored_crc The StoredCRC value.
+     * @param pc         The tag's Protocol-Control word.
+     * @param epc        The EPC bytes, not including the PC.
+     * @param epc_length The number of bytes pointed to by epc.
+     */
+    void (*add)(struct StoredCrcEpcMapGen2X* map,
+                uint16_t                     stored_crc,
+                uint16_t                     pc,
+                uint8_t const*               epc,
+                size_t                       epc_length);
+
+    /**
+     * Resolve a StoredCRC to its EPC.
+     *
+     * @param map         The map to search.
+     * @param stored_crc  The StoredCRC value.
+     * @param [out] entry If not NULL, set to the entry of the StoredCRC, or
+     *                    NULL if it is unresolved. The pointer is valid until
+     *                    the map is next changed.
+     *
+     * @return enum StoredCrcResolutionGen2X The resolution.
+     */
+    enum StoredCrcResolutionGen2X (*resolve)(
+        struct StoredCrcEpcMapGen2X const*    map,
+        uint16_t                              stored_crc,
+        struct StoredCrcEpcEntryGen2X const** entry);
+};
+
+struct Ex10StoredCrcEpcMapGen2X const* get_ex10_stored_crc_epc_map_gen2x(void);
+
+#ifdef __cplusplus
+}
+#endif
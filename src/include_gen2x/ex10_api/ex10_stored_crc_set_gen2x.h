@@ -0,0 +1,137 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ex10_api/ex10_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The most table slots examined when looking up a StoredCRC.
+#define STORED_CRC_SET_PROBE_LIMIT ((size_t)16u)
+
+/**
+ * @struct StoredCrcSetEntryGen2X
+ * A StoredCRC table slot. The storage is provided by the caller of
+ * Ex10StoredCrcSetGen2X.init().
+ */
+struct StoredCrcSetEntryGen2X
+{
+    /// The round in which the StoredCRC was last inserted; 0 if never used.
+    uint32_t round_stamp;
+    /// The 16-bit StoredCRC value.
+    uint16_t stored_crc;
+};
+
+/**
+ * @struct StoredCrcSetGen2X
+ * A set of StoredCRC values whose members expire individually. Each member
+ * carries the round in which it was last inserted; it is a member until
+ * max_age_rounds rounds have been started after that round. Expired slots
+ * are reused by later inserts, so the set never needs to be cleared in
+ * bulk.
+ *
+ * The memory used is set by the number of entries passed to init(). Sizing
+ * the table to at least twice the tracked tag population keeps the
+ * lookups short; if a new StoredCRC finds no free slot within
+ * STORED_CRC_SET_PROBE_LIMIT slots, the least recently inserted member in
+ * that range is evicted.
+ *
+ * @note The fields are managed by Ex10StoredCrcSetGen2X.
+ */
+struct StoredCrcSetGen2X
+{
+    struct StoredCrcSetEntryGen2X* entries;
+    /// The number of entries; a power of two.
+    size_t entry_count;
+    /// The Fibonacci hashing shift which maps a StoredCRC to a slot.
+    uint8_t hash_shift;
+    /// The number of rounds a member survives without being inserted.
+    uint32_t max_age_rounds;
+    /// The current round.
+    uint32_t round;
+    /// Slots stamped before this round are expired by expire_all().
+    uint32_t valid_from_round;
+    /// The number of members evicted to make room for a new StoredCRC.
+    uint32_t evictions;
+};
+
+/**
+ * @struct Ex10StoredCrcSetGen2X
+ * Operations on a StoredCrcSetGen2X.
+ */
+struct Ex10StoredCrcSetGen2X
+{
+    /**
+     * Initialize an empty set.
+     *
+     * @param set            The set to initialize.
+     * @param entries        The table storage.
+     * @param entry_count    The number of entries. Must be a power of two,
+     *                       from 2 to 65536.
+     * @param max_age_rounds The number of rounds started after a member was
+     *                       last inserted before it expires. If 0, members
+     *                       only last until the next round is started.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the set was initialized.
+     * @retval Ex10SdkErrorNullPointer    set or entries is NULL.
+     * @retval Ex10SdkErrorBadParamLength entry_count is not supported.
+     */
+    struct Ex10Result (*init)(struct StoredCrcSetGen2X*      set,
+                              struct StoredCrcSetEntryGen2X* entries,
+                              size_t                         entry_count,
+                              uint32_t                       max_age_rounds);
+
+    /**
+     * Start a new round, aging all members by one round.
+     *
+     * @param set The set to age.
+     */
+    void (*advance_round)(struct StoredCrcSetGen2X* set);
+
+    /**
+     * Expire all members in constant time. The table is not written.
+     *
+     * @param set The set to empty.
+     */
+    void (*expire_all)(struct StoredCrcSetGen2X* set);
+
+    /**
+     * Add a StoredCRC, or renew it for the current round if it is a member.
+     *
+     * @param set        The set to add to.
+     * @param stored_crc The StoredCRC value.
+     */
+    void (*insert)(struct StoredCrcSetGen2X* set, uint16_t stored_crc);
+
+    /**
+     * Returns whether a StoredCRC is an unexpired member.
+     *
+     * @param set        The set to search.
+     * @param stored_crc The StoredCRC value.
+     */
+    bool (*contains)(struct StoredCrcSetGen2X const* set, uint16_t stored_crc);
+};
+
+struct Ex10StoredCrcSetGen2X const* get_ex10_stored_crc_set_gen2x(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -92,6 +92,32 @@ struct Ex10ContinuousInventoryUseCaseGen2X
         void (*packet_subscriber_callback)(struct EventFifoPacket const*,
                                            struct Ex10Result*));
 
+    /**
+     * Register a callback which observes the packets of the given types,
+     * whether or not the packet filter set by enable_packet_filter() sends
+     * them to the subscriber. Each observed packet is passed to the observer
+     * before it is passed to the packet or batch subscriber. The event parser
+     * does not skip the observed packet types while the filter is enabled.
+     *
+     * @note This function must be called before calling
+     *       continuous_inventory(). The init() function removes the observer.
+     *
+     * @param packet_observer_callback
+     * A pointer to a function called with each observed packet, or NULL to
+     * remove the observer. The packet is only valid for the duration of the
+     * call.
+     * @param packet_types The packet types to observe. They are copied.
+     * @param count        The number of packet_types, at most
+     *                     PACKET_OBSERVER_TYPES_MAX.
+     *
+     * @return struct Ex10Result
+     *         Indicates whether the function call passed or failed.
+     */
+    struct Ex10Result (*register_packet_observer_callback)(
+        void (*packet_observer_callback)(struct EventFifoPacket const*),
+        enum EventPacketType const* packet_types,
+        size_t                      count);
+
     /**
      * By default only the TagRead, TagReadExtended, and InventoryRoundSummary
      * packet types are sent to the packet subscriber.
@@ -145,6 +171,18 @@ struct Ex10ContinuousInventoryUseCaseGen2X
      */
     void (*enable_tag_read_extended_packet)(bool enable);
 
+    /**
+     * By default the EventFifo threshold is fixed at
+     * DEFAULT_EVENT_FIFO_THRESHOLD. When enabled, each continuous_inventory()
+     * call runs the adaptive EventFifo threshold controller with the SDK
+     * default limits, and DEFAULT_EVENT_FIFO_THRESHOLD is restored when the
+     * inventory ends. The init() function disables it.
+     * @see Ex10Protocol.enable_adaptive_event_fifo_threshold()
+     *
+     * @param enable If true, adapt the EventFifo threshold to the tag rate.
+     */
+    void (*enable_adaptive_event_fifo_threshold)(bool enable);
+
     /**
      * Used to return the reason that continuous inventory stopped.
      * @return The StopReason.
@@ -13,20 +13,20 @@
 
 #pragma once
 
-#include "ex10_api/bit_span.h"
-
 #include "include_gen2x/ex10_api/application_register_field_enums_gen2x.h"
 #include "include_gen2x/ex10_api/application_registers_gen2x.h"
 #include "include_gen2x/ex10_api/event_fifo_packet_types_gen2x.h"
+#include "include_gen2x/ex10_api/ex10_stored_crc_epc_map_gen2x.h"
+#include "include_gen2x/ex10_api/ex10_stored_crc_set_gen2x.h"
 #include "include_gen2x/ex10_api/rf_mode_definitions_gen2x.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// bitfield is for 64k bits each to represent
-// one of the 16-bit stored CRC values.
-#define SIZE_OF_BITFIELD (64 * 1024)
+// A suggested max age, in fast inventory rounds, for the new StoredCRC set.
+// A new tag must be read twice within this many rounds to be reported.
+#define FAST_TAG_TRACKING_NEW_CRC_MAX_AGE_ROUNDS ((uint32_t)10u)
 
 enum FastTagTrackingInvState
 {
@@ -51,24 +51,33 @@ struct Ex10FastTagTrackingStateChangeGen2X
  * inventory and they are generally passed on to the inventory module
  * to setup the inventory rounds.
  *
- * @param known_stored_crcs is a BitSpan struct that is assumed to be the size
- *                          SIZE_OF_BITFIELD allocated by the example
+ * @param known_stored_crcs is a StoredCrcSetGen2X initialized by the example
  *                          which is used by the use case for classifying
- *                          the tags read as known (not new) tags
+ *                          the tags read as known (not new) tags. Each full
+ *                          EPC round starts a new round of the set, so its
+ *                          max age is counted in full EPC rounds.
  * @param build_stored_crc  This is a bool that if set true the use case
- *                          will clear the known_stored_crc bitfield and
- *                          run a full EPC inventory round to build the
- *                          known list
- * @param new_stored_crc    is a BitSpan struct that is assumed to be the size
- *                          SIZE_OF_BITFIELD to keep track tags that were read
- *                          but NOT in the known_stored_crc bitfield.  This
- *                          is used to filter out phantom (noise) tag reads that
- *                          are not real.  (the assumption is that a real new
- *                          tag will be read at least twice)
+ *                          will age the known_stored_crc set and run a full
+ *                          EPC inventory round to refresh the known list
+ * @param new_stored_crc    is a StoredCrcSetGen2X to keep track tags that
+ *                          were read but NOT in the known_stored_crc set.
+ *                          This is used to filter out phantom (noise) tag
+ *                          reads that are not real.  (the assumption is that
+ *                          a real new tag will be read at least twice) Each
+ *                          fast inventory round starts a new round of the
+ *                          set, so phantoms expire individually after its
+ *                          max age; see
+ *                          FAST_TAG_TRACKING_NEW_CRC_MAX_AGE_ROUNDS.
  * @param clear_new_stored_crc is a bool that if set to true the use case
- *                          will clear the new_stored_crc field when starting
+ *                          will expire the new_stored_crc set when starting
  *                          the fast inventory round.. If false it will accept
  *                          any existing "new" tag flagged.
+ * @param stored_crc_epcs   is an optional StoredCrcEpcMapGen2X which is
+ *                          filled with the EPCs read in full EPC rounds, so
+ *                          that fast inventory StoredCRC replies can be
+ *                          resolved to EPCs with resolve_stored_crc(). Like
+ *                          known_stored_crcs, it ages by full EPC round.
+ *                          Set to NULL to disable EPC resolution.
  */
 struct Ex10FastTagTrackingUseCaseParametersGen2X
 {
@@ -79,10 +88,11 @@ struct Ex10FastTagTrackingUseCaseParametersGen2X
     uint8_t                      session;
     uint8_t                      select;
     struct StopConditions const* stop_conditions;
-    struct BitSpan               known_stored_crcs;
+    struct StoredCrcSetGen2X*    known_stored_crcs;
     bool                         build_stored_crcs;
-    struct BitSpan               new_stored_crcs;
+    struct StoredCrcSetGen2X*    new_stored_crcs;
     bool                         clear_new_stored_crcs;
+    struct StoredCrcEpcMapGen2X* stored_crc_epcs;
 };
 
 /**
@@ -143,7 +153,7 @@ struct Ex10FastTagTrackingUseCaseGen2X
 
     /**
      * Force the fast tag tracking inventory to stop a fast inventory round and
-     * do a full EPC inventory round (and to rebuild the bitfields)
+     * do a full EPC inventory round (and to refresh the StoredCRC sets)
      */
     void (*force_full_round)(void);
 
@@ -154,9 +164,25 @@ struct Ex10FastTagTrackingUseCaseGen2X
     void (*stop_inventory)(void);
 
     /**
-     * A helper function that will clear a bitfield
+     * Resolve a StoredCRC to the EPC read with it in a full EPC round. This
+     * can be called from the packet subscriber callback to report the EPC
+     * of a fast inventory TagReadExtended packet, using the low 16 bits of
+     * its cr_value.
+     *
+     * @param stored_crc  The StoredCRC value.
+     * @param [out] entry If not NULL, set to the map entry holding the PC
+     *                    and EPC, or NULL if the StoredCRC is unresolved.
+     *
+     * @return enum StoredCrcResolutionGen2X
+     * @retval StoredCrcUnresolved No EPC is known for the StoredCRC, or no
+     *                             stored_crc_epcs map was passed.
+     * @retval StoredCrcResolved   entry holds the EPC of the tag.
+     * @retval StoredCrcAmbiguous  More than one EPC has this StoredCRC.
      */
-    void (*clear_bitfield)(struct BitSpan bit_span);
+    enum StoredCrcResolutionGen2X (*resolve_stored_crc)(
+        uint16_t                              stored_crc,
+        struct StoredCrcEpcEntryGen2X const** entry);
+
     /**
      * Run inventory rounds continuously until the specified
      * stop conditions are met.
@@ -33,9 +33,17 @@
 #include "src/ex10_utils/ex10_inventory_command_line_helper.h"
 #include "src/ex10_utils/ex10_use_case_example_errors.h"
 
+#include "board/driver_list.h"
 #include "ex10_api/board_init_core.h"
+#include "ex10_api/command_transactor.h"
 //#include "ex10_api/event_fifo_printer.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_boot_profiler.h"
+#include "ex10_api/ex10_event_fifo_queue.h"
+#include "ex10_api/ex10_macros.h"
+#include "ex10_api/ex10_register_cache.h"
+#include "ex10_api/ex10_tag_dedup_table.h"
+#include "ex10_api/ex10_tag_report_stream.h"
 #include "ex10_api/ex10_utils.h"
 #include "ex10_regulatory/ex10_default_region_names.h"
 #include "ex10_api/event_packet_parser.h"
@@ -52,10 +60,41 @@
 //#define OUTPUT_EVERYTHING
 enum Verbosity const verbose_gen2x = SILENCE;
 #define TOI_LOGS_ENABLED 0
+// Set to 1 to write the ToI logs as hex encoded binary tag reports instead
+// of CSV lines. Convert them back to CSV with toi-process/tag_report_decode.c.
+#define TOI_LOGS_BINARY 0
+
+// Keep a snapshot of the parsed calibration in MCU flash, so that boots
+// after the first restore it instead of reading it from the Ex10 again.
+// Set CONFIG_EX10_CALIBRATION_SNAPSHOT in prj.conf to enable.
+#define CALIBRATION_SNAPSHOT_ENABLED \
+    IS_ENABLED(CONFIG_EX10_CALIBRATION_SNAPSHOT)
+
+// Adapt the EventFifo threshold to the tag rate during the inventory.
+// Clear CONFIG_EX10_ADAPTIVE_EVENT_FIFO_THRESHOLD in prj.conf to disable.
+#define ADAPTIVE_EVENT_FIFO_THRESHOLD_ENABLED \
+    IS_ENABLED(CONFIG_EX10_ADAPTIVE_EVENT_FIFO_THRESHOLD)
+
+// Print the time and SPI transfers spent in each phase from the start of
+// board setup to the first tag read.
+#define BOOT_PROFILER_ENABLED 1
 
 // The number of microseconds per second.
 #define us_per_s 1000000u
 
+// The number of entries in the unique tag table; a power of two.
+#define TAG_DEDUP_TABLE_ENTRIES 256u
+
+static struct Ex10TagDedupEntry tag_dedup_entries[TAG_DEDUP_TABLE_ENTRIES];
+
+// The size of the binary tag report ring buffer.
+#define TAG_REPORT_BUFFER_SIZE 1024u
+
+// The number of tag report bytes hex encoded on each log line.
+#define TAG_REPORT_LOG_LINE_BYTES 48u
+
+static uint8_t tag_report_buffer[TAG_REPORT_BUFFER_SIZE];
+
 struct InventoryOptions inventory_options = {
     .region_name   = "FCC",
     .read_rate     = 0u,
@@ -87,6 +126,36 @@ static struct ContinuousInventorySummary continuous_inventory_summary = {
     .last_op_error              = 0,
     .packet_rfu_1               = 0};
 
+// The boot profiler phases which end on the first TxRampUp and TagRead.
+static bool first_ramp_pending = false;
+static bool first_tag_pending  = false;
+
+// The packets observed by the boot profiler. TxRampUp is not sent to the
+// packet subscriber when the packet filter is enabled.
+static enum EventPacketType const boot_profiler_packet_types[] = {
+    TxRampUp,
+    TagRead,
+};
+
+/* End the first ramp and first tag boot profiler phases */
+static void boot_profiler_packet_observer(struct EventFifoPacket const* packet)
+{
+    struct Ex10BootProfiler const* profiler = get_ex10_boot_profiler();
+    if (first_ramp_pending && packet->packet_type == TxRampUp)
+    {
+        first_ramp_pending = false;
+        profiler->end_phase();
+        first_tag_pending = true;
+        profiler->begin_phase("First tag");
+    }
+    else if (first_tag_pending && packet->packet_type == TagRead)
+    {
+        first_tag_pending = false;
+        profiler->end_phase();
+        profiler->stop();
+    }
+}
+
 
 /* Print the header for the logs output */
 static void print_logs_header(void)
@@ -112,6 +181,26 @@ static void print_logs_header(void)
                 "EpcLength(bytes),EPC,PhaseStart,PhaseEnd,RSSI(cdBm),MultiReadTimes\n");
 
 }
+
+/* The EPC length written to the logs for the configured Gen2X ID */
+static uint8_t get_logged_epc_length(struct EventFifoPacket const* packet)
+{
+    if (inventory_options.id == 0)
+    {
+        return 3;    // +0x <- 1-byte
+    }
+    else if (inventory_options.id == 1)
+    {
+        return 8;
+    }
+    else if (inventory_options.id == 2)
+    {
+        return 10;
+    }
+    // Exclude PC & CRC
+    return (uint8_t)(packet->dynamic_data_length - 2 - 2);
+}
+
 static void printf_tag_read(
     struct EventFifoPacket const* packet,
     enum RfModes                  rf_mode,
@@ -128,23 +217,7 @@ static void printf_tag_read(
         packet->static_data->tag_read.type,
         packet->static_data->tag_read.tid_offset);
     
-    uint8_t epc_byte_length = 0;
-    if (inventory_options.id == 0)
-    {
-        epc_byte_length = 3;    // +0x <- 1-byte
-    }
-    else if (inventory_options.id == 1)
-    {
-        epc_byte_length = 8;
-    }
-    else if (inventory_options.id == 2)
-    {
-        epc_byte_length = 10;
-    }
-    else
-    {
-        epc_byte_length = (packet->dynamic_data_length - 2 - 2); // Exclude PC & CRC
-    }
+    uint8_t const epc_byte_length = get_logged_epc_length(packet);
 
     // FW timestamp, Target, Antenna, reader mode, EPC or other ID, Phase start, Phase end, RSSI
     ex10_ex_printf("%u,%c,%u,%u,%u,T%u,%u,", 
@@ -193,6 +266,124 @@ static void printf_tag_read(
     ex10_ex_printf("\n");
 }
 
+/* Encode the hex line for each chunk of the tag report stream */
+static size_t tag_report_log_sink(void const* data, size_t length)
+{
+    static char const hex_digits[] = "0123456789ABCDEF";
+
+    uint8_t const* bytes  = (uint8_t const*)data;
+    size_t         offset = 0u;
+    while (offset < length)
+    {
+        char         line[2u * TAG_REPORT_LOG_LINE_BYTES + 1u];
+        size_t const count = (length - offset < TAG_REPORT_LOG_LINE_BYTES)
+                                 ? length - offset
+                                 : TAG_REPORT_LOG_LINE_BYTES;
+        for (size_t iter = 0u; iter < count; ++iter)
+        {
+            line[2u * iter]      = hex_digits[bytes[offset + iter] >> 4u];
+            line[2u * iter + 1u] = hex_digits[bytes[offset + iter] & 0x0Fu];
+        }
+        line[2u * count] = '\0';
+        ex10_ex_printf(TAG_REPORT_LOG_PREFIX "%s\n", line);
+        offset += count;
+    }
+    return length;
+}
+
+/* Write a tag read to the binary tag report stream */
+static void write_tag_report(
+    struct EventFifoPacket const* packet,
+    enum RfModes                  rf_mode,
+    uint8_t                       antenna,
+    uint8_t                       target,
+    uint32_t                      channel_freq_kHz,
+    enum RfFilter                 rf_filter,
+    uint16_t                      adc_temperature)
+{
+    struct TagReadFields const tag_read =
+        get_ex10_event_parser()->get_tag_read_fields(
+            packet->dynamic_data,
+            packet->dynamic_data_length,
+            packet->static_data->tag_read.type,
+            packet->static_data->tag_read.tid_offset);
+
+    int16_t const compensated_rssi_cdbm =
+        get_ex10_calibration()->get_compensated_rssi(
+            packet->static_data->tag_read.rssi,
+            (uint16_t)rf_mode,
+            (const struct RxGainControlFields*)&packet->static_data->tag_read
+                .rx_gain_settings,
+            antenna,
+            rf_filter,
+            adc_temperature);
+
+    // For Nickname reads, the nickname will show up in the PC word
+    bool const     nickname = (packet->static_data->tag_read.type == 4);
+    uint8_t const* id =
+        nickname ? (uint8_t const*)tag_read.pc : tag_read.epc;
+    size_t const id_length =
+        nickname ? sizeof(*tag_read.pc) : tag_read.epc_length;
+
+    struct Ex10TagReport const report = {
+        .us_counter  = packet->us_counter,
+        .rf_mode     = (uint16_t)rf_mode,
+        .rssi_cdbm   = compensated_rssi_cdbm,
+        .phase_begin = packet->static_data->tag_read.rf_phase_begin,
+        .phase_end   = packet->static_data->tag_read.rf_phase_end,
+        .channel_index =
+            get_ex10_active_region()->get_channel_index(channel_freq_kHz),
+        .channel_frequency_khz = channel_freq_kHz,
+        .antenna               = antenna,
+        .target                = (char)target,
+        .packet_type           = (uint8_t)packet->packet_type,
+        .epc_length            = get_logged_epc_length(packet),
+        .flags                 = nickname ? TAG_REPORT_FLAG_NICKNAME : 0u,
+        .id                    = id,
+        .id_length             = id_length,
+        .tid                   = tag_read.tid,
+        .tid_length            = tag_read.tid_length,
+    };
+    get_ex10_tag_report_stream()->write_tag_read(&report);
+}
+
+/* Count the tag in the unique tag table */
+static void record_unique_tag(struct EventFifoPacket const* packet)
+{
+    struct TagReadFields const tag_read =
+        get_ex10_event_parser()->get_tag_read_fields(
+            packet->dynamic_data,
+            packet->dynamic_data_length,
+            packet->static_data->tag_read.type,
+            packet->static_data->tag_read.tid_offset);
+    if (tag_read.pc == NULL)
+    {
+        return;
+    }
+
+    int16_t const compensated_rssi_cdbm =
+        get_ex10_calibration()->get_compensated_rssi(
+            packet->static_data->tag_read.rssi,
+            (uint16_t)inventory_options.mode.rf_mode_id,
+            (const struct RxGainControlFields*)&packet->static_data->tag_read
+                .rx_gain_settings,
+            inventory_options.antenna,
+            get_ex10_active_region()->get_rf_filter(),
+            get_ex10_ramp_module_manager()->retrieve_adc_temperature());
+
+    struct Ex10TagDedupRead const read = {
+        .pc            = ex10_swap_bytes(*tag_read.pc),
+        .epc           = tag_read.epc,
+        .epc_length    = tag_read.epc_length,
+        .us_counter    = packet->us_counter,
+        .timestamp_us  = packet->timestamp_us,
+        .rssi_cdbm     = compensated_rssi_cdbm,
+        .antenna       = inventory_options.antenna,
+        .channel_index = get_ex10_active_region()->get_active_channel_index(),
+    };
+    get_ex10_tag_dedup_table()->record_read(&read, NULL);
+}
+
 static void packet_subscriber_callback(struct EventFifoPacket const* packet,
                                        struct Ex10Result*            result_ptr)
 {
@@ -216,6 +407,10 @@ static void packet_subscriber_callback(struct EventFifoPacket const* packet,
         continuous_inventory_summary =
             packet->static_data->continuous_inventory_summary;
     }
+    else if (packet->packet_type == TagRead)
+    {
+        record_unique_tag(packet);
+    }
     // Generate logs for ToI process
     if ((TOI_LOGS_ENABLED) && (packet->packet_type == TagRead))
     {
@@ -228,13 +423,27 @@ static void packet_subscriber_callback(struct EventFifoPacket const* packet,
         uint32_t channel_freq_kHz = get_ex10_active_region()->get_active_channel_khz();
 
         // BUG: Prints the FW timer packet time, not the time since start of inventory
-        printf_tag_read(packet,
-                         reader_mode,
-                         antenna,
-                         target,
-                         channel_freq_kHz,
-                         get_ex10_active_region()->get_rf_filter(),
-                         get_ex10_ramp_module_manager()->retrieve_adc_temperature());
+        if (TOI_LOGS_BINARY)
+        {
+            write_tag_report(
+                packet,
+                reader_mode,
+                antenna,
+                target,
+                channel_freq_kHz,
+                get_ex10_active_region()->get_rf_filter(),
+                get_ex10_ramp_module_manager()->retrieve_adc_temperature());
+        }
+        else
+        {
+            printf_tag_read(packet,
+                             reader_mode,
+                             antenna,
+                             target,
+                             channel_freq_kHz,
+                             get_ex10_active_region()->get_rf_filter(),
+                             get_ex10_ramp_module_manager()->retrieve_adc_temperature());
+        }
     }
 
 }
@@ -246,12 +455,36 @@ static struct Ex10Result gen2x_continuous_inventory_example(void)
 
     struct Ex10ContinuousInventoryUseCaseGen2X const* ciucg =
         get_ex10_continuous_inventory_use_case_gen2x();
+    struct Ex10BootProfiler const* profiler = get_ex10_boot_profiler();
 
+    profiler->begin_phase("Use case init");
     ciucg->init();
+    profiler->end_phase();
     // Clear out any left over packets
     // ex10_discard_packets(false, true, false);
     ciucg->register_packet_subscriber_callback(packet_subscriber_callback);
+    struct Ex10Result ex10_result = ciucg->register_packet_observer_callback(
+        boot_profiler_packet_observer,
+        boot_profiler_packet_types,
+        ARRAY_SIZE(boot_profiler_packet_types));
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
     ciucg->enable_packet_filter(verbose_gen2x < PRINT_EVERYTHING);
+    ciucg->enable_adaptive_event_fifo_threshold(
+        ADAPTIVE_EVENT_FIFO_THRESHOLD_ENABLED);
+    get_ex10_tag_report_stream()->init(tag_report_buffer,
+                                       sizeof(tag_report_buffer),
+                                       tag_report_log_sink);
+
+    struct Ex10TagDedupTable const* dedup_table = get_ex10_tag_dedup_table();
+    ex10_result = dedup_table->init(
+        tag_dedup_entries, ARRAY_SIZE(tag_dedup_entries), 0u);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
 
     uint8_t const target =
         (inventory_options.target_spec == 'A') ? target_A : target_B;
@@ -288,7 +521,89 @@ static struct Ex10Result gen2x_continuous_inventory_example(void)
         get_ex10_active_region()->disable_regulatory_timers();
     }
 
-    struct Ex10Result ex10_result = ciucg->continuous_inventory(&params);
+    // Inventory keeps the Ex10 busy for long stretches; block on READY_N
+    // rather than spinning so that lower priority threads can run.
+    struct Ex10CommandTransactor const* transactor =
+        get_ex10_command_transactor();
+    struct Ex10GpioInterface const* gpio_if =
+        &get_ex10_board_driver_list()->gpio_if;
+    gpio_if->reset_ready_n_wait_stats();
+    enum ReadyNWaitMode const prev_wait_mode =
+        transactor->set_ready_n_wait_mode(ReadyNWaitInterrupt);
+    // Hand packets to the use case while the rest of the EventFifo is read.
+    get_ex10_protocol()->enable_pipelined_fifo_drain(true);
+    // Only the IRQ_N thread pushes packets during the inventory, so the
+    // EventFifo queue can pass them to this thread through its lock-free
+    // ring. Board setup returns the queue to list mode.
+    ex10_result = get_ex10_event_fifo_queue()->enable_ring_mode(true);
+    if (ex10_result.error)
+    {
+        ex10_ex_eprintf("EventFifo ring mode not enabled, using the list\n");
+    }
+    // Each round and channel hop rewrites the same inventory configuration;
+    // drop the writes which do not change a register.
+    struct Ex10RegisterCache const* register_cache = get_ex10_register_cache();
+    register_cache->reset_stats();
+    register_cache->enable(true);
+
+    first_ramp_pending = true;
+    profiler->begin_phase("First CW ramp");
+    ex10_result = ciucg->continuous_inventory(&params);
+    // Ends the first ramp and tag phases if the inventory saw neither.
+    first_ramp_pending = false;
+    first_tag_pending  = false;
+    profiler->stop();
+    get_ex10_tag_report_stream()->flush();
+    get_ex10_protocol()->enable_pipelined_fifo_drain(false);
+    register_cache->enable(false);
+    transactor->set_ready_n_wait_mode(prev_wait_mode);
+
+    struct Ex10RegisterCacheStats cache_stats;
+    register_cache->get_stats(&cache_stats);
+    ex10_ex_printf(
+        "Register writes: %u (skipped: %u, merged: %u), write commands: %u\n",
+        cache_stats.writes_issued + cache_stats.writes_skipped,
+        cache_stats.writes_skipped,
+        cache_stats.writes_merged,
+        cache_stats.write_commands);
+
+    struct ReadyNWaitStats ready_n_stats;
+    gpio_if->get_ready_n_wait_stats(&ready_n_stats);
+    ex10_ex_printf(
+        "READY_N waits: %u (spin: %u, blocked: %u, timeout: %u), "
+        "max: %u us, total: %u us, blocked: %u us\n",
+        ready_n_stats.wait_count,
+        ready_n_stats.spin_complete_count,
+        ready_n_stats.block_count,
+        ready_n_stats.timeout_count,
+        ready_n_stats.max_wait_us,
+        (uint32_t)ready_n_stats.total_wait_us,
+        (uint32_t)ready_n_stats.total_blocked_us);
+
+    if (ADAPTIVE_EVENT_FIFO_THRESHOLD_ENABLED)
+    {
+        struct Ex10EventFifoThresholdStats threshold_stats;
+        get_ex10_protocol()->get_adaptive_event_fifo_threshold_stats(
+            &threshold_stats);
+        ex10_ex_printf(
+            "EventFifo threshold evaluations: %u (timer: %u, raises: %u, "
+            "lowers: %u, low tag rate: %u, holds: %u), drains: %u, "
+            "write errors: %u\n",
+            threshold_stats.evaluations,
+            threshold_stats.timer_evaluations,
+            threshold_stats.raises,
+            threshold_stats.lowers,
+            threshold_stats.low_tag_rate_lowers,
+            threshold_stats.holds,
+            threshold_stats.drains,
+            threshold_stats.write_errors);
+    }
+
+    if (BOOT_PROFILER_ENABLED)
+    {
+        profiler->print_phases();
+    }
+
     if (ex10_result.error)
     {
         // Something bad happened so we exit with an error
@@ -317,6 +632,13 @@ static struct Ex10Result gen2x_continuous_inventory_example(void)
         (continuous_inventory_summary.duration_us % us_per_s) / 1000u,
         params.rf_mode);
 
+    struct Ex10TagDedupStats dedup_stats;
+    dedup_table->get_stats(&dedup_stats);
+    ex10_ex_printf("Unique tags: %zu, read more than once: %zu, evicted: %u\n",
+                   dedup_stats.unique_tags,
+                   dedup_stats.multi_read_tags,
+                   dedup_stats.lru_evictions);
+
     if (continuous_inventory_summary.number_of_tags == 0)
     {
         ex10_ex_printf("No tags found in inventory\n");
@@ -353,7 +675,13 @@ int gen2x_continuous_inventory(int min_read_rate)
         get_ex10_default_region_names()->get_region_id(
             inventory_options.region_name);
 
-    ex10_result = ex10_core_board_setup(region_id, DEFAULT_SPI_CLOCK_HZ);
+    struct Ex10BootProfiler const* profiler = get_ex10_boot_profiler();
+    if (BOOT_PROFILER_ENABLED)
+    {
+        profiler->start();
+    }
+
+    ex10_result = ex10_core_board_setup(region_id, NEGOTIATE_SPI_CLOCK_HZ);
     if (ex10_result.error)
     {
         ex10_ex_eprintf("ex10_core_board_setup() failed:\n");
@@ -362,6 +690,15 @@ int gen2x_continuous_inventory(int min_read_rate)
         return -1;
     }
 
+    struct Ex10SpiClockNegotiation const* spi_clock =
+        ex10_core_board_get_spi_clock_negotiation();
+    ex10_ex_printf(
+        "SPI clock: %u Hz selected, %u Hz highest passing, "
+        "%u Hz first failing\n",
+        (unsigned)spi_clock->selected_clock_hz,
+        (unsigned)spi_clock->highest_passing_hz,
+        (unsigned)spi_clock->first_failing_hz);
+
     // if (inventory_options.frequency_khz != 0)
     // {
     //     get_ex10_active_region()->set_single_frequency(
@@ -373,9 +710,18 @@ int gen2x_continuous_inventory(int min_read_rate)
     //     get_ex10_active_region()->disable_regulatory_timers();
     // }
 
+    profiler->begin_phase("set_calibration_lut_gen2x");
     set_calibration_lut_gen2x();
+    profiler->end_phase();
+    if (CALIBRATION_SNAPSHOT_ENABLED)
+    {
+        get_ex10_calibration()->set_calibration_store(
+            get_ex10_calibration_store_flash());
+    }
     get_ex10_calibration()->init(get_ex10_protocol());
+    profiler->begin_phase("ex10_set_default_gpio_setup");
     ex10_result = ex10_set_default_gpio_setup();
+    profiler->end_phase();
     if (ex10_result.error == false)
     {
         ex10_result = gen2x_continuous_inventory_example();
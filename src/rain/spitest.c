@@ -12,103 +12,338 @@
  *****************************************************************************/
 
 /**
- * @file test_spi_transfer.c
- * @details Execute repeated varied length data transfers via the ex10 host
- * interface using the TransferTest command.
+ * @file spitest.c
+ * @details Benchmark the Ex10 host interface using the TransferTest command.
  *
- * The number of iterations is a single argument on the command line.
- * Use zero to run forever.
+ * For each SPI clock speed the host interface runs the bus at, from
+ * HostInterface.get_clock_rates(), TransferTest commands are run for a
+ * ladder of payload sizes from 1 byte up to the largest payload
+ * which fits in EX10_SPI_BURST_SIZE. For each clock and size the following
+ * are reported:
+ *   - Throughput in bytes/s, counting the command and response bytes on the
+ *     wire.
+ *   - Per-transaction latency percentiles, measured around each
+ *     TransferTest command from the host with the Zephyr timing functions,
+ *     which count CPU cycles on the nRF5340.
+ *   - The READY_N wait time distribution, per clock speed.
  *
- * @note
- * One limitation is that the 'time_helper' routines assert when the call to
- * clock() rolls over. When this occurs, you'll see:
- *   ...
- *   Test transfer 17064366
- *   Test transfer 17064367
- *   exercise_transfers.bin: time_helpers.c:20: time_start:
- *   Assertion `time <= * 0xFFFFFFFF' failed. Aborted (core dumped)
+ * The iterations argument sets the number of transactions run for each
+ * clock speed and size. Lines beginning with "spi_bench," form a machine
+ * readable CSV summary; the first such line names the columns.
  */
 
 #include <stdint.h>
 
 #include "board/board_spec.h"
+#include "board/driver_list.h"
 #include "board/ex10_osal.h"
-#include "ex10_api/board_init.h"
+#include "ex10_api/board_init_core.h"
 #include "ex10_api/command_transactor.h"
+#include "ex10_api/ex10_macros.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_protocol.h"
+#include "ex10_api/ex10_regulatory.h"
 
-static const bool verbose = true;
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
 
-int spi_test(uint32_t iterations)
+static const bool verbose = false;
+
+/**
+ * The SPI clock speeds benchmarked if the host interface does not report the
+ * speeds it runs the bus at; those of the nRF5340 SPIM3 peripheral.
+ */
+static uint32_t const default_spi_bench_clocks_hz[] = {
+    1000000u,
+    2000000u,
+    4000000u,
+    8000000u,
+};
+
+/// The TransferTest payload sizes benchmarked at each clock speed.
+/// The TransferTest payload must leave room for the command code byte.
+static size_t const spi_bench_sizes[] = {
+    1u,
+    2u,
+    4u,
+    8u,
+    16u,
+    32u,
+    64u,
+    128u,
+    256u,
+    512u,
+    EX10_SPI_BURST_SIZE - 1u,
+};
+
+/// The number of latency samples kept for the percentile calculation.
+#define SPI_BENCH_MAX_SAMPLES ((size_t)512u)
+
+static uint8_t  tx_data[EX10_SPI_BURST_SIZE];
+static uint8_t  rx_data[EX10_SPI_BURST_SIZE];
+static uint32_t latency_us[SPI_BENCH_MAX_SAMPLES];
+
+/**
+ * @struct SpiBenchPoint
+ * The results for one clock speed and payload size.
+ */
+struct SpiBenchPoint
 {
-    ex10_ex_printf("Starting SPI transfer example\n");
-/*
-    uint8_t tx_data[EX10_SPI_BURST_SIZE];
-    uint8_t rx_data[EX10_SPI_BURST_SIZE];
+    uint32_t clock_hz;
+    size_t   payload_length;
+    uint32_t transactions;
+    uint32_t errors;
+    uint64_t total_ns;
+    uint32_t bytes_per_s;
+    uint32_t min_us;
+    uint32_t p50_us;
+    uint32_t p90_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+};
 
-    struct ConstByteSpan tx = {
-        .data   = tx_data,
-        .length = EX10_SPI_BURST_SIZE,
+static void sort_samples(uint32_t* samples, size_t count)
+{
+    for (size_t iter = 1u; iter < count; ++iter)
+    {
+        uint32_t const value = samples[iter];
+        size_t         index = iter;
+        for (; index > 0u && samples[index - 1u] > value; --index)
+        {
+            samples[index] = samples[index - 1u];
+        }
+        samples[index] = value;
+    }
+}
+
+static uint32_t percentile(uint32_t const* sorted,
+                           size_t          count,
+                           uint32_t        percent)
+{
+    if (count == 0u)
+    {
+        return 0u;
+    }
+    size_t const index = ((count - 1u) * percent + 50u) / 100u;
+    return sorted[index];
+}
+
+static struct SpiBenchPoint run_bench_point(uint32_t clock_hz,
+                                            size_t   payload_length,
+                                            uint32_t iterations)
+{
+    struct Ex10Protocol const* ex10_protocol = get_ex10_protocol();
+
+    struct SpiBenchPoint point = {
+        .clock_hz       = clock_hz,
+        .payload_length = payload_length,
     };
 
-    struct ByteSpan rx = {
-        .data   = rx_data,
-        .length = EX10_SPI_BURST_SIZE,
+    struct ConstByteSpan const tx = {
+        .data   = tx_data,
+        .length = payload_length,
     };
 
-    struct Ex10Result ex10_result =
-        ex10_typical_board_setup(DEFAULT_SPI_CLOCK_HZ, REGION_FCC);
+    size_t samples = 0u;
+    for (uint32_t iteration = 0u; iteration < iterations; ++iteration)
+    {
+        ex10_memset(tx_data,
+                    sizeof(tx_data),
+                    (int)(iteration & UINT8_MAX),
+                    payload_length);
+        struct ByteSpan rx = {
+            .data   = rx_data,
+            .length = sizeof(rx_data),
+        };
+
+        bool const              verify      = true;
+        timing_t                start_count = timing_counter_get();
+        struct Ex10Result const ex10_result =
+            ex10_protocol->test_transfer(&tx, &rx, verify);
+        timing_t       end_count  = timing_counter_get();
+        uint64_t const elapsed_ns = timing_cycles_to_ns(
+            timing_cycles_get(&start_count, &end_count));
+        uint32_t const elapsed_us = (uint32_t)(elapsed_ns / 1000u);
+
+        point.transactions += 1u;
+        point.total_ns += elapsed_ns;
+        if (ex10_result.error)
+        {
+            point.errors += 1u;
+        }
+
+        if (samples < SPI_BENCH_MAX_SAMPLES)
+        {
+            latency_us[samples++] = elapsed_us;
+        }
+    }
+
+    sort_samples(latency_us, samples);
+    point.min_us = (samples > 0u) ? latency_us[0u] : 0u;
+    point.p50_us = percentile(latency_us, samples, 50u);
+    point.p90_us = percentile(latency_us, samples, 90u);
+    point.p99_us = percentile(latency_us, samples, 99u);
+    point.max_us = (samples > 0u) ? latency_us[samples - 1u] : 0u;
+
+    // Both the command and the response carry the command or response code
+    // byte followed by the payload.
+    uint64_t const wire_bytes =
+        (uint64_t)point.transactions * 2u * (payload_length + 1u);
+    point.bytes_per_s =
+        (point.total_ns > 0u)
+            ? (uint32_t)((wire_bytes * 1000000000u) / point.total_ns)
+            : 0u;
+
+    return point;
+}
+
+static void print_bench_point(struct SpiBenchPoint const* point)
+{
+    ex10_ex_printf("spi_bench,%u,%zu,%u,%u,%u,%u,%u,%u,%u,%u\n",
+                   point->clock_hz,
+                   point->payload_length,
+                   point->transactions,
+                   point->errors,
+                   point->bytes_per_s,
+                   point->min_us,
+                   point->p50_us,
+                   point->p90_us,
+                   point->p99_us,
+                   point->max_us);
+}
+
+static void print_ready_n_stats(uint32_t                      clock_hz,
+                                struct ReadyNWaitStats const* stats)
+{
+    ex10_ex_printf(
+        "READY_N at %u Hz: waits: %u, timeouts: %u, max: %u us, "
+        "mean: %u us\n",
+        clock_hz,
+        stats->wait_count,
+        stats->timeout_count,
+        stats->max_wait_us,
+        (stats->wait_count > 0u)
+            ? (uint32_t)(stats->total_wait_us / stats->wait_count)
+            : 0u);
 
+    // Bin n counts waits shorter than 2^n us.
+    ex10_ex_printf("spi_bench_ready_n,%u", clock_hz);
+    for (size_t bin = 0u; bin < READY_N_WAIT_HISTOGRAM_BINS; ++bin)
+    {
+        ex10_ex_printf(",%u", stats->wait_histogram[bin]);
+    }
+    ex10_ex_printf("\n");
+}
+
+int spi_test(uint32_t iterations)
+{
+    ex10_ex_printf("Starting SPI benchmark example\n");
+
+    if (iterations == 0u)
+    {
+        ex10_ex_eprintf("The iteration count must be non-zero\n");
+        return -1;
+    }
+
+    struct Ex10Result ex10_result =
+        ex10_core_board_setup(REGION_FCC, NEGOTIATE_SPI_CLOCK_HZ);
     if (ex10_result.error)
     {
-        ex10_ex_eprintf("ex10_typical_board_setup() failed:\n");
+        ex10_ex_eprintf("ex10_core_board_setup() failed:\n");
         print_ex10_result(ex10_result);
-        ex10_typical_board_teardown();
+        ex10_core_board_teardown();
         return -1;
     }
 
-    struct Ex10Protocol const* ex10_protocol = get_ex10_protocol();
+    struct Ex10SpiClockNegotiation const* spi_clock =
+        ex10_core_board_get_spi_clock_negotiation();
+    ex10_ex_printf(
+        "SPI clock: %u Hz selected, %u Hz highest passing, "
+        "%u Hz first failing\n",
+        (unsigned)spi_clock->selected_clock_hz,
+        (unsigned)spi_clock->highest_passing_hz,
+        (unsigned)spi_clock->first_failing_hz);
+
+    struct Ex10Protocol const*      ex10_protocol = get_ex10_protocol();
+    struct Ex10GpioInterface const* gpio_if =
+        &get_ex10_board_driver_list()->gpio_if;
+    uint32_t const                  initial_clock_hz =
+        ex10_protocol->get_application_spi_clock();
 
-    tx.length = 0u;
-    for (size_t iteration_number = 0u;
-         (iterations == 0u) || (iteration_number < iterations);
-         ++iteration_number)
+    // Only benchmark the clock speeds the bus runs at; other requested
+    // speeds are rounded by the SPI peripheral.
+    struct HostInterface const* host_if =
+        &get_ex10_board_driver_list()->host_if;
+    uint32_t const* clocks_hz   = default_spi_bench_clocks_hz;
+    size_t          clock_count = ARRAY_SIZE(default_spi_bench_clocks_hz);
+    if (host_if->get_clock_rates != NULL)
     {
-        ex10_memset(
-            tx_data, sizeof(tx_data), iteration_number & UINT8_MAX, tx.length);
-        rx.length = tx.length;
+        clock_count = host_if->get_clock_rates(&clocks_hz);
+    }
+
+    timing_init();
+    timing_start();
 
-        if (verbose)
+    ex10_ex_printf(
+        "spi_bench,clock_hz,payload_bytes,transactions,errors,bytes_per_s,"
+        "min_us,p50_us,p90_us,p99_us,max_us\n");
+
+    uint32_t total_errors = 0u;
+    for (size_t clock_iter = 0u; clock_iter < clock_count; ++clock_iter)
+    {
+        uint32_t const clock_hz = clocks_hz[clock_iter];
+        if (clock_hz > MAX_NEGOTIATED_SPI_CLOCK_HZ)
         {
-            ex10_ex_printf("Test transfer %zu (size %zu)\n",
-                           iteration_number++,
-                           tx.length);
+            break;
         }
-        bool const verify = true;
-        ex10_result       = ex10_protocol->test_transfer(&tx, &rx, verify);
+
+        ex10_result = ex10_protocol->set_application_spi_clock(clock_hz);
         if (ex10_result.error)
         {
-            ex10_ex_eprintf(
-                "Response code from device: %u\n",
-                ex10_result.device_status.cmd_host_result.failed_result_code);
-            ex10_ex_eprintf("Response code from commands layer: %u\n",
-                            ex10_result.device_status.cmd_host_result
-                                .failed_host_result_code);
+            ex10_ex_eprintf("set_application_spi_clock(%u) failed:\n",
+                            clock_hz);
+            print_ex10_result(ex10_result);
             break;
         }
 
-        tx.length += 1u;
-        if (tx.length >= EX10_SPI_BURST_SIZE)
+        gpio_if->reset_ready_n_wait_stats();
+        uint32_t clock_errors = 0u;
+        for (size_t size_iter = 0u; size_iter < ARRAY_SIZE(spi_bench_sizes);
+             ++size_iter)
         {
-            // Note the wrap-around comparison is 1 less than the
-            // EX10_SPI_BURST_SIZE. This allows room for the TransferTest
-            // command byte to be inserted.
-            tx.length = 0u;
+            struct SpiBenchPoint const point = run_bench_point(
+                clock_hz, spi_bench_sizes[size_iter], iterations);
+            print_bench_point(&point);
+            clock_errors += point.errors;
+
+            if (verbose)
+            {
+                ex10_ex_printf("%u Hz, %zu bytes: %u bytes/s, p50 %u us\n",
+                               clock_hz,
+                               point.payload_length,
+                               point.bytes_per_s,
+                               point.p50_us);
+            }
+        }
+
+        struct ReadyNWaitStats ready_n_stats;
+        gpio_if->get_ready_n_wait_stats(&ready_n_stats);
+        print_ready_n_stats(clock_hz, &ready_n_stats);
+
+        total_errors += clock_errors;
+        if (clock_errors > 0u)
+        {
+            // Higher clock speeds will not do better on this board.
+            ex10_ex_eprintf("Transfer errors at %u Hz, stopping the sweep\n",
+                            clock_hz);
+            break;
         }
     }
 
-    if (ex10_result.error == false)
+    timing_stop();
+    ex10_protocol->set_application_spi_clock(initial_clock_hz);
+
+    if (total_errors == 0u && ex10_result.error == false)
     {
         ex10_ex_printf("Pass\n");
     }
@@ -117,8 +352,7 @@ int spi_test(uint32_t iterations)
         ex10_ex_eprintf("Fail\n");
     }
 
-    ex10_typical_board_teardown();
-    ex10_ex_printf("Ending SPI transfer example\n");
-    return ex10_result.error;
-    */
+    ex10_core_board_teardown();
+    ex10_ex_printf("Ending SPI benchmark example\n");
+    return (total_errors == 0u && ex10_result.error == false) ? 0 : -1;
 }
@@ -1477,6 +1477,7 @@ static bool append_insert_fifo_event(const bool                    trigger_irq,
     struct EventFifoPacket const empty_event_packet = {
         .packet_type         = (enum EventPacketType)0,
         .us_counter          = 0u,
+        .timestamp_us        = 0u,
         .static_data         = NULL,
         .static_data_length  = 0,
         .dynamic_data        = NULL,
@@ -20,11 +20,216 @@
 #include "board/ex10_random.h"
 #include "board/fifo_buffer_pool.h"
 #include "ex10_api/ex10_active_region.h"
+#include "ex10_api/ex10_boot_profiler.h"
 #include "ex10_api/ex10_event_fifo_queue.h"
+#include "ex10_api/ex10_macros.h"
 #include "ex10_api/ex10_protocol.h"
 #include "ex10_api/ex10_rf_power.h"
 #include "ex10_api/power_transactor.h"
 
+/**
+ * The SPI clock speeds stepped through when negotiating the SPI clock, if
+ * the host interface does not report the speeds at which it runs the bus.
+ */
+static uint32_t const default_spi_clock_candidates_hz[] = {
+    4000000u,
+    6000000u,
+    8000000u,
+    12000000u,
+    16000000u,
+};
+
+/// The number of data patterns sent with TransferTest at each clock speed.
+static size_t const SPI_LINK_TEST_PATTERNS = 5u;
+
+/**
+ * The number of times the TransferTest patterns must pass at a clock speed
+ * for it to be selected. Repeating the test at each speed provides the
+ * safety margin, so the highest passing speed is used.
+ */
+static size_t const SPI_LINK_TEST_PASSES = 4u;
+
+static struct Ex10SpiClockNegotiation spi_clock_negotiation;
+
+static uint8_t spi_link_test_tx[EX10_SPI_BURST_SIZE - 1u];
+static uint8_t spi_link_test_rx[EX10_SPI_BURST_SIZE];
+
+static void fill_spi_link_test_pattern(size_t pattern)
+{
+    for (size_t iter = 0u; iter < sizeof(spi_link_test_tx); ++iter)
+    {
+        uint8_t value = 0u;
+        switch (pattern)
+        {
+            case 0u:
+                value = 0x00u;
+                break;
+            case 1u:
+                value = 0xFFu;
+                break;
+            case 2u:
+                value = (iter & 1u) ? 0x55u : 0xAAu;
+                break;
+            case 3u:
+                value = (uint8_t)(1u << (iter % 8u));
+                break;
+            default:
+                value = (uint8_t)(iter * 167u + 13u);
+                break;
+        }
+        spi_link_test_tx[iter] = value;
+    }
+}
+
+/**
+ * Run the TransferTest patterns at the current SPI clock speed.
+ *
+ * @return uint32_t The number of bytes received in error plus the number of
+ *                  TransferTest commands which failed.
+ */
+static uint32_t run_spi_link_test(struct Ex10Protocol const* protocol)
+{
+    uint32_t error_count = 0u;
+    for (size_t pattern = 0u; pattern < SPI_LINK_TEST_PATTERNS; ++pattern)
+    {
+        fill_spi_link_test_pattern(pattern);
+
+        struct ConstByteSpan const tx = {
+            .data   = spi_link_test_tx,
+            .length = sizeof(spi_link_test_tx),
+        };
+        struct ByteSpan rx = {
+            .data   = spi_link_test_rx,
+            .length = sizeof(spi_link_test_rx),
+        };
+
+        // The received bytes are checked here, rather than by the
+        // TransferTest command, so that bit errors are counted quietly.
+        bool const              verify = false;
+        struct Ex10Result const ex10_result =
+            protocol->test_transfer(&tx, &rx, verify);
+        if (ex10_result.error || rx.length < tx.length)
+        {
+            error_count += 1u;
+            continue;
+        }
+
+        for (size_t iter = 0u; iter < tx.length; ++iter)
+        {
+            uint8_t const expected = (uint8_t)(tx.data[iter] + iter);
+            if (rx.data[iter] != expected)
+            {
+                error_count += 1u;
+            }
+        }
+    }
+    return error_count;
+}
+
+struct Ex10Result ex10_core_board_negotiate_spi_clock(uint32_t max_clock_hz)
+{
+    struct Ex10Protocol const* protocol = get_ex10_protocol();
+
+    struct Ex10SpiClockNegotiation const cleared_negotiation = {
+        .selected_clock_hz   = protocol->get_application_spi_clock(),
+        .highest_passing_hz  = 0u,
+        .first_failing_hz    = 0u,
+        .error_count         = 0u,
+        .transfers_per_clock =
+            (uint32_t)(SPI_LINK_TEST_PATTERNS * SPI_LINK_TEST_PASSES),
+    };
+    spi_clock_negotiation = cleared_negotiation;
+
+    if (protocol->get_running_location() != Application)
+    {
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorRunLocation);
+    }
+
+    // Only try the speeds the bus actually runs at, so that the recorded
+    // and selected speeds are those used on the bus.
+    struct HostInterface const* host_if =
+        &get_ex10_board_driver_list()->host_if;
+    uint32_t const* candidates_hz = default_spi_clock_candidates_hz;
+    size_t candidate_count = ARRAY_SIZE(default_spi_clock_candidates_hz);
+    if (host_if->get_clock_rates != NULL)
+    {
+        candidate_count = host_if->get_clock_rates(&candidates_hz);
+    }
+
+    uint32_t const initial_clock_hz = protocol->get_application_spi_clock();
+    uint32_t       selected_hz      = 0u;
+    for (size_t iter = 0u; iter < candidate_count; ++iter)
+    {
+        uint32_t const clock_hz = candidates_hz[iter];
+        if (clock_hz < DEFAULT_SPI_CLOCK_HZ)
+        {
+            continue;
+        }
+        if (clock_hz > max_clock_hz)
+        {
+            break;
+        }
+
+        struct Ex10Result const ex10_result =
+            protocol->set_application_spi_clock(clock_hz);
+        if (ex10_result.error)
+        {
+            return ex10_result;
+        }
+
+        uint32_t error_count = 0u;
+        for (size_t pass = 0u; pass < SPI_LINK_TEST_PASSES; ++pass)
+        {
+            error_count += run_spi_link_test(protocol);
+        }
+        if (error_count > 0u)
+        {
+            spi_clock_negotiation.first_failing_hz = clock_hz;
+            spi_clock_negotiation.error_count      = error_count;
+            break;
+        }
+
+        selected_hz                              = clock_hz;
+        spi_clock_negotiation.highest_passing_hz = clock_hz;
+    }
+
+    if (spi_clock_negotiation.highest_passing_hz == 0u)
+    {
+        protocol->set_application_spi_clock(initial_clock_hz);
+        return make_ex10_sdk_error(Ex10ModuleBoardInit,
+                                   Ex10SdkErrorHostInterface);
+    }
+
+    struct Ex10Result ex10_result =
+        protocol->set_application_spi_clock(selected_hz);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    // Confirm the link is clean at the selected speed, since a failed
+    // transfer may have left the previous attempt in a bad state.
+    if (run_spi_link_test(protocol) > 0u)
+    {
+        selected_hz = DEFAULT_SPI_CLOCK_HZ;
+        ex10_result = protocol->set_application_spi_clock(selected_hz);
+        if (ex10_result.error)
+        {
+            return ex10_result;
+        }
+    }
+
+    spi_clock_negotiation.selected_clock_hz = selected_hz;
+    return make_ex10_success();
+}
+
+struct Ex10SpiClockNegotiation const*
+    ex10_core_board_get_spi_clock_negotiation(void)
+{
+    return &spi_clock_negotiation;
+}
+
 void ex10_core_board_gpio_init(struct Ex10GpioInterface const* gpio_if)
 {
     bool const board_power_on = false;
@@ -33,9 +238,11 @@ void ex10_core_board_gpio_init(struct Ex10GpioInterface const* gpio_if)
     gpio_if->initialize(board_power_on, ex10_enable, reset);
 }
 
-struct Ex10Result ex10_core_board_setup(enum Ex10RegionId region_id,
-                                        uint32_t          spi_clock_hz)
+static struct Ex10Result core_board_setup(enum Ex10RegionId region_id,
+                                          uint32_t          spi_clock_hz)
 {
+    struct Ex10BootProfiler const* profiler = get_ex10_boot_profiler();
+
     // Seed the random number generator (in the board init layer) prior to
     // initializing the region table.
     get_ex10_random()->setup_random();
@@ -44,7 +251,11 @@ struct Ex10Result ex10_core_board_setup(enum Ex10RegionId region_id,
     // Initialize the modules first:
     get_ex10_power_transactor()->init();
     ex10_core_board_gpio_init(&driver_list->gpio_if);
-    const int32_t result = driver_list->host_if.open(spi_clock_hz);
+    bool const negotiate_spi_clock = (spi_clock_hz == NEGOTIATE_SPI_CLOCK_HZ);
+    profiler->begin_phase("Host interface open");
+    const int32_t result = driver_list->host_if.open(
+        negotiate_spi_clock ? DEFAULT_SPI_CLOCK_HZ : spi_clock_hz);
+    profiler->end_phase();
     if (result < 0)
     {
         return make_ex10_sdk_error_with_status(
@@ -66,9 +277,14 @@ struct Ex10Result ex10_core_board_setup(enum Ex10RegionId region_id,
     struct FifoBufferList const* fifo_buffer_list = get_ex10_fifo_buffer_list();
 
     struct Ex10Result ex10_result =
-        fifo_buffer_list->init(event_fifo_buffer_pool->fifo_buffer_nodes,
-                               event_fifo_buffer_pool->fifo_buffers,
-                               event_fifo_buffer_pool->buffer_count);
+        (event_fifo_buffer_pool->arena != NULL)
+            ? fifo_buffer_list->init_arena(
+                  event_fifo_buffer_pool->fifo_buffer_nodes,
+                  event_fifo_buffer_pool->buffer_count,
+                  event_fifo_buffer_pool->arena)
+            : fifo_buffer_list->init(event_fifo_buffer_pool->fifo_buffer_nodes,
+                                     event_fifo_buffer_pool->fifo_buffers,
+                                     event_fifo_buffer_pool->buffer_count);
     if (ex10_result.error)
     {
         return ex10_result;
@@ -93,8 +309,10 @@ struct Ex10Result ex10_core_board_setup(enum Ex10RegionId region_id,
 
     // Power up the Ex10 Reader Chip. This may return with Bootloader status.
     // If this happens then only proceed with Ex10Protocol init_ex10().
+    profiler->begin_phase("Power up to application");
     const int power_up_status =
         get_ex10_power_transactor()->power_up_to_application();
+    profiler->end_phase();
     // If the power_up_status is < 0 then there was an error initializing the
     // host interface. Nothing further can be done.
     if (power_up_status < 0)
@@ -111,28 +329,66 @@ struct Ex10Result ex10_core_board_setup(enum Ex10RegionId region_id,
                                    Ex10SdkErrorRunLocation);
     }
 
+    // The power up brings the Application up at DEFAULT_SPI_CLOCK_HZ.
+    profiler->begin_phase("SPI clock setup");
+    if (negotiate_spi_clock)
+    {
+        ex10_result =
+            ex10_core_board_negotiate_spi_clock(MAX_NEGOTIATED_SPI_CLOCK_HZ);
+    }
+    else if (spi_clock_hz != protocol->get_application_spi_clock())
+    {
+        ex10_result = protocol->set_application_spi_clock(spi_clock_hz);
+    }
+    profiler->end_phase();
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
     get_ex10_event_fifo_queue()->init();
 
+    profiler->begin_phase("Protocol init_ex10");
     ex10_result = protocol->init_ex10();
+    profiler->end_phase();
     if (ex10_result.error)
     {
         return ex10_result;
     }
     // Progress through the Ex10 modules' initialization of the
     // Impinj Reader Chip.
+    profiler->begin_phase("RF power init_ex10");
     ex10_result = rf_power->init_ex10();
+    profiler->end_phase();
     if (ex10_result.error)
     {
         return ex10_result;
     }
     // setup the active region
+    profiler->begin_phase("Set region");
     get_ex10_active_region()->set_region(region_id, TCXO_FREQ_KHZ);
+    profiler->end_phase();
     // Set up sjc now that ops is fully initialized
+    profiler->begin_phase("SJC init");
     get_ex10_sjc()->init(protocol);
+    profiler->end_phase();
 
     return make_ex10_success();
 }
 
+struct Ex10Result ex10_core_board_setup(enum Ex10RegionId region_id,
+                                        uint32_t          spi_clock_hz)
+{
+    struct Ex10BootProfiler const* profiler = get_ex10_boot_profiler();
+
+    profiler->begin_phase("ex10_core_board_setup");
+    struct Ex10Result const ex10_result =
+        core_board_setup(region_id, spi_clock_hz);
+    profiler->end_phase();
+
+    return ex10_result;
+}
+
 
 struct Ex10Result ex10_bootloader_core_board_setup(uint32_t spi_clock_hz)
 {
@@ -25,10 +25,31 @@ struct CommandTransactor
 {
     struct Ex10GpioInterface const* gpio_interface;
     struct HostInterface const*     host_interface;
+    enum ReadyNWaitMode             ready_n_wait_mode;
 };
 
-static struct CommandTransactor command_transactor = {.gpio_interface = NULL,
-                                                      .host_interface = NULL};
+/// The asynchronous transfer started by send_command_async() or
+/// receive_response_async() which has not yet been completed.
+struct PendingTransfer
+{
+    bool   is_pending;
+    bool   is_read;
+    void*  buffer;
+    size_t length;
+};
+
+static struct PendingTransfer pending_transfer = {
+    .is_pending = false,
+    .is_read    = false,
+    .buffer     = NULL,
+    .length     = 0u,
+};
+
+static struct CommandTransactor command_transactor = {
+    .gpio_interface    = NULL,
+    .host_interface    = NULL,
+    .ready_n_wait_mode = ReadyNWaitSpin,
+};
 
 static void init(struct Ex10GpioInterface const* gpio_interface,
                  struct HostInterface const*     host_interface)
@@ -39,13 +60,101 @@ static void init(struct Ex10GpioInterface const* gpio_interface,
 
 static void deinit(void)
 {
+    pending_transfer.is_pending = false;
     command_transactor.gpio_interface = NULL;
     command_transactor.host_interface = NULL;
 }
 
-static struct Ex10Result send_command(const void* command_buffer,
-                                      size_t      command_length,
-                                      uint32_t    ready_n_timeout_ms)
+static enum ReadyNWaitMode set_ready_n_wait_mode(enum ReadyNWaitMode wait_mode)
+{
+    enum ReadyNWaitMode const prev_wait_mode =
+        command_transactor.ready_n_wait_mode;
+    command_transactor.ready_n_wait_mode = wait_mode;
+    return prev_wait_mode;
+}
+
+static int32_t wait_ready_n(uint32_t ready_n_timeout_ms)
+{
+    return command_transactor.gpio_interface->wait_ready_n(
+        ready_n_timeout_ms, command_transactor.ready_n_wait_mode);
+}
+
+static struct Ex10Result check_received_length(void const* response_buffer,
+                                               size_t  response_buffer_length,
+                                               int32_t bytes_received)
+{
+    if (bytes_received < 0)
+    {
+        return make_ex10_sdk_error_with_status(Ex10ModuleCommandTransactor,
+                                               Ex10SdkErrorHostInterface,
+                                               (uint32_t)bytes_received);
+    }
+
+    if ((size_t)bytes_received != response_buffer_length)
+    {
+        enum CommandCode command_code = (enum CommandCode) * last_command.data;
+
+        ex10_eprintf("Response length: %d, expected: %d \n",
+                     bytes_received,
+                     response_buffer_length);
+        ex10_eputs("command: 0x%02X\n", command_code);
+        ex10_print_data(
+            last_command.data, last_command.length, DataPrefixIndex);
+
+        ex10_eputs("response:\n");
+        ex10_print_data(
+            response_buffer, (size_t)bytes_received, DataPrefixIndex);
+
+
+        return make_ex10_commands_w_resp_error(
+            Success, command_code, HostResultReceivedLengthIncorrect);
+    }
+
+    tracepoint(pi_ex10sdk, CMD_recv, response_buffer, response_buffer_length);
+
+    return make_ex10_success();
+}
+
+static struct Ex10Result wait_transfer_complete(void)
+{
+    if (pending_transfer.is_pending == false)
+    {
+        return make_ex10_success();
+    }
+    pending_transfer.is_pending = false;
+
+    int32_t const bytes_transferred =
+        command_transactor.host_interface->wait_async();
+
+    if (pending_transfer.is_read)
+    {
+        return check_received_length(pending_transfer.buffer,
+                                     pending_transfer.length,
+                                     bytes_transferred);
+    }
+
+    if ((bytes_transferred < 0) ||
+        ((uint32_t)bytes_transferred != pending_transfer.length))
+    {
+        return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
+                                   Ex10SdkErrorUnexpectedTxLength);
+    }
+    return make_ex10_success();
+}
+
+static bool host_interface_is_async(void)
+{
+    struct HostInterface const* host_interface =
+        command_transactor.host_interface;
+    return (host_interface->read_async != NULL) &&
+           (host_interface->write_async != NULL) &&
+           (host_interface->wait_async != NULL);
+}
+
+static struct Ex10Result start_command(const void* command_buffer,
+                                       size_t      command_length,
+                                       uint32_t    ready_n_timeout_ms,
+                                       bool        async)
 {
     if ((command_buffer == NULL) ||
         (command_transactor.gpio_interface == NULL) ||
@@ -55,19 +164,39 @@ static struct Ex10Result send_command(const void* command_buffer,
                                    Ex10SdkErrorNullPointer);
     }
 
+    struct Ex10Result const ex10_result = wait_transfer_complete();
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
     last_command.data   = (uint8_t const*)command_buffer;
     last_command.length = command_length;
 
     tracepoint(pi_ex10sdk, CMD_send, command_buffer, command_length);
 
-    int const ret_val = command_transactor.gpio_interface->busy_wait_ready_n(
-        ready_n_timeout_ms);
+    int const ret_val = wait_ready_n(ready_n_timeout_ms);
     if (ret_val != 0)
     {
         return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
                                    Ex10SdkErrorTimeout);
     }
 
+    if (async && host_interface_is_async())
+    {
+        if (command_transactor.host_interface->write_async(
+                command_buffer, command_length) != 0)
+        {
+            return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
+                                       Ex10SdkErrorUnexpectedTxLength);
+        }
+        pending_transfer.is_pending = true;
+        pending_transfer.is_read    = false;
+        pending_transfer.buffer     = (void*)command_buffer;
+        pending_transfer.length     = command_length;
+        return make_ex10_success();
+    }
+
     int32_t const bytes_sent = command_transactor.host_interface->write(
         command_buffer, command_length);
     if ((bytes_sent < 0) || ((uint32_t)bytes_sent != command_length))
@@ -79,9 +208,10 @@ static struct Ex10Result send_command(const void* command_buffer,
     return make_ex10_success();
 }
 
-static struct Ex10Result receive_response(void*    response_buffer,
-                                          size_t   response_buffer_length,
-                                          uint32_t ready_n_timeout_ms)
+static struct Ex10Result start_response(void*    response_buffer,
+                                        size_t   response_buffer_length,
+                                        uint32_t ready_n_timeout_ms,
+                                        bool     async)
 {
     if ((response_buffer == NULL) ||
         (command_transactor.gpio_interface == NULL) ||
@@ -106,47 +236,73 @@ static struct Ex10Result receive_response(void*    response_buffer,
                                    Ex10SdkErrorBadParamValue);
     }
 
-    int const ret_val = command_transactor.gpio_interface->busy_wait_ready_n(
-        ready_n_timeout_ms);
+    struct Ex10Result const ex10_result = wait_transfer_complete();
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    int const ret_val = wait_ready_n(ready_n_timeout_ms);
     if (ret_val != 0)
     {
         return make_ex10_sdk_error(Ex10ModuleCommandTransactor,
                                    Ex10SdkErrorTimeout);
     }
 
-    int32_t const bytes_received = command_transactor.host_interface->read(
-        response_buffer, response_buffer_length);
-
-    if (bytes_received < 0)
+    if (async && host_interface_is_async())
     {
-        return make_ex10_sdk_error_with_status(Ex10ModuleCommandTransactor,
-                                               Ex10SdkErrorHostInterface,
-                                               (uint32_t)bytes_received);
+        int32_t const error = command_transactor.host_interface->read_async(
+            response_buffer, response_buffer_length);
+        if (error != 0)
+        {
+            return make_ex10_sdk_error_with_status(Ex10ModuleCommandTransactor,
+                                                   Ex10SdkErrorHostInterface,
+                                                   (uint32_t)error);
+        }
+        pending_transfer.is_pending = true;
+        pending_transfer.is_read    = true;
+        pending_transfer.buffer     = response_buffer;
+        pending_transfer.length     = response_buffer_length;
+        return make_ex10_success();
     }
 
-    if ((size_t)bytes_received != response_buffer_length)
-    {
-        enum CommandCode command_code = (enum CommandCode) * last_command.data;
-
-        ex10_eprintf("Response length: %d, expected: %d \n",
-                     bytes_received,
-                     response_buffer_length);
-        ex10_eputs("command: 0x%02X\n", command_code);
-        ex10_print_data(
-            last_command.data, last_command.length, DataPrefixIndex);
+    int32_t const bytes_received = command_transactor.host_interface->read(
+        response_buffer, response_buffer_length);
 
-        ex10_eputs("response:\n");
-        ex10_print_data(
-            response_buffer, (size_t)bytes_received, DataPrefixIndex);
+    return check_received_length(
+        response_buffer, response_buffer_length, bytes_received);
+}
 
+static struct Ex10Result send_command(const void* command_buffer,
+                                      size_t      command_length,
+                                      uint32_t    ready_n_timeout_ms)
+{
+    return start_command(
+        command_buffer, command_length, ready_n_timeout_ms, false);
+}
 
-        return make_ex10_commands_w_resp_error(
-            Success, command_code, HostResultReceivedLengthIncorrect);
-    }
+static struct Ex10Result receive_response(void*    response_buffer,
+                                          size_t   response_buffer_length,
+                                          uint32_t ready_n_timeout_ms)
+{
+    return start_response(
+        response_buffer, response_buffer_length, ready_n_timeout_ms, false);
+}
 
-    tracepoint(pi_ex10sdk, CMD_recv, response_buffer, response_buffer_length);
+static struct Ex10Result send_command_async(const void* command_buffer,
+                                            size_t      command_length,
+                                            uint32_t    ready_n_timeout_ms)
+{
+    return start_command(
+        command_buffer, command_length, ready_n_timeout_ms, true);
+}
 
-    return make_ex10_success();
+static struct Ex10Result receive_response_async(void*  response_buffer,
+                                                size_t response_buffer_length,
+                                                uint32_t ready_n_timeout_ms)
+{
+    return start_response(
+        response_buffer, response_buffer_length, ready_n_timeout_ms, true);
 }
 
 static struct Ex10Result send_and_recv_bytes(const void* command_buffer,
@@ -167,11 +323,15 @@ static struct Ex10Result send_and_recv_bytes(const void* command_buffer,
 }
 
 static const struct Ex10CommandTransactor ex10_command_transactor = {
-    .init                = init,
-    .deinit              = deinit,
-    .send_command        = send_command,
-    .receive_response    = receive_response,
-    .send_and_recv_bytes = send_and_recv_bytes,
+    .init                   = init,
+    .deinit                 = deinit,
+    .send_command           = send_command,
+    .receive_response       = receive_response,
+    .send_and_recv_bytes    = send_and_recv_bytes,
+    .set_ready_n_wait_mode  = set_ready_n_wait_mode,
+    .send_command_async     = send_command_async,
+    .receive_response_async = receive_response_async,
+    .wait_transfer_complete = wait_transfer_complete,
 };
 
 struct Ex10CommandTransactor const* get_ex10_command_transactor(void)
@@ -374,6 +374,78 @@ static struct Ex10Result command_write(
     return ex10_result;
 }
 
+// The ReadFifo command issued by command_read_fifo_chunk_start() is sent
+// asynchronously, so it is kept apart from command_buffer[].
+static uint8_t read_fifo_command[1u + sizeof(struct Ex10ReadFifoFormat)];
+
+static struct Ex10Result send_read_fifo_command(enum FifoSelection fifo_select,
+                                                size_t             fifo_len,
+                                                bool               async)
+{
+    // The EX10_SPI_BURST_SIZE is also the maximum response length
+    // with the response code byte. i.e. The total available bytes in
+    // the response can be one byte more than the maximum fifo_len.
+    if (fifo_len > EX10_SPI_BURST_SIZE - 1u)
+    {
+        return make_ex10_sdk_error(Ex10ModuleCommands,
+                                   Ex10SdkErrorBadParamLength);
+    }
+
+    read_fifo_command[0u] = (uint8_t)CommandReadFifo;
+    read_fifo_command[1u] = (uint8_t)fifo_select;
+    read_fifo_command[2u] = (uint8_t)(fifo_len >> 0u);
+    read_fifo_command[3u] = (uint8_t)(fifo_len >> 8u);
+
+    struct Ex10CommandTransactor const* transactor =
+        get_ex10_command_transactor();
+    return async ? transactor->send_command_async(read_fifo_command,
+                                                  sizeof(read_fifo_command),
+                                                  NOMINAL_READY_N_TIMEOUT_MS)
+                 : transactor->send_command(read_fifo_command,
+                                            sizeof(read_fifo_command),
+                                            NOMINAL_READY_N_TIMEOUT_MS);
+}
+
+static struct Ex10Result command_read_fifo_chunk_start(
+    enum FifoSelection fifo_select,
+    size_t             fifo_len)
+{
+    return send_read_fifo_command(fifo_select, fifo_len, true);
+}
+
+static struct Ex10Result command_read_fifo_chunk_finish(uint8_t* data,
+                                                        size_t   fifo_len)
+{
+    if (data == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleCommands, Ex10SdkErrorNullPointer);
+    }
+
+    // The result code from the response will overwrite the byte prior to
+    // data; i.e. the last byte of the last fifo packet read into the buffer.
+    // Record its value so that it can be restored.
+    uint8_t* const response_ptr = data - 1;
+    uint8_t const  restore_byte = *response_ptr;
+
+    struct Ex10Result const ex10_result =
+        get_ex10_command_transactor()->receive_response(
+            response_ptr, fifo_len + 1u, NOMINAL_READY_N_TIMEOUT_MS);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    enum ResponseCode device_response = (enum ResponseCode)(*response_ptr);
+    if (device_response != Success)
+    {
+        return make_ex10_commands_w_resp_error(
+            device_response, CommandReadFifo, HostResultSuccess);
+    }
+
+    *response_ptr = restore_byte;
+    return ex10_result;
+}
+
 static struct Ex10Result command_read_fifo(enum FifoSelection fifo_select,
                                            struct ByteSpan*   bytes)
 {
@@ -401,47 +473,22 @@ static struct Ex10Result command_read_fifo(enum FifoSelection fifo_select,
     bytes->length                 = 0;
     while (fifo_bytes_remaining > 0u)
     {
-        // The EX10_SPI_BURST_SIZE is also the maximum response length
-        // with the response code byte. i.e. The total available bytes in
-        // the response can be one byte more than the maximum fifo_len.
         size_t const fifo_len = (fifo_bytes_remaining > EX10_SPI_BURST_SIZE - 1)
                                     ? EX10_SPI_BURST_SIZE - 1
                                     : fifo_bytes_remaining;
-        size_t const resp_len = fifo_len + 1u;
 
-        uint8_t const command[1u + sizeof(struct Ex10ReadFifoFormat)] = {
-            (uint8_t)CommandReadFifo,
-            (uint8_t)fifo_select,
-            (uint8_t)(fifo_len >> 0u),
-            (uint8_t)(fifo_len >> 8u)};
-        ex10_result = get_ex10_command_transactor()->send_command(
-            command, sizeof(command), NOMINAL_READY_N_TIMEOUT_MS);
+        ex10_result = send_read_fifo_command(fifo_select, fifo_len, false);
         if (ex10_result.error)
         {
             return ex10_result;
         }
 
-        // The result code from the response will overwrite the last byte of
-        // the last fifo packet read into the buffer.
-        // Record its value so that it can be restored.
-        uint8_t const restore_byte = *(--data_ptr);
-
-        ex10_result = get_ex10_command_transactor()->receive_response(
-            data_ptr, resp_len, NOMINAL_READY_N_TIMEOUT_MS);
+        ex10_result = command_read_fifo_chunk_finish(data_ptr, fifo_len);
         if (ex10_result.error)
         {
             return ex10_result;
         }
 
-        enum ResponseCode device_response = (enum ResponseCode)(*data_ptr);
-        if (device_response != Success)
-        {
-            return make_ex10_commands_w_resp_error(
-                device_response, CommandReadFifo, HostResultSuccess);
-        }
-
-        *data_ptr++ = restore_byte;
-
         // The next data_ptr position will transfer the response code into
         // the last byte of the last response byte transferred.
         data_ptr += fifo_len;
@@ -830,19 +877,21 @@ static struct Ex10Result command_insert_fifo_event(
 }
 
 static const struct Ex10Commands ex10_commands = {
-    .read                  = command_read,
-    .test_read             = command_test_read,
-    .write                 = command_write,
-    .read_fifo             = command_read_fifo,
-    .write_info_page       = command_write_info_page,
-    .start_upload          = command_start_upload,
-    .continue_upload       = command_continue_upload,
-    .complete_upload       = command_complete_upload,
-    .revalidate_main_image = command_revalidate_main_image,
-    .reset                 = command_reset,
-    .test_transfer         = test_transfer,
-    .create_fifo_event     = create_fifo_event,
-    .insert_fifo_event     = command_insert_fifo_event,
+    .read                   = command_read,
+    .test_read              = command_test_read,
+    .write                  = command_write,
+    .read_fifo              = command_read_fifo,
+    .read_fifo_chunk_start  = command_read_fifo_chunk_start,
+    .read_fifo_chunk_finish = command_read_fifo_chunk_finish,
+    .write_info_page        = command_write_info_page,
+    .start_upload           = command_start_upload,
+    .continue_upload        = command_continue_upload,
+    .complete_upload        = command_complete_upload,
+    .revalidate_main_image  = command_revalidate_main_image,
+    .reset                  = command_reset,
+    .test_transfer          = test_transfer,
+    .create_fifo_event      = create_fifo_event,
+    .insert_fifo_event      = command_insert_fifo_event,
 };
 
 struct Ex10Commands const* get_ex10_commands(void)
@@ -13,6 +13,7 @@
 
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "ex10_api/event_fifo_packet_types.h"
 #include "ex10_api/event_packet_parser.h"
@@ -31,6 +32,9 @@
 #define GEN2_REPLY_HANDLE_LENGTH_BYTES 2
 
 #define CRC_LENGTH_BYTES 2
+
+/// The number of 32-bit words in the packet type filter bitmap.
+#define PACKET_TYPE_FILTER_WORDS ((UINT8_MAX + 1u) / 32u)
 /*
  * Definitions of a tag's reply to ACK
  */
@@ -508,6 +512,7 @@ static struct EventFifoPacket parse_event_packet(struct ConstByteSpan* bytes)
         struct EventFifoPacket const invalid_packet = {
             .packet_type         = InvalidPacket,
             .us_counter          = 0,
+            .timestamp_us        = 0u,
             .static_data         = NULL,
             .static_data_length  = 0u,
             .dynamic_data        = NULL,
@@ -521,6 +526,7 @@ static struct EventFifoPacket parse_event_packet(struct ConstByteSpan* bytes)
     struct EventFifoPacket const packet = {
         .packet_type         = packet_header->packet_type,
         .us_counter          = packet_header->us_counter,
+        .timestamp_us        = 0u,
         .static_data         = static_data,
         .static_data_length  = static_data_length,
         .dynamic_data        = dynamic_data,
@@ -552,12 +558,112 @@ static struct PacketHeader make_packet_header(
     return packet_header;
 }
 
+/// When true, only the packet types set in packet_type_filter are delivered.
+static bool packet_filter_enabled = false;
+
+/// A bitmap of delivered packet types, indexed by EventPacketType.
+static uint32_t packet_type_filter[PACKET_TYPE_FILTER_WORDS];
+
+/// Packet types which the use case state machines always need to see.
+static enum EventPacketType const always_delivered_packet_types[] = {
+    InventoryRoundSummary,
+    ContinuousInventorySummary,
+    AggregateOpSummary,
+    Halted,
+    InvalidPacket,
+    FifoOverflowPacket,
+    Ex10ResultPacket,
+};
+
+static void packet_type_filter_set(enum EventPacketType packet_type)
+{
+    uint8_t const type = (uint8_t)packet_type;
+    packet_type_filter[type / 32u] |= (1u << (type % 32u));
+}
+
+static void set_packet_type_filter(enum EventPacketType const* packet_types,
+                                   size_t                      count)
+{
+    // Disable the filter while the bitmap is being rebuilt.
+    packet_filter_enabled = false;
+    for (size_t iter = 0u; iter < PACKET_TYPE_FILTER_WORDS; ++iter)
+    {
+        packet_type_filter[iter] = 0u;
+    }
+
+    if (packet_types == NULL)
+    {
+        return;
+    }
+
+    size_t const always_count = sizeof(always_delivered_packet_types) /
+                                sizeof(always_delivered_packet_types[0]);
+    for (size_t iter = 0u; iter < always_count; ++iter)
+    {
+        packet_type_filter_set(always_delivered_packet_types[iter]);
+    }
+    for (size_t iter = 0u; iter < count; ++iter)
+    {
+        packet_type_filter_set(packet_types[iter]);
+    }
+    packet_filter_enabled = true;
+}
+
+static bool get_packet_type_subscribed(enum EventPacketType packet_type)
+{
+    if (packet_filter_enabled == false ||
+        get_packet_type_valid(packet_type) == false)
+    {
+        return true;
+    }
+
+    uint8_t const type = (uint8_t)packet_type;
+    return (packet_type_filter[type / 32u] & (1u << (type % 32u))) != 0u;
+}
+
+static size_t skip_unsubscribed_packets(struct ConstByteSpan* bytes)
+{
+    size_t skip_count = 0u;
+    if (packet_filter_enabled == false)
+    {
+        return skip_count;
+    }
+
+    while (bytes->length >= sizeof(struct PacketHeader))
+    {
+        struct PacketHeader const* packet_header =
+            (struct PacketHeader const*)bytes->data;
+        size_t const packet_length_bytes =
+            packet_header->packet_length * sizeof(uint32_t);
+
+        // Malformed packets are left for parse_event_packet() to report.
+        bool const is_well_formed =
+            (packet_header->sha == event_fifo_sha) &&
+            (packet_length_bytes >= sizeof(struct PacketHeader)) &&
+            (packet_length_bytes <= bytes->length);
+        if ((is_well_formed == false) ||
+            get_packet_type_subscribed(packet_header->packet_type))
+        {
+            break;
+        }
+
+        bytes->data += packet_length_bytes;
+        bytes->length -= packet_length_bytes;
+        skip_count += 1u;
+    }
+
+    return skip_count;
+}
+
 static const struct Ex10EventParser ex10_event_parser = {
-    .get_tag_read_fields       = get_tag_read_fields,
-    .get_static_payload_length = get_static_payload_length,
-    .get_packet_type_valid     = get_packet_type_valid,
-    .parse_event_packet        = parse_event_packet,
-    .make_packet_header        = make_packet_header,
+    .get_tag_read_fields        = get_tag_read_fields,
+    .get_static_payload_length  = get_static_payload_length,
+    .get_packet_type_valid      = get_packet_type_valid,
+    .parse_event_packet         = parse_event_packet,
+    .make_packet_header         = make_packet_header,
+    .set_packet_type_filter     = set_packet_type_filter,
+    .get_packet_type_subscribed = get_packet_type_subscribed,
+    .skip_unsubscribed_packets  = skip_unsubscribed_packets,
 };
 
 struct Ex10EventParser const* get_ex10_event_parser(void)
@@ -0,0 +1,176 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "board/driver_list.h"
+#include "board/ex10_osal.h"
+#include "board/time_helpers.h"
+#include "ex10_api/ex10_boot_profiler.h"
+#include "ex10_api/ex10_print.h"
+
+/// Marks an open phase which could not be recorded.
+#define DROPPED_PHASE SIZE_MAX
+
+static bool                 profiler_running = false;
+static struct Ex10BootPhase phases[BOOT_PROFILER_MAX_PHASES];
+static size_t               phase_count   = 0u;
+static size_t               dropped_count = 0u;
+
+/// The SPI transfer count at the start of each open phase.
+static uint32_t phase_start_transfers[BOOT_PROFILER_MAX_PHASES];
+
+/// The phases index of each open phase, innermost last.
+static size_t open_phases[BOOT_PROFILER_MAX_DEPTH];
+static size_t open_count = 0u;
+
+static uint32_t get_spi_transfer_count(void)
+{
+    struct HostInterface const* host_if =
+        &get_ex10_board_driver_list()->host_if;
+    return (host_if->get_transfer_count != NULL)
+               ? host_if->get_transfer_count()
+               : 0u;
+}
+
+static void end_phase(void)
+{
+    if (profiler_running == false || open_count == 0u)
+    {
+        return;
+    }
+
+    open_count -= 1u;
+    if (open_count >= BOOT_PROFILER_MAX_DEPTH ||
+        open_phases[open_count] == DROPPED_PHASE)
+    {
+        return;
+    }
+
+    size_t const          index = open_phases[open_count];
+    struct Ex10BootPhase* phase = &phases[index];
+    phase->duration_us =
+        get_ex10_time_helpers()->time_now_us() - phase->start_us;
+    phase->spi_transfers =
+        get_spi_transfer_count() - phase_start_transfers[index];
+}
+
+static void start(void)
+{
+    ex10_memzero(phases, sizeof(phases));
+    phase_count      = 0u;
+    dropped_count    = 0u;
+    open_count       = 0u;
+    profiler_running = true;
+}
+
+static void stop(void)
+{
+    while (open_count > 0u)
+    {
+        end_phase();
+    }
+    profiler_running = false;
+}
+
+static void begin_phase(char const* name)
+{
+    if (profiler_running == false)
+    {
+        return;
+    }
+
+    size_t const depth = open_count;
+    open_count += 1u;
+    if (depth >= BOOT_PROFILER_MAX_DEPTH)
+    {
+        dropped_count += 1u;
+        return;
+    }
+    if (phase_count >= BOOT_PROFILER_MAX_PHASES)
+    {
+        dropped_count += 1u;
+        open_phases[depth] = DROPPED_PHASE;
+        return;
+    }
+
+    size_t const index = phase_count;
+    phase_count += 1u;
+    open_phases[depth] = index;
+
+    struct Ex10BootPhase* phase = &phases[index];
+    phase->name                 = name;
+    phase->depth                = (uint8_t)depth;
+    phase->duration_us          = 0u;
+    phase->spi_transfers        = 0u;
+
+    phase_start_transfers[index] = get_spi_transfer_count();
+    phase->start_us = get_ex10_time_helpers()->time_now_us();
+}
+
+static size_t get_phase_count(void)
+{
+    return phase_count;
+}
+
+static struct Ex10BootPhase const* get_phase(size_t index)
+{
+    return (index < phase_count) ? &phases[index] : NULL;
+}
+
+static size_t get_dropped_count(void)
+{
+    return dropped_count;
+}
+
+static void print_phases(void)
+{
+    ex10_printf("%10s %10s %10s   %s\n",
+                "start us",
+                "time us",
+                "spi xfers",
+                "boot phase");
+    for (size_t index = 0u; index < phase_count; ++index)
+    {
+        struct Ex10BootPhase const* phase = &phases[index];
+        ex10_printf("%10u %10u %10u   %*s%s\n",
+                    phase->start_us,
+                    phase->duration_us,
+                    phase->spi_transfers,
+                    2 * (int)phase->depth,
+                    "",
+                    phase->name);
+    }
+    if (dropped_count > 0u)
+    {
+        ex10_printf("Boot phases not recorded: %zu\n", dropped_count);
+    }
+}
+
+static const struct Ex10BootProfiler ex10_boot_profiler = {
+    .start             = start,
+    .stop              = stop,
+    .begin_phase       = begin_phase,
+    .end_phase         = end_phase,
+    .get_phase_count   = get_phase_count,
+    .get_phase         = get_phase,
+    .get_dropped_count = get_dropped_count,
+    .print_phases      = print_phases,
+};
+
+struct Ex10BootProfiler const* get_ex10_boot_profiler(void)
+{
+    return &ex10_boot_profiler;
+}
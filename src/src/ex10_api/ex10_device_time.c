@@ -11,15 +11,151 @@
  *                                                                           *
  *****************************************************************************/
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "board/ex10_osal.h"
+#include "board/time_helpers.h"
 #include "ex10_api/aggregate_op_builder.h"
 #include "ex10_api/application_registers.h"
 #include "ex10_api/ex10_device_time.h"
 #include "ex10_api/ex10_ops.h"
 #include "ex10_api/ex10_protocol.h"
 
+/// A device us_counter which differs from the host uptime timeline by more
+/// than this when anchored is taken to have been reset.
+#define US_COUNTER_ANCHOR_TOLERANCE_US ((int64_t)1000000)
+
+/**
+ * @struct UsCounterAnchor
+ * Ties a device us_counter value to a host uptime and a 64-bit timestamp.
+ */
+struct UsCounterAnchor
+{
+    bool     is_set;
+    uint32_t us_counter;
+    uint32_t host_time_ms;
+    uint64_t timestamp_us;
+    /// The latest timestamp returned; a new timeline never starts before it.
+    uint64_t latest_timestamp_us;
+};
+
+static struct UsCounterAnchor us_counter_anchor = {
+    .is_set              = false,
+    .us_counter          = 0u,
+    .host_time_ms        = 0u,
+    .timestamp_us        = 0u,
+    .latest_timestamp_us = 0u,
+};
+
+/// Guards us_counter_anchor, which the IRQ_N monitor thread reads and the
+/// use cases set.
+static ex10_mutex_t anchor_mutex = EX10_MUTEX_INITIALIZER;
+
+/**
+ * Get the signed offset of a us_counter value from the value expected at
+ * the passed host time, given the anchor.
+ */
+static int32_t us_counter_offset(uint32_t us_counter, uint32_t host_time_ms)
+{
+    // Unsigned arithmetic resolves both the host and device counter wraps.
+    uint32_t const host_elapsed_ms =
+        host_time_ms - us_counter_anchor.host_time_ms;
+    uint32_t const expected_us_counter =
+        us_counter_anchor.us_counter + host_elapsed_ms * 1000u;
+    return (int32_t)(us_counter - expected_us_counter);
+}
+
+/**
+ * Get the timestamp expected at the passed host time, given the anchor.
+ */
+static uint64_t expected_timestamp_us(uint32_t host_time_ms)
+{
+    uint32_t const host_elapsed_ms =
+        host_time_ms - us_counter_anchor.host_time_ms;
+    return us_counter_anchor.timestamp_us + (uint64_t)host_elapsed_ms * 1000u;
+}
+
+static uint64_t offset_timestamp_us(uint64_t timestamp_us, int32_t offset_us)
+{
+    // Values from before the start of the timeline are clamped to it.
+    if ((offset_us < 0) && ((uint64_t)(-(int64_t)offset_us) > timestamp_us))
+    {
+        return 0u;
+    }
+    return (uint64_t)((int64_t)timestamp_us + offset_us);
+}
+
+static void note_timestamp_us(uint64_t timestamp_us)
+{
+    if (timestamp_us > us_counter_anchor.latest_timestamp_us)
+    {
+        us_counter_anchor.latest_timestamp_us = timestamp_us;
+    }
+}
+
+/**
+ * Set the anchor. The caller must hold anchor_mutex.
+ */
+static uint64_t anchor_us_counter_locked(uint32_t us_counter)
+{
+    uint32_t const host_time_ms = get_ex10_time_helpers()->time_now();
+
+    uint64_t timestamp_us = (uint64_t)host_time_ms * 1000u;
+    if (us_counter_anchor.is_set)
+    {
+        int32_t const offset_us = us_counter_offset(us_counter, host_time_ms);
+        timestamp_us            = expected_timestamp_us(host_time_ms);
+        if ((offset_us < US_COUNTER_ANCHOR_TOLERANCE_US) &&
+            (offset_us > -US_COUNTER_ANCHOR_TOLERANCE_US))
+        {
+            // The device counter is on the existing timeline.
+            timestamp_us = offset_timestamp_us(timestamp_us, offset_us);
+        }
+        else if (timestamp_us <= us_counter_anchor.latest_timestamp_us)
+        {
+            // The device counter was reset. The new timeline follows host
+            // time, but never starts at or before a timestamp already
+            // returned, so timestamps only move forward.
+            timestamp_us = us_counter_anchor.latest_timestamp_us + 1u;
+        }
+    }
+
+    us_counter_anchor.us_counter   = us_counter;
+    us_counter_anchor.host_time_ms = host_time_ms;
+    us_counter_anchor.timestamp_us = timestamp_us;
+    us_counter_anchor.is_set       = true;
+    note_timestamp_us(timestamp_us);
+    return timestamp_us;
+}
+
+static uint64_t anchor_us_counter(uint32_t us_counter)
+{
+    ex10_mutex_lock(&anchor_mutex);
+    uint64_t const timestamp_us = anchor_us_counter_locked(us_counter);
+    ex10_mutex_unlock(&anchor_mutex);
+    return timestamp_us;
+}
+
+static uint64_t extend_us_counter(uint32_t us_counter)
+{
+    ex10_mutex_lock(&anchor_mutex);
+    uint64_t timestamp_us = 0u;
+    if (us_counter_anchor.is_set == false)
+    {
+        timestamp_us = anchor_us_counter_locked(us_counter);
+    }
+    else
+    {
+        uint32_t const host_time_ms = get_ex10_time_helpers()->time_now();
+        timestamp_us =
+            offset_timestamp_us(expected_timestamp_us(host_time_ms),
+                                us_counter_offset(us_counter, host_time_ms));
+        note_timestamp_us(timestamp_us);
+    }
+    ex10_mutex_unlock(&anchor_mutex);
+    return timestamp_us;
+}
 
 static uint32_t ex10_time_now(void)
 {
@@ -99,6 +235,8 @@ static struct Ex10DeviceTime ex10_device_time = {
     .window_time_elapsed = ex10_window_time_elapsed,
     .time_elapsed        = ex10_time_elapsed,
     .wait_ms             = ex10_wait_ms,
+    .anchor_us_counter   = anchor_us_counter,
+    .extend_us_counter   = extend_us_counter,
 };
 
 struct Ex10DeviceTime* get_ex10_device_time(void)
@@ -11,31 +11,75 @@
  *                                                                           *
  *****************************************************************************/
 
+#include <assert.h>
 #include <errno.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 
 #include "board/ex10_osal.h"
+#include "board/fifo_buffer_pool.h"
 #include "ex10_api/byte_span.h"
 #include "ex10_api/event_fifo_packet_types.h"
 #include "ex10_api/event_packet_parser.h"
+#include "ex10_api/ex10_device_time.h"
 #include "ex10_api/ex10_event_fifo_queue.h"
+#include "ex10_api/ex10_event_pipeline_monitor.h"
+#include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_protocol.h"
 #include "ex10_api/linked_list.h"
 
 static struct ConstByteSpan event_packets_iterator = {.data   = NULL,
                                                       .length = 0u};
 
+/// The packet index of the FifoBufferNode being iterated, and the position
+/// of the next entry to use.
+static struct FifoBufferNode const* indexed_buffer = NULL;
+static size_t                       index_position = 0u;
+
 static struct EventFifoPacket        event_packet;
+/// The packets returned by packet_peek_batch() until packet_remove_batch().
+static struct EventFifoPacket batch_packets[EVENT_FIFO_PACKET_BATCH_SIZE];
+static size_t                 batch_count = 0u;
 static struct Ex10LinkedList         event_fifo_list;
-static struct Ex10EventParser const* event_parser = NULL;
+/// The number of nodes on event_fifo_list; guarded by the list_mutex.
+static size_t                        event_fifo_list_depth = 0u;
+static struct Ex10EventParser const* event_parser          = NULL;
 /// Guards access to the fifo_buffer_list within this same structure.
 static ex10_mutex_t list_mutex = EX10_MUTEX_INITIALIZER;
 static ex10_cond_t  list_cond  = EX10_COND_INITIALIZER;
 
+/**
+ * The capacity of the single producer, single consumer ring used when
+ * ring_mode is enabled. It must be a power of two and larger than the number
+ * of FifoBufferNode elements in the event and result buffer pools so that a
+ * push onto the ring cannot fail.
+ */
+#define EVENT_FIFO_RING_SIZE ((size_t)32u)
+static_assert((EVENT_FIFO_RING_SIZE & (EVENT_FIFO_RING_SIZE - 1u)) == 0u,
+              "EVENT_FIFO_RING_SIZE must be a power of two");
+
+/// When true, nodes are passed through ring_nodes rather than
+/// event_fifo_list and the list_mutex is not used on the hot path.
+static bool ring_mode = false;
+
+static struct FifoBufferNode* ring_nodes[EVENT_FIFO_RING_SIZE];
+/// The next ring slot to write; only written by the producer, the IRQ_N
+/// monitor thread.
+static atomic_size_t ring_tail;
+/// The next ring slot to read; only written by the packet consumer.
+static atomic_size_t ring_head;
+/// Set by the consumer while it is blocked, or about to block, on list_cond.
+static atomic_bool consumer_waiting;
+/// An Ex10ResultPacket node created on the consumer thread within
+/// event_fifo_buffer_pop(). It is delivered ahead of the ring contents
+/// since the consumer must not push onto the ring.
+static struct FifoBufferNode* consumer_node = NULL;
+
 
 static struct EventFifoPacket const invalid_event_packet = {
     .packet_type         = InvalidPacket,
     .us_counter          = 0u,
+    .timestamp_us        = 0u,
     .static_data         = NULL,
     .static_data_length  = 0u,
     .dynamic_data        = NULL,
@@ -43,20 +87,121 @@ static struct EventFifoPacket const invalid_event_packet = {
     .is_valid            = false,
 };
 
+static void ring_reset(void)
+{
+    atomic_store(&ring_tail, 0u);
+    atomic_store(&ring_head, 0u);
+    atomic_store(&consumer_waiting, false);
+    consumer_node = NULL;
+}
+
 static void init(void)
 {
     list_init(&event_fifo_list);
+    event_fifo_list_depth = 0u;
+    ring_reset();
+    ring_mode                     = false;
     event_packets_iterator.data   = NULL;
     event_packets_iterator.length = 0u;
+    indexed_buffer                = NULL;
+    index_position                = 0u;
     event_packet                  = invalid_event_packet;
+    batch_count                   = 0u;
     event_parser                  = get_ex10_event_parser();
+
+    // A packet type filter is installed by the use case which owns the queue.
+    event_parser->set_packet_type_filter(NULL, 0u);
+}
+
+/**
+ * Push a FifoBufferNode onto the ring. Only the IRQ_N monitor thread may call
+ * this function. The list_mutex is only taken when the consumer is waiting
+ * for packets.
+ */
+static void ring_push_back(struct FifoBufferNode* fifo_buffer_node)
+{
+    size_t const tail = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+    size_t const head = atomic_load_explicit(&ring_head, memory_order_acquire);
+    if (tail - head >= EVENT_FIFO_RING_SIZE)
+    {
+        // Not possible when the ring is larger than the buffer pools.
+        ex10_eprintf("EventFifo ring full, dropping FifoBufferNode\n");
+        ex10_release_buffer_node(fifo_buffer_node);
+        return;
+    }
+
+    ring_nodes[tail & (EVENT_FIFO_RING_SIZE - 1u)] = fifo_buffer_node;
+
+    // The sequentially consistent store of ring_tail followed by the load of
+    // consumer_waiting pairs with the store of consumer_waiting followed by
+    // the load of ring_tail in ring_wait(): at least one side observes the
+    // other, so a wakeup cannot be lost.
+    atomic_store(&ring_tail, tail + 1u);
+    get_ex10_event_pipeline_monitor()->record_queue_depth(tail + 1u - head);
+    if (atomic_load(&consumer_waiting))
+    {
+        ex10_mutex_lock(&list_mutex);
+        ex10_cond_signal(&list_cond);
+        ex10_mutex_unlock(&list_mutex);
+    }
+}
+
+static struct FifoBufferNode* ring_front(void)
+{
+    if (consumer_node != NULL)
+    {
+        return consumer_node;
+    }
+
+    size_t const head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    size_t const tail = atomic_load(&ring_tail);
+    return (head != tail) ? ring_nodes[head & (EVENT_FIFO_RING_SIZE - 1u)]
+                          : NULL;
+}
+
+static struct FifoBufferNode* ring_pop_front(void)
+{
+    struct FifoBufferNode* fifo_buffer_node = ring_front();
+    if (fifo_buffer_node == consumer_node)
+    {
+        consumer_node = NULL;
+    }
+    else if (fifo_buffer_node != NULL)
+    {
+        size_t const head =
+            atomic_load_explicit(&ring_head, memory_order_relaxed);
+        atomic_store_explicit(&ring_head, head + 1u, memory_order_release);
+    }
+    return fifo_buffer_node;
+}
+
+static bool queue_is_empty(void)
+{
+    if (ring_mode)
+    {
+        return ring_front() == NULL;
+    }
+
+    ex10_mutex_lock(&list_mutex);
+    bool const is_empty = list_is_empty(&event_fifo_list);
+    ex10_mutex_unlock(&list_mutex);
+    return is_empty;
 }
 
 static void list_node_push_back(struct FifoBufferNode* fifo_buffer_node)
 {
+    if (ring_mode)
+    {
+        ring_push_back(fifo_buffer_node);
+        return;
+    }
+
     ex10_mutex_lock(&list_mutex);
     list_push_back(&event_fifo_list, &fifo_buffer_node->list_node);
+    event_fifo_list_depth += 1u;
+    size_t const depth = event_fifo_list_depth;
     ex10_mutex_unlock(&list_mutex);
+    get_ex10_event_pipeline_monitor()->record_queue_depth(depth);
     ex10_cond_signal(&list_cond);
 }
 
@@ -71,6 +216,11 @@ static void list_node_push_back(struct FifoBufferNode* fifo_buffer_node)
  */
 static struct FifoBufferNode* list_node_pop_front(void)
 {
+    if (ring_mode)
+    {
+        return ring_pop_front();
+    }
+
     struct FifoBufferNode* fifo_buffer_node = NULL;
 
     ex10_mutex_lock(&list_mutex);
@@ -81,6 +231,7 @@ static struct FifoBufferNode* list_node_pop_front(void)
     if (list_node->data)
     {
         list_pop_front(&event_fifo_list);
+        event_fifo_list_depth -= 1u;
         fifo_buffer_node = (struct FifoBufferNode*)list_node->data;
     }
     ex10_mutex_unlock(&list_mutex);
@@ -90,6 +241,11 @@ static struct FifoBufferNode* list_node_pop_front(void)
 
 static struct FifoBufferNode const* event_fifo_buffer_peek(void)
 {
+    if (ring_mode)
+    {
+        return ring_front();
+    }
+
     // If the node is a sentinel node then list_node->data will be NULL
     // indicating that there are no buffers in the list.
     ex10_mutex_lock(&list_mutex);
@@ -125,7 +281,13 @@ static void event_fifo_buffer_pop(void)
             struct FifoBufferNode* result_buffer_node =
                 make_ex10_result_fifo_packet(ex10_result, 0);
 
-            if (result_buffer_node)
+            if (result_buffer_node && ring_mode)
+            {
+                // This is the consumer thread, which must not push onto
+                // the ring. Deliver the Ex10ResultPacket next instead.
+                consumer_node = result_buffer_node;
+            }
+            else if (result_buffer_node)
             {
                 // The Ex10ResultPacket will be placed into the
                 // list with full details on the encountered error.
@@ -143,9 +305,112 @@ static void event_fifo_buffer_pop(void)
     }
 }
 
+/**
+ * Build the EventFifoPacket for the next packet using the packet index
+ * recorded for the current FifoBufferNode. The indexed packet was validated
+ * when the index was recorded, so only the packet bounds are taken from the
+ * packet header.
+ *
+ * @param bytes  The packet iterator, which is advanced past the packet.
+ * @param packet The packet to fill in.
+ *
+ * @return bool true if the packet was taken from the index, false if the
+ *              packet must be parsed.
+ */
+static bool next_indexed_packet(struct ConstByteSpan*   bytes,
+                                struct EventFifoPacket* packet)
+{
+    if ((indexed_buffer == NULL) ||
+        (index_position >= indexed_buffer->packet_index.count))
+    {
+        return false;
+    }
+
+    // Step over the entries of packets skipped by the packet type filter.
+    size_t const offset =
+        (size_t)(bytes->data - indexed_buffer->fifo_data.data);
+    while ((index_position < indexed_buffer->packet_index.count) &&
+           (indexed_buffer->packet_index.entries[index_position].offset <
+            offset))
+    {
+        index_position += 1u;
+    }
+    if (index_position >= indexed_buffer->packet_index.count)
+    {
+        return false;
+    }
+
+    struct FifoPacketIndexEntry const* entry =
+        &indexed_buffer->packet_index.entries[index_position];
+    if (offset != entry->offset)
+    {
+        // The iterator is out of step with the index; parse the remainder.
+        indexed_buffer = NULL;
+        return false;
+    }
+
+    struct PacketHeader const* packet_header =
+        (struct PacketHeader const*)bytes->data;
+    size_t const packet_length_bytes =
+        packet_header->packet_length * sizeof(uint32_t);
+    size_t const min_packet_length =
+        sizeof(struct PacketHeader) + entry->static_data_length;
+
+    packet->packet_type = (enum EventPacketType)entry->packet_type;
+    packet->us_counter  = packet_header->us_counter;
+    packet->static_data =
+        (union PacketData const*)(bytes->data + sizeof(struct PacketHeader));
+    packet->static_data_length = entry->static_data_length;
+    if (entry->static_data_length > 0u)
+    {
+        packet->dynamic_data        = bytes->data + min_packet_length;
+        packet->dynamic_data_length = packet_length_bytes - min_packet_length;
+    }
+    else
+    {
+        packet->dynamic_data        = NULL;
+        packet->dynamic_data_length = 0u;
+    }
+    packet->is_valid = true;
+
+    bytes->data += packet_length_bytes;
+    bytes->length -= packet_length_bytes;
+    index_position += 1u;
+    return true;
+}
+
+/**
+ * Parse the packet at the front of the iterator, using the packet index when
+ * it covers the packet.
+ */
+static void parse_packet(struct ConstByteSpan*   bytes,
+                         struct EventFifoPacket* packet)
+{
+    // Packets which were not indexed by the fifo data handler, if any,
+    // are parsed and validated here.
+    if (next_indexed_packet(bytes, packet) == false)
+    {
+        *packet = event_parser->parse_event_packet(bytes);
+    }
+
+    if (packet->is_valid)
+    {
+        packet->timestamp_us =
+            get_ex10_device_time()->extend_us_counter(packet->us_counter);
+    }
+
+    if (packet->packet_type == FifoOverflowPacket)
+    {
+        get_ex10_event_pipeline_monitor()->record_overflow_packet();
+    }
+}
+
 static void parse_next_event_fifo_packet(void)
 {
-    if (event_packets_iterator.length == 0u)
+    // Packets removed by the packet type filter are skipped using only their
+    // headers; a node holding only skipped packets is released here.
+    event_parser->skip_unsubscribed_packets(&event_packets_iterator);
+    while (event_packets_iterator.length == 0u)
     {
         // The iterator has reached the end of a buffer node or
         // it is not pointing to a node.
@@ -162,22 +427,25 @@ static void parse_next_event_fifo_packet(void)
         }
 
         struct FifoBufferNode const* fifo_buffer = event_fifo_buffer_peek();
-        if (fifo_buffer != NULL)
-        {
-            event_packets_iterator = fifo_buffer->fifo_data;
-        }
-        else
+        index_position                           = 0u;
+        if (fifo_buffer == NULL)
         {
             // There were no FifoBufferNode elements in the list.
             event_packets_iterator.data   = NULL;
             event_packets_iterator.length = 0u;
+            indexed_buffer                = NULL;
+            break;
         }
+
+        event_packets_iterator = fifo_buffer->fifo_data;
+        indexed_buffer         = fifo_buffer;
+        get_ex10_event_pipeline_monitor()->record_dequeue(fifo_buffer);
+        event_parser->skip_unsubscribed_packets(&event_packets_iterator);
     }
 
     if (event_packets_iterator.length > 0u)
     {
-        event_packet =
-            event_parser->parse_event_packet(&event_packets_iterator);
+        parse_packet(&event_packets_iterator, &event_packet);
     }
     else
     {
@@ -210,8 +478,87 @@ static void packet_remove(void)
     parse_next_event_fifo_packet();
 }
 
+static size_t packet_peek_batch(struct EventFifoPacket const** packets)
+{
+    if (batch_count == 0u)
+    {
+        struct EventFifoPacket const* packet = packet_peek();
+        if (packet == NULL)
+        {
+            *packets = NULL;
+            return 0u;
+        }
+
+        // The front packet has been parsed; parse the rest of its
+        // FifoBufferNode, without moving to the next node.
+        batch_packets[0u] = *packet;
+        batch_count       = 1u;
+        while ((event_packets_iterator.length > 0u) &&
+               (batch_count < EVENT_FIFO_PACKET_BATCH_SIZE))
+        {
+            event_parser->skip_unsubscribed_packets(&event_packets_iterator);
+            if (event_packets_iterator.length == 0u)
+            {
+                break;
+            }
+            parse_packet(&event_packets_iterator, &batch_packets[batch_count]);
+            batch_count += 1u;
+        }
+    }
+
+    *packets = batch_packets;
+    return batch_count;
+}
+
+static void packet_remove_batch(void)
+{
+    if (batch_count > 0u)
+    {
+        batch_count = 0u;
+        parse_next_event_fifo_packet();
+    }
+}
+
+/**
+ * Block the consumer until a node is available on the ring.
+ *
+ * @param use_timeout If false, wait without a timeout.
+ * @param timeout_us  The wait timeout.
+ *
+ * @return bool true if the timeout expired without packets being available.
+ */
+static bool ring_wait(bool use_timeout, uint32_t timeout_us)
+{
+    bool timeout_expired = false;
+    ex10_mutex_lock(&list_mutex);
+    atomic_store(&consumer_waiting, true);
+    while ((event_packets_iterator.data == NULL) && (ring_front() == NULL) &&
+           (timeout_expired == false))
+    {
+        if (use_timeout == false)
+        {
+            ex10_cond_wait(&list_cond, &list_mutex);
+        }
+        else
+        {
+            int const result =
+                ex10_cond_timed_wait_us(&list_cond, &list_mutex, timeout_us);
+            timeout_expired = (result == ETIMEDOUT);
+        }
+    }
+    atomic_store(&consumer_waiting, false);
+    ex10_mutex_unlock(&list_mutex);
+    return timeout_expired;
+}
+
 static void packet_wait(void)
 {
+    if (ring_mode)
+    {
+        ring_wait(false, 0u);
+        return;
+    }
+
     ex10_mutex_lock(&list_mutex);
     while ((event_packets_iterator.data == NULL) &&
            list_is_empty(&event_fifo_list))
@@ -223,6 +570,11 @@ static void packet_wait(void)
 
 static bool packet_wait_with_timeout(uint32_t timeout_us)
 {
+    if (ring_mode)
+    {
+        return ring_wait(true, timeout_us);
+    }
+
     bool timeout_expired = false;
     ex10_mutex_lock(&list_mutex);
     while ((event_packets_iterator.data == NULL) &&
@@ -241,14 +593,45 @@ static void packet_unwait(void)
     ex10_cond_signal(&list_cond);
 }
 
+static struct Ex10Result enable_ring_mode(bool enable)
+{
+    if (enable == ring_mode)
+    {
+        return make_ex10_success();
+    }
+
+    // The mode can only be changed while no nodes are held by the queue.
+    if ((event_packets_iterator.data != NULL) || (queue_is_empty() == false))
+    {
+        return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
+                                   Ex10SdkErrorInvalidState);
+    }
+
+    size_t const node_count =
+        get_ex10_event_fifo_buffer_pool()->buffer_count +
+        get_ex10_result_buffer_pool()->buffer_count;
+    if (enable && (node_count >= EVENT_FIFO_RING_SIZE))
+    {
+        return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
+                                   Ex10SdkErrorBadParamLength);
+    }
+
+    ring_reset();
+    ring_mode = enable;
+    return make_ex10_success();
+}
+
 static const struct Ex10EventFifoQueue event_fifo_queue = {
     .init                     = init,
     .list_node_push_back      = list_node_push_back,
     .packet_peek              = packet_peek,
     .packet_remove            = packet_remove,
+    .packet_peek_batch        = packet_peek_batch,
+    .packet_remove_batch      = packet_remove_batch,
     .packet_wait              = packet_wait,
     .packet_wait_with_timeout = packet_wait_with_timeout,
     .packet_unwait            = packet_unwait,
+    .enable_ring_mode         = enable_ring_mode,
 };
 
 const struct Ex10EventFifoQueue* get_ex10_event_fifo_queue(void)
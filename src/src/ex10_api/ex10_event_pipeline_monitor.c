@@ -0,0 +1,181 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2020 - 2024 Impinj, Inc. All rights reserved.               *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "board/ex10_osal.h"
+#include "board/time_helpers.h"
+#include "ex10_api/ex10_event_pipeline_monitor.h"
+#include "ex10_api/ex10_print.h"
+
+static struct Ex10EventPipelineStats pipeline_stats;
+
+static void reset_stats(void)
+{
+    ex10_memzero(&pipeline_stats, sizeof(pipeline_stats));
+    pipeline_stats.free_list_low_water = SIZE_MAX;
+}
+
+static void init(void)
+{
+    reset_stats();
+}
+
+static void record_irq(void)
+{
+    pipeline_stats.irq_count += 1u;
+}
+
+static void record_drain(size_t num_bytes)
+{
+    pipeline_stats.drain_count += 1u;
+    pipeline_stats.drain_bytes += num_bytes;
+    if (num_bytes > pipeline_stats.drain_bytes_max)
+    {
+        pipeline_stats.drain_bytes_max = (uint32_t)num_bytes;
+    }
+
+    size_t bin   = 0u;
+    size_t limit = EVENT_PIPELINE_DRAIN_HISTOGRAM_MIN;
+    while ((bin + 1u < EVENT_PIPELINE_DRAIN_HISTOGRAM_BINS) &&
+           (num_bytes >= limit))
+    {
+        bin += 1u;
+        limit *= 2u;
+    }
+    pipeline_stats.drain_histogram[bin] += 1u;
+}
+
+static void record_free_list_size(size_t free_count)
+{
+    if (free_count < pipeline_stats.free_list_low_water)
+    {
+        pipeline_stats.free_list_low_water = free_count;
+    }
+}
+
+static void record_free_list_empty(void)
+{
+    pipeline_stats.free_list_empty_count += 1u;
+    pipeline_stats.free_list_low_water = 0u;
+}
+
+static void record_queue_depth(size_t depth)
+{
+    if (depth > pipeline_stats.queue_depth_high_water)
+    {
+        pipeline_stats.queue_depth_high_water = depth;
+    }
+}
+
+static void record_overflow_packet(void)
+{
+    pipeline_stats.overflow_packets += 1u;
+}
+
+static void record_dequeue(struct FifoBufferNode const* fifo_buffer_node)
+{
+    if (fifo_buffer_node->irq_time_us == 0u)
+    {
+        return;
+    }
+
+    uint32_t const latency_us = get_ex10_time_helpers()->time_now_us() -
+                                fifo_buffer_node->irq_time_us;
+    pipeline_stats.latency_count += 1u;
+    pipeline_stats.latency_total_us += latency_us;
+    if (latency_us > pipeline_stats.latency_max_us)
+    {
+        pipeline_stats.latency_max_us = latency_us;
+    }
+}
+
+static void get_stats(struct Ex10EventPipelineStats* stats)
+{
+    if (stats != NULL)
+    {
+        *stats = pipeline_stats;
+    }
+}
+
+static void print_stats(void)
+{
+    struct Ex10EventPipelineStats const stats = pipeline_stats;
+
+    uint32_t const mean_drain_bytes =
+        (stats.drain_count > 0u)
+            ? (uint32_t)(stats.drain_bytes / stats.drain_count)
+            : 0u;
+    ex10_printf("EventFifo pipeline: irqs: %u, drains: %u, mean: %u bytes, "
+                "max: %u bytes\n",
+                stats.irq_count,
+                stats.drain_count,
+                mean_drain_bytes,
+                stats.drain_bytes_max);
+
+    // The last bin counts all drains at or above the limit of the one
+    // before it.
+    size_t const last_bin = EVENT_PIPELINE_DRAIN_HISTOGRAM_BINS - 1u;
+    size_t       limit    = EVENT_PIPELINE_DRAIN_HISTOGRAM_MIN;
+    ex10_printf("Drain bytes:");
+    for (size_t bin = 0u; bin < last_bin; ++bin)
+    {
+        ex10_printf(" <%zu: %u,", limit, stats.drain_histogram[bin]);
+        limit *= 2u;
+    }
+    ex10_printf(
+        " >=%zu: %u\n", limit / 2u, stats.drain_histogram[last_bin]);
+
+    if (stats.free_list_low_water == SIZE_MAX)
+    {
+        ex10_printf("Free buffers low-water: none taken, ");
+    }
+    else
+    {
+        ex10_printf("Free buffers low-water: %zu, ",
+                    stats.free_list_low_water);
+    }
+    ex10_printf("empty: %u, queue depth high-water: %zu\n",
+                stats.free_list_empty_count,
+                stats.queue_depth_high_water);
+
+    uint32_t const mean_latency_us =
+        (stats.latency_count > 0u)
+            ? (uint32_t)(stats.latency_total_us / stats.latency_count)
+            : 0u;
+    ex10_printf("Overflow packets: %u, IRQ_N to dequeue: mean: %u us, "
+                "max: %u us\n",
+                stats.overflow_packets,
+                mean_latency_us,
+                stats.latency_max_us);
+}
+
+static const struct Ex10EventPipelineMonitor ex10_event_pipeline_monitor = {
+    .init                   = init,
+    .record_irq             = record_irq,
+    .record_drain           = record_drain,
+    .record_free_list_size  = record_free_list_size,
+    .record_free_list_empty = record_free_list_empty,
+    .record_queue_depth     = record_queue_depth,
+    .record_overflow_packet = record_overflow_packet,
+    .record_dequeue         = record_dequeue,
+    .get_stats              = get_stats,
+    .reset_stats            = reset_stats,
+    .print_stats            = print_stats,
+};
+
+struct Ex10EventPipelineMonitor const* get_ex10_event_pipeline_monitor(void)
+{
+    return &ex10_event_pipeline_monitor;
+}
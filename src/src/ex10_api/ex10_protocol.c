@@ -27,9 +27,11 @@
 #include "ex10_api/commands.h"
 #include "ex10_api/crc16.h"
 #include "ex10_api/event_fifo_packet_types.h"
+#include "ex10_api/ex10_event_pipeline_monitor.h"
 #include "ex10_api/ex10_macros.h"
 #include "ex10_api/ex10_print.h"
 #include "ex10_api/ex10_protocol.h"
+#include "ex10_api/ex10_register_cache.h"
 #include "ex10_api/fifo_buffer_list.h"
 #include "ex10_api/gpio_interface.h"
 #include "ex10_api/trace.h"
@@ -49,11 +51,74 @@ static struct InterruptMaskFields const irq_mask_clear = {
 static void (*fifo_data_callback)(struct FifoBufferNode*)       = NULL;
 static bool (*interrupt_callback)(struct InterruptStatusFields) = NULL;
 
-static struct Ex10GpioInterface const*     _gpio_if                 = NULL;
-static struct HostInterface const*         _host_if                 = NULL;
-static struct Ex10Commands const*          _ex10_commands           = NULL;
-static struct Ex10CommandTransactor const* _ex10_command_transactor = NULL;
-static struct FifoBufferList const*        _fifo_buffer_list        = NULL;
+static struct Ex10GpioInterface const*        _gpio_if                 = NULL;
+static struct HostInterface const*            _host_if                 = NULL;
+static struct Ex10Commands const*             _ex10_commands           = NULL;
+static struct Ex10CommandTransactor const*    _ex10_command_transactor = NULL;
+static struct FifoBufferList const*           _fifo_buffer_list        = NULL;
+static struct Ex10RegisterCache const*        _register_cache          = NULL;
+static struct Ex10EventPipelineMonitor const* _pipeline_monitor        = NULL;
+
+// The time_now_us() value taken at the start of the current interrupt.
+static uint32_t irq_time_us = 0u;
+
+// When true, the EventFifo is drained by read_event_fifo_pipelined().
+static bool pipelined_fifo_drain = false;
+
+/// The limits used when enable_adaptive_event_fifo_threshold() is not
+/// passed any.
+static struct Ex10EventFifoThresholdLimits const default_threshold_limits = {
+    .min_threshold     = 64u,
+    .max_threshold     = (EX10_EVENT_FIFO_SIZE * 3u) / 4u,
+    .target_latency_ms = 20u,
+    .window_ms         = 100u,
+    .min_tags_per_s    = 50u,
+};
+
+/**
+ * @struct AdaptiveThreshold
+ * The EventFifo threshold controller state. Drains are accumulated over a
+ * window and, at the end of each window, the threshold is moved toward the
+ * number of bytes the EventFifo receives in target_latency_ms, or set to
+ * min_threshold when the tag rate is low.
+ */
+struct AdaptiveThreshold
+{
+    bool                                enabled;
+    struct Ex10EventFifoThresholdLimits limits;
+    struct Ex10EventFifoThresholdStats  stats;
+    uint32_t                            window_start_ms;
+    uint32_t                            window_drains;
+    uint32_t                            window_bytes;
+    uint32_t                            window_tags;
+};
+
+static struct AdaptiveThreshold adaptive_threshold;
+
+/**
+ * @struct DeviceReadCache
+ * Device identification and flash contents which cannot change until the
+ * Ex10 is reset, powered down or has its flash written. Each entry is read
+ * from the Ex10 on first use and served from RAM until invalidated.
+ */
+struct DeviceReadCache
+{
+    bool                       device_info_valid;
+    struct DeviceInfoFields    device_info;
+    bool                       application_version_valid;
+    struct Ex10FirmwareVersion application_version;
+    bool                       bootloader_version_valid;
+    struct Ex10FirmwareVersion bootloader_version;
+    bool                       image_validity_valid;
+    struct ImageValidityFields image_validity;
+    bool                       sku_valid;
+    enum ProductSku            sku;
+    bool                       info_page_valid;
+    uint32_t                   info_page_address;
+    uint8_t                    info_page[EX10_INFO_PAGE_SIZE];
+};
+
+static struct DeviceReadCache read_cache;
 
 /* Forward declarations as needed */
 static struct Ex10Result proto_write(struct RegisterInfo const* const reg_info,
@@ -72,6 +137,19 @@ static struct Ex10Result          wait_op_completion(void);
 static struct Ex10Result          wait_op_completion_with_timeout(uint32_t);
 static struct ImageValidityFields get_image_validity(void);
 
+static void invalidate_read_cache(void)
+{
+    read_cache.device_info_valid         = false;
+    read_cache.application_version_valid = false;
+    read_cache.bootloader_version_valid  = false;
+    read_cache.image_validity_valid      = false;
+    read_cache.sku_valid                 = false;
+    read_cache.info_page_valid           = false;
+}
+
+// The SPI clock rate used when the Ex10 is running the Application.
+static uint32_t application_spi_clock_hz = 0u;
+
 static size_t upload_remaining_length = 0;
 static size_t upload_image_length     = 0;
 
@@ -143,6 +221,30 @@ static struct Ex10Result register_interrupt_callback(
     return proto_write(&interrupt_mask_reg, &enable_mask);
 }
 
+/**
+ * Take a free EventFifo buffer able to hold length bytes, recording the
+ * free list pressure in the Ex10EventPipelineMonitor.
+ *
+ * @param length The number of EventFifo bytes to be read into the buffer.
+ *
+ * @return struct FifoBufferNode* The buffer, or NULL if none was available.
+ */
+static struct FifoBufferNode* get_free_event_fifo_buffer(size_t length)
+{
+    struct FifoBufferNode* fifo_buffer =
+        _fifo_buffer_list->free_list_get_sized(length);
+    if (fifo_buffer == NULL)
+    {
+        _pipeline_monitor->record_free_list_empty();
+    }
+    else
+    {
+        _pipeline_monitor->record_free_list_size(
+            _fifo_buffer_list->free_list_size());
+    }
+    return fifo_buffer;
+}
+
 /**
  * Read the EventFifo multiple times filling an EventFifoBuffer node.
  *
@@ -155,7 +257,8 @@ static struct Ex10Result register_interrupt_callback(
  */
 static struct FifoBufferNode* read_event_fifo(size_t fifo_num_bytes)
 {
-    struct FifoBufferNode* fifo_buffer = _fifo_buffer_list->free_list_get();
+    struct FifoBufferNode* fifo_buffer =
+        get_free_event_fifo_buffer(fifo_num_bytes);
 
     if (!fifo_buffer)
     {
@@ -213,6 +316,351 @@ static struct FifoBufferNode* read_event_fifo(size_t fifo_num_bytes)
     return fifo_buffer;
 }
 
+/**
+ * Count the EventFifo bytes and tag packets delivered by a drain towards the
+ * current adaptive threshold window.
+ */
+static void adaptive_threshold_count(struct ConstByteSpan const* fifo_data)
+{
+    adaptive_threshold.window_bytes += (uint32_t)fifo_data->length;
+
+    size_t offset = 0u;
+    while (offset + sizeof(struct PacketHeader) <= fifo_data->length)
+    {
+        struct PacketHeader const* packet_header =
+            (struct PacketHeader const*)&fifo_data->data[offset];
+        if (packet_header->packet_length == 0u)
+        {
+            break;
+        }
+        if ((packet_header->packet_type == TagRead) ||
+            (packet_header->packet_type == TagReadExtended))
+        {
+            adaptive_threshold.window_tags += 1u;
+        }
+        offset += packet_header->packet_length * sizeof(uint32_t);
+    }
+}
+
+static void deliver_fifo_buffer(struct FifoBufferNode* fifo_buffer)
+{
+    fifo_buffer->irq_time_us = irq_time_us;
+
+    if (adaptive_threshold.enabled)
+    {
+        adaptive_threshold_count(&fifo_buffer->fifo_data);
+    }
+
+    if (fifo_data_callback != NULL)
+    {
+        fifo_data_callback(fifo_buffer);
+    }
+    else
+    {
+        // There are no consumers of the data; free the buffer.
+        ex10_release_buffer_node(fifo_buffer);
+    }
+}
+
+/**
+ * Get the length of the complete EventFifo packets held in a buffer.
+ *
+ * @param data   The EventFifo bytes, starting on a packet boundary.
+ * @param length The number of bytes in data.
+ *
+ * @return size_t The number of leading bytes which form complete packets.
+ */
+static size_t complete_packets_length(uint8_t const* data, size_t length)
+{
+    size_t offset = 0u;
+    while (offset + sizeof(struct PacketHeader) <= length)
+    {
+        struct PacketHeader const* packet_header =
+            (struct PacketHeader const*)&data[offset];
+        size_t const packet_length =
+            packet_header->packet_length * sizeof(uint32_t);
+        if ((packet_length == 0u) || (offset + packet_length > length))
+        {
+            break;
+        }
+        offset += packet_length;
+    }
+    return offset;
+}
+
+/**
+ * Read the EventFifo in ReadFifo sized chunks, overlapping the transfer of
+ * each ReadFifo command, and the Ex10's preparation of its response, with
+ * the delivery of the complete packets already received. Complete packets
+ * are delivered to the fifo_data_callback in their own FifoBufferNode as
+ * soon as the next chunk has been requested; a packet which straddles a
+ * chunk boundary is moved to the front of the next buffer. If no free
+ * buffer is available the chunks accumulate in the current buffer, as
+ * read_event_fifo() does.
+ *
+ * The overlap relies on HostInterface.write_async() releasing CS when the
+ * command has been clocked out. Without asynchronous host transfers the
+ * command is complete before delivery starts, and only the Ex10's
+ * preparation of the response overlaps it.
+ *
+ * Errors are reported to the fifo_data_callback as an Ex10ResultPacket.
+ *
+ * @param fifo_num_bytes The value read from the EventFifoNumBytes register.
+ */
+static void read_event_fifo_pipelined(size_t fifo_num_bytes)
+{
+    struct FifoBufferNode* fifo_buffer =
+        get_free_event_fifo_buffer(fifo_num_bytes);
+    struct Ex10Result      ex10_result = make_ex10_success();
+
+    if (!fifo_buffer)
+    {
+        ex10_eprintf("No free event fifo buffers\n");
+        ex10_result = make_ex10_sdk_error(Ex10ModuleProtocol,
+                                          Ex10SdkNoFreeEventFifoBuffers);
+    }
+    else if (fifo_num_bytes > fifo_buffer->raw_buffer.length)
+    {
+        ex10_release_buffer_node(fifo_buffer);
+        ex10_result = make_ex10_sdk_error(
+            Ex10ModuleProtocol, Ex10SdkFreeEventFifoBuffersLengthMismatch);
+    }
+
+    if (ex10_result.error)
+    {
+        const uint32_t         us_counter = 0;
+        struct FifoBufferNode* result_buffer =
+            make_ex10_result_fifo_packet(ex10_result, us_counter);
+        if (result_buffer)
+        {
+            deliver_fifo_buffer(result_buffer);
+        }
+        return;
+    }
+
+    size_t const chunk_max      = EX10_SPI_BURST_SIZE - 1u;
+    size_t       fifo_remaining = fifo_num_bytes;
+    size_t       buffer_length  = 0u;
+    size_t       chunk_length =
+        (fifo_remaining < chunk_max) ? fifo_remaining : chunk_max;
+
+    // The lock is held throughout since a ReadFifo command is outstanding
+    // while packets are delivered.
+    _gpio_if->irq_enable(false);
+    ex10_result =
+        _ex10_commands->read_fifo_chunk_start(EventFifo, chunk_length);
+    while (ex10_result.error == false)
+    {
+        uint8_t* const data = fifo_buffer->raw_buffer.data;
+        ex10_result         = _ex10_commands->read_fifo_chunk_finish(
+            &data[buffer_length], chunk_length);
+        if (ex10_result.error)
+        {
+            break;
+        }
+        buffer_length += chunk_length;
+        fifo_remaining -= chunk_length;
+        if (fifo_remaining == 0u)
+        {
+            break;
+        }
+
+        // Request the next chunk. The command is clocked out, CS released
+        // by the SPI interrupt, and the Ex10 prepares its response, while
+        // the packets received so far are delivered.
+        chunk_length =
+            (fifo_remaining < chunk_max) ? fifo_remaining : chunk_max;
+        ex10_result =
+            _ex10_commands->read_fifo_chunk_start(EventFifo, chunk_length);
+        if (ex10_result.error)
+        {
+            break;
+        }
+
+        size_t const complete_length =
+            complete_packets_length(data, buffer_length);
+        if (complete_length == 0u)
+        {
+            continue;
+        }
+
+        size_t const partial_length = buffer_length - complete_length;
+        struct FifoBufferNode* next_buffer =
+            get_free_event_fifo_buffer(partial_length + fifo_remaining);
+        if (next_buffer == NULL)
+        {
+            continue;
+        }
+
+        if ((partial_length + fifo_remaining >
+             next_buffer->raw_buffer.length) ||
+            (ex10_memcpy(next_buffer->raw_buffer.data,
+                         next_buffer->raw_buffer.length,
+                         &data[complete_length],
+                         partial_length) != 0))
+        {
+            ex10_release_buffer_node(next_buffer);
+            continue;
+        }
+
+        fifo_buffer->fifo_data.length = complete_length;
+        deliver_fifo_buffer(fifo_buffer);
+
+        fifo_buffer   = next_buffer;
+        buffer_length = partial_length;
+    }
+    _gpio_if->irq_enable(true);
+
+    if (ex10_result.error)
+    {
+        // The contents of the buffer cannot be parsed. Release the fifo
+        // buffer to the free list and report the error in its place.
+        ex10_release_buffer_node(fifo_buffer);
+
+        const uint32_t         us_counter = 0;
+        struct FifoBufferNode* result_buffer =
+            make_ex10_result_fifo_packet(ex10_result, us_counter);
+        if (result_buffer)
+        {
+            deliver_fifo_buffer(result_buffer);
+        }
+        return;
+    }
+
+    fifo_buffer->fifo_data.length = buffer_length;
+    deliver_fifo_buffer(fifo_buffer);
+}
+
+/**
+ * Re-evaluate the threshold if the current window has ended.
+ * Below min_tags_per_s the threshold is set to min_threshold. Otherwise it
+ * is set to the number of bytes expected in target_latency_ms at the
+ * observed byte rate, limited to half or double the current threshold and
+ * to the configured limits. Changes of less than a quarter of the current
+ * threshold are not written.
+ *
+ * @return bool true if the window had ended and was evaluated.
+ */
+static bool adaptive_threshold_evaluate(void)
+{
+    struct AdaptiveThreshold* const            ctrl   = &adaptive_threshold;
+    struct Ex10EventFifoThresholdLimits const* limits = &ctrl->limits;
+
+    uint32_t const elapsed_ms =
+        get_ex10_time_helpers()->time_elapsed(ctrl->window_start_ms);
+    if (elapsed_ms < limits->window_ms)
+    {
+        return false;
+    }
+
+    uint32_t const bytes_per_s =
+        (uint32_t)(((uint64_t)ctrl->window_bytes * 1000u) / elapsed_ms);
+    uint32_t const tags_per_s =
+        (uint32_t)(((uint64_t)ctrl->window_tags * 1000u) / elapsed_ms);
+
+    ctrl->stats.evaluations += 1u;
+    ctrl->stats.bytes_per_s      = bytes_per_s;
+    ctrl->stats.tags_per_s       = tags_per_s;
+    ctrl->stats.mean_drain_bytes =
+        (ctrl->window_drains > 0u) ? ctrl->window_bytes / ctrl->window_drains
+                                   : 0u;
+
+    ctrl->window_start_ms = get_ex10_time_helpers()->time_now();
+    ctrl->window_drains   = 0u;
+    ctrl->window_bytes    = 0u;
+    ctrl->window_tags     = 0u;
+
+    size_t const current = ctrl->stats.threshold;
+    size_t target =
+        (size_t)(((uint64_t)bytes_per_s * limits->target_latency_ms) / 1000u);
+
+    // Move at most a factor of two per window, so a single burst or a quiet
+    // window does not swing the threshold between its limits.
+    size_t const step_max =
+        (current > 0u) ? current * 2u : limits->max_threshold;
+    size_t const step_min = current / 2u;
+    target = (target > step_max) ? step_max : target;
+    target = (target < step_min) ? step_min : target;
+    target = (target > limits->max_threshold) ? limits->max_threshold : target;
+    target = (target < limits->min_threshold) ? limits->min_threshold : target;
+
+    // With few tags in the field the interrupt rate is low at any threshold,
+    // so report them as soon as possible.
+    bool const low_tag_rate = (tags_per_s < limits->min_tags_per_s);
+    if (low_tag_rate)
+    {
+        target = limits->min_threshold;
+    }
+    target = (target / sizeof(uint32_t)) * sizeof(uint32_t);
+
+    size_t const change =
+        (target > current) ? (target - current) : (current - target);
+    if ((change == 0u) || ((low_tag_rate == false) && (change < current / 4u)))
+    {
+        ctrl->stats.holds += 1u;
+        return true;
+    }
+
+    struct EventFifoIntLevelFields const level_data = {
+        .threshold = (uint16_t)target, .rfu = 0u};
+    struct Ex10Result const ex10_result =
+        proto_write(&event_fifo_int_level_reg, &level_data);
+    if (ex10_result.error)
+    {
+        ctrl->stats.write_errors += 1u;
+        return true;
+    }
+
+    if (target > current)
+    {
+        ctrl->stats.raises += 1u;
+    }
+    else
+    {
+        ctrl->stats.lowers += 1u;
+        if (low_tag_rate)
+        {
+            ctrl->stats.low_tag_rate_lowers += 1u;
+        }
+    }
+    ctrl->stats.threshold = (uint16_t)target;
+    return true;
+}
+
+/// Called once per EventFifo drain, after the drained data was delivered.
+static void adaptive_threshold_update(void)
+{
+    adaptive_threshold.window_drains += 1u;
+    adaptive_threshold.stats.drains += 1u;
+    (void)adaptive_threshold_evaluate();
+}
+
+/**
+ * Called by the IRQ_N monitor thread every window_ms. This ends windows in
+ * which the threshold was too high for the EventFifo to be drained.
+ */
+static void adaptive_threshold_timer(void)
+{
+    if (adaptive_threshold.enabled && adaptive_threshold_evaluate())
+    {
+        adaptive_threshold.stats.timer_evaluations += 1u;
+    }
+}
+
+static void adaptive_threshold_reset(uint16_t threshold)
+{
+    adaptive_threshold.stats.threshold = threshold;
+    adaptive_threshold.window_start_ms = get_ex10_time_helpers()->time_now();
+    adaptive_threshold.window_drains   = 0u;
+    adaptive_threshold.window_bytes    = 0u;
+    adaptive_threshold.window_tags     = 0u;
+}
+
+static void enable_pipelined_fifo_drain(bool enable)
+{
+    pipelined_fifo_drain = enable;
+}
+
 static void interrupt_handler(void)
 {
     struct RegisterInfo const* const reg_list[] = {
@@ -222,6 +670,9 @@ static void interrupt_handler(void)
     struct InterruptStatusFields   irq_status;
     struct EventFifoNumBytesFields fifo_num_bytes;
 
+    irq_time_us = get_ex10_time_helpers()->time_now_us();
+    _pipeline_monitor->record_irq();
+
     void*                   buffers[] = {&status, &irq_status, &fifo_num_bytes};
     struct Ex10Result const ex10_result =
         read_multiple(reg_list, buffers, ARRAY_SIZE(reg_list));
@@ -237,6 +688,7 @@ static void interrupt_handler(void)
                 make_ex10_result_fifo_packet(ex10_result, us_counter);
             if (fifo_buffer)
             {
+                fifo_buffer->irq_time_us = irq_time_us;
                 fifo_data_callback(fifo_buffer);
             }
         }
@@ -268,23 +720,29 @@ static void interrupt_handler(void)
         // reported up the stack. It cannot be parsed.
         if (fifo_num_bytes.num_bytes > 0)
         {
-            // Note: The fifo_buffer may contain the Ex10ResultPacket indicating
-            // an error occurred during processing. Do not assume it is a
-            // full length EventFifo packet.
-            struct FifoBufferNode* fifo_buffer =
-                read_event_fifo(fifo_num_bytes.num_bytes);
-            if (fifo_buffer != NULL)
+            _pipeline_monitor->record_drain(fifo_num_bytes.num_bytes);
+
+            if (pipelined_fifo_drain)
             {
-                if (fifo_data_callback != NULL)
-                {
-                    fifo_data_callback(fifo_buffer);
-                }
-                else
+                read_event_fifo_pipelined(fifo_num_bytes.num_bytes);
+            }
+            else
+            {
+                // Note: The fifo_buffer may contain the Ex10ResultPacket
+                // indicating an error occurred during processing. Do not
+                // assume it is a full length EventFifo packet.
+                struct FifoBufferNode* fifo_buffer =
+                    read_event_fifo(fifo_num_bytes.num_bytes);
+                if (fifo_buffer != NULL)
                 {
-                    // There are no consumers of the data; free the buffer.
-                    ex10_release_buffer_node(fifo_buffer);
+                    deliver_fifo_buffer(fifo_buffer);
                 }
             }
+
+            if (adaptive_threshold.enabled)
+            {
+                adaptive_threshold_update();
+            }
         }
     }
 }
@@ -310,10 +768,22 @@ static void init(struct Ex10DriverList const* driver_list)
                                    &driver_list->host_if);
 
     _fifo_buffer_list = get_ex10_fifo_buffer_list();
+
+    _register_cache = get_ex10_register_cache();
+    _register_cache->init();
+
+    _pipeline_monitor = get_ex10_event_pipeline_monitor();
+    _pipeline_monitor->init();
+
+    application_spi_clock_hz = DEFAULT_SPI_CLOCK_HZ;
+    ex10_memzero(&adaptive_threshold, sizeof(adaptive_threshold));
 }
 
 static struct Ex10Result init_ex10(void)
 {
+    // The Ex10 has been (re)started; its register contents are unknown.
+    _register_cache->invalidate();
+
     // Disable all interrupts
     struct Ex10Result ex10_result =
         proto_write(&interrupt_mask_reg, &irq_mask_clear);
@@ -330,6 +800,7 @@ static struct Ex10Result init_ex10(void)
     {
         return ex10_result;
     }
+    adaptive_threshold_reset(DEFAULT_EVENT_FIFO_THRESHOLD);
 
     // Clear pending interrupts
     struct InterruptStatusFields irq_status;
@@ -372,6 +843,7 @@ static struct Ex10Result deinit(void)
 
     _gpio_if->deregister_irq_callback();
     _ex10_command_transactor->deinit();
+    _register_cache->invalidate();
 
     return make_ex10_success();
 }
@@ -448,6 +920,10 @@ static struct Ex10Result read_multiple(
     _gpio_if->irq_enable(false);
     const struct Ex10Result ex10_result = _ex10_commands->read(
         reg_list, buffers, num_regs, NOMINAL_READY_N_TIMEOUT_MS);
+    if (ex10_result.error == false)
+    {
+        _register_cache->update_from_read(reg_list, buffers, num_regs);
+    }
     _gpio_if->irq_enable(true);
 
     return ex10_result;
@@ -501,8 +977,8 @@ static struct Ex10Result proto_test_read(uint32_t address,
     return make_ex10_success();
 }
 
-static struct Ex10Result read_info_page_buffer(uint32_t address,
-                                               uint8_t* read_buffer)
+static struct Ex10Result read_info_page_from_device(uint32_t address,
+                                                    uint8_t* read_buffer)
 {
     // Info page is 2048 bytes long, divided into chunks to fit in buffers.
     // The transfer size must be a multiple of 4, so mask out the lower 2 bits.
@@ -539,6 +1015,40 @@ static struct Ex10Result read_info_page_buffer(uint32_t address,
     return ex10_result;
 }
 
+static struct Ex10Result read_info_page_buffer(uint32_t address,
+                                               uint8_t* read_buffer)
+{
+    if (read_buffer == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol, Ex10SdkErrorNullPointer);
+    }
+
+    if (read_cache.info_page_valid == false ||
+        read_cache.info_page_address != address)
+    {
+        read_cache.info_page_valid = false;
+        struct Ex10Result const ex10_result =
+            read_info_page_from_device(address, read_cache.info_page);
+        if (ex10_result.error)
+        {
+            return ex10_result;
+        }
+        read_cache.info_page_address = address;
+        read_cache.info_page_valid   = true;
+    }
+
+    int const copy_result = ex10_memcpy(read_buffer,
+                                        EX10_INFO_PAGE_SIZE,
+                                        read_cache.info_page,
+                                        sizeof(read_cache.info_page));
+    if (copy_result != 0)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol, Ex10MemcpyFailed);
+    }
+
+    return make_ex10_success();
+}
+
 static struct Ex10Result get_write_multiple_stored_settings(
     struct RegisterInfo const* const reg_list[],
     void const*                      buffers[],
@@ -625,14 +1135,27 @@ static struct Ex10Result get_write_multiple_stored_settings(
     return make_ex10_success();
 }
 
+/**
+ * Write registers to the Ex10 without filtering through the register cache.
+ * The caller must hold the IRQ_N lock.
+ */
+static struct Ex10Result write_multiple_uncached(
+    struct RegisterInfo const* const reg_list[],
+    void const*                      buffers[],
+    size_t                           num_regs)
+{
+    return _ex10_commands->write(
+        reg_list, buffers, num_regs, NOMINAL_READY_N_TIMEOUT_MS);
+}
+
 static struct Ex10Result write_multiple(
     struct RegisterInfo const* const reg_list[],
     void const*                      buffers[],
     size_t                           num_regs)
 {
     _gpio_if->irq_enable(false);
-    const struct Ex10Result ex10_result = _ex10_commands->write(
-        reg_list, buffers, num_regs, NOMINAL_READY_N_TIMEOUT_MS);
+    const struct Ex10Result ex10_result = _register_cache->write_multiple(
+        reg_list, buffers, num_regs, write_multiple_uncached);
     _gpio_if->irq_enable(true);
 
     return ex10_result;
@@ -712,6 +1235,8 @@ static struct Ex10Result reset(enum Status destination)
     }
 
     upload_reset();
+    _register_cache->invalidate();
+    invalidate_read_cache();
 
     // Reset the Ex10, then read the Status register to get running location.
     _gpio_if->irq_enable(false);
@@ -730,8 +1255,8 @@ static struct Ex10Result reset(enum Status destination)
 
     if (running_location == Application)
     {
-        // Application execution confirmed. Set the SPI clock rate to 4 MHz.
-        host_if_error = host_if_reopen(DEFAULT_SPI_CLOCK_HZ);
+        // Application execution confirmed. Set the Application SPI clock.
+        host_if_error = host_if_reopen(application_spi_clock_hz);
         if (host_if_error != 0)
         {
             return make_ex10_sdk_error_with_status(Ex10ModuleProtocol,
@@ -743,6 +1268,31 @@ static struct Ex10Result reset(enum Status destination)
     return make_ex10_success();
 }
 
+static struct Ex10Result set_application_spi_clock(uint32_t clock_hz)
+{
+    if (clock_hz == 0u)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                   Ex10SdkErrorBadParamValue);
+    }
+
+    int const host_if_error = host_if_reopen(clock_hz);
+    if (host_if_error != 0)
+    {
+        return make_ex10_sdk_error_with_status(Ex10ModuleProtocol,
+                                               Ex10SdkErrorHostInterface,
+                                               (uint32_t)host_if_error);
+    }
+
+    application_spi_clock_hz = clock_hz;
+    return make_ex10_success();
+}
+
+static uint32_t get_application_spi_clock(void)
+{
+    return application_spi_clock_hz;
+}
+
 static struct Ex10Result set_event_fifo_threshold(size_t threshold)
 {
     if (threshold > EX10_EVENT_FIFO_SIZE)
@@ -753,7 +1303,79 @@ static struct Ex10Result set_event_fifo_threshold(size_t threshold)
 
     struct EventFifoIntLevelFields const event_fifo_thresh = {
         .threshold = (uint16_t)threshold, .rfu = 0u};
-    return proto_write(&event_fifo_int_level_reg, &event_fifo_thresh);
+    struct Ex10Result const ex10_result =
+        proto_write(&event_fifo_int_level_reg, &event_fifo_thresh);
+    if (ex10_result.error == false)
+    {
+        adaptive_threshold_reset((uint16_t)threshold);
+    }
+    return ex10_result;
+}
+
+/**
+ * Start or stop the adaptive threshold timer on the IRQ_N monitor thread.
+ *
+ * @param period_ms The timer period, or zero to stop it.
+ */
+static void adaptive_threshold_set_timer(uint32_t period_ms)
+{
+    if (_gpio_if->set_irq_tick_callback != NULL)
+    {
+        _gpio_if->set_irq_tick_callback(
+            (period_ms > 0u) ? adaptive_threshold_timer : NULL, period_ms);
+    }
+}
+
+static struct Ex10Result enable_adaptive_event_fifo_threshold(
+    bool                                       enable,
+    struct Ex10EventFifoThresholdLimits const* limits)
+{
+    if (enable == false)
+    {
+        adaptive_threshold.enabled = false;
+        adaptive_threshold_set_timer(0u);
+        return set_event_fifo_threshold(DEFAULT_EVENT_FIFO_THRESHOLD);
+    }
+
+    if (limits == NULL)
+    {
+        limits = &default_threshold_limits;
+    }
+
+    if ((limits->min_threshold > limits->max_threshold) ||
+        (limits->max_threshold > EX10_EVENT_FIFO_SIZE) ||
+        (limits->window_ms == 0u))
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                   Ex10SdkErrorBadParamValue);
+    }
+
+    // Start from the current threshold, within the limits.
+    uint16_t threshold = adaptive_threshold.stats.threshold;
+    threshold = (threshold < limits->min_threshold) ? limits->min_threshold
+                                                    : threshold;
+    threshold = (threshold > limits->max_threshold) ? limits->max_threshold
+                                                    : threshold;
+
+    adaptive_threshold.enabled = false;
+    struct Ex10Result const ex10_result = set_event_fifo_threshold(threshold);
+    if (ex10_result.error)
+    {
+        return ex10_result;
+    }
+
+    ex10_memzero(&adaptive_threshold.stats, sizeof(adaptive_threshold.stats));
+    adaptive_threshold.limits = *limits;
+    adaptive_threshold_reset(threshold);
+    adaptive_threshold.enabled = true;
+    adaptive_threshold_set_timer(limits->window_ms);
+    return make_ex10_success();
+}
+
+static void get_adaptive_event_fifo_threshold_stats(
+    struct Ex10EventFifoThresholdStats* stats)
+{
+    *stats = adaptive_threshold.stats;
 }
 
 static struct Ex10Result insert_fifo_event(
@@ -852,6 +1474,13 @@ static struct Ex10Result start_op(enum OpId op_id)
     struct Ex10Result             ex10_result =
         proto_write(&ops_control_reg, &ops_control_data);
     tracepoint(pi_ex10sdk, PROTOCOL_start_op, op_id);
+
+    // The AggregateOp writes registers on the Ex10 from its op buffer,
+    // bypassing the register cache.
+    if (op_id == AggregateOp)
+    {
+        _register_cache->invalidate();
+    }
     return ex10_result;
 }
 
@@ -914,6 +1543,7 @@ static struct Ex10Result write_info_page(enum PageIds page_id,
     };
 
     // Send the data
+    invalidate_read_cache();
     _gpio_if->irq_enable(false);
     ex10_result =
         _ex10_commands->write_info_page((uint8_t)page_id, &page_data, crc16);
@@ -1135,6 +1765,7 @@ static struct Ex10Result upload_continue(const struct ConstByteSpan image_chunk)
 static struct Ex10Result upload_complete(void)
 {
     upload_reset();
+    invalidate_read_cache();
 
     if (get_running_location() != Bootloader)
     {
@@ -1190,6 +1821,7 @@ static struct ImageValidityFields revalidate_image(void)
         return image_validity;
     }
 
+    invalidate_read_cache();
     _gpio_if->irq_enable(false);
     ex10_result = _ex10_commands->revalidate_main_image();
     _gpio_if->irq_enable(true);
@@ -1214,7 +1846,7 @@ static struct Ex10Result proto_test_transfer(struct ConstByteSpan const* send,
     return ex10_result;
 }
 
-static struct Ex10Result get_device_info(struct DeviceInfoFields* dev_info)
+static struct Ex10Result read_device_info(struct DeviceInfoFields* dev_info)
 {
     if (dev_info == NULL)
     {
@@ -1279,7 +1911,7 @@ static struct Ex10Result get_device_info(struct DeviceInfoFields* dev_info)
     return make_ex10_success();
 }
 
-static struct Ex10Result get_application_version(
+static struct Ex10Result read_application_version(
     struct Ex10FirmwareVersion* firmware_version)
 {
     if (firmware_version == NULL)
@@ -1311,7 +1943,7 @@ static struct Ex10Result get_application_version(
     return make_ex10_success();
 }
 
-static struct Ex10Result get_bootloader_version(
+static struct Ex10Result read_bootloader_version(
     struct Ex10FirmwareVersion* firmware_version)
 {
     if (firmware_version == NULL)
@@ -1367,7 +1999,7 @@ static struct Ex10Result get_bootloader_version(
     return make_ex10_success();
 }
 
-static struct ImageValidityFields get_image_validity(void)
+static struct ImageValidityFields read_image_validity(void)
 {
     if (get_running_location() == Application)
     {
@@ -1412,7 +2044,7 @@ static struct Ex10Result get_remain_reason(
     return ex10_result;
 }
 
-static enum ProductSku get_sku(void)
+static enum ProductSku read_sku(void)
 {
     if (get_running_location() != Application)
     {
@@ -1433,6 +2065,115 @@ static enum ProductSku get_sku(void)
     return (enum ProductSku)sku_value;
 }
 
+static struct Ex10Result get_device_info(struct DeviceInfoFields* dev_info)
+{
+    if (dev_info == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol, Ex10SdkErrorNullPointer);
+    }
+
+    if (read_cache.device_info_valid == false)
+    {
+        struct Ex10Result const ex10_result =
+            read_device_info(&read_cache.device_info);
+        if (ex10_result.error)
+        {
+            return ex10_result;
+        }
+        read_cache.device_info_valid = true;
+    }
+
+    *dev_info = read_cache.device_info;
+    return make_ex10_success();
+}
+
+static struct Ex10Result get_application_version(
+    struct Ex10FirmwareVersion* firmware_version)
+{
+    if (firmware_version == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol, Ex10SdkErrorNullPointer);
+    }
+
+    if (read_cache.application_version_valid == false)
+    {
+        struct Ex10Result const ex10_result =
+            read_application_version(&read_cache.application_version);
+        if (ex10_result.error)
+        {
+            ex10_memzero(firmware_version, sizeof(*firmware_version));
+            return ex10_result;
+        }
+        read_cache.application_version_valid = true;
+    }
+
+    *firmware_version = read_cache.application_version;
+    return make_ex10_success();
+}
+
+static struct Ex10Result get_bootloader_version(
+    struct Ex10FirmwareVersion* firmware_version)
+{
+    if (firmware_version == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol, Ex10SdkErrorNullPointer);
+    }
+
+    // Note: When running in the Application, reading the bootloader version
+    // resets the Ex10 twice, invalidating the cache. The bootloader version
+    // is cached once the Ex10 is back in its initial running location.
+    if (read_cache.bootloader_version_valid == false)
+    {
+        struct Ex10FirmwareVersion bootloader_version;
+        struct Ex10Result const    ex10_result =
+            read_bootloader_version(&bootloader_version);
+        if (ex10_result.error)
+        {
+            ex10_memzero(firmware_version, sizeof(*firmware_version));
+            return ex10_result;
+        }
+        read_cache.bootloader_version       = bootloader_version;
+        read_cache.bootloader_version_valid = true;
+    }
+
+    *firmware_version = read_cache.bootloader_version;
+    return make_ex10_success();
+}
+
+static struct ImageValidityFields get_image_validity(void)
+{
+    if (read_cache.image_validity_valid == false)
+    {
+        struct ImageValidityFields const image_validity = read_image_validity();
+        // Both markers cleared indicates the read failed; do not cache it.
+        if (image_validity.image_valid_marker == false &&
+            image_validity.image_non_valid_marker == false)
+        {
+            return image_validity;
+        }
+        read_cache.image_validity       = image_validity;
+        read_cache.image_validity_valid = true;
+    }
+
+    return read_cache.image_validity;
+}
+
+static enum ProductSku get_sku(void)
+{
+    if (read_cache.sku_valid == false)
+    {
+        enum ProductSku const sku = read_sku();
+        if (sku == SkuUnknown)
+        {
+            return sku;
+        }
+        read_cache.sku       = sku;
+        read_cache.sku_valid = true;
+    }
+
+    return read_cache.sku;
+}
+
 static const struct Ex10Protocol ex10_protocol = {
     .init                               = init,
     .init_ex10                          = init_ex10,
@@ -1442,6 +2183,7 @@ static const struct Ex10Protocol ex10_protocol = {
     .unregister_fifo_data_callback      = unregister_fifo_data_callback,
     .unregister_interrupt_callback      = unregister_interrupt_callback,
     .enable_interrupt_handlers          = enable_interrupt_handlers,
+    .enable_pipelined_fifo_drain        = enable_pipelined_fifo_drain,
     .read                               = proto_read,
     .test_read                          = proto_test_read,
     .read_index                         = read_index,
@@ -1461,6 +2203,10 @@ static const struct Ex10Protocol ex10_protocol = {
     .read_ops_status_reg                = read_ops_status_reg,
     .reset                              = reset,
     .set_event_fifo_threshold           = set_event_fifo_threshold,
+    .enable_adaptive_event_fifo_threshold =
+        enable_adaptive_event_fifo_threshold,
+    .get_adaptive_event_fifo_threshold_stats =
+        get_adaptive_event_fifo_threshold_stats,
     .insert_fifo_event                  = insert_fifo_event,
     .get_running_location               = get_running_location,
     .get_analog_rx_config               = get_analog_rx_config,
@@ -1482,6 +2228,9 @@ static const struct Ex10Protocol ex10_protocol = {
     .get_image_validity                 = get_image_validity,
     .get_remain_reason                  = get_remain_reason,
     .get_sku                            = get_sku,
+    .invalidate_read_cache              = invalidate_read_cache,
+    .set_application_spi_clock          = set_application_spi_clock,
+    .get_application_spi_clock          = get_application_spi_clock,
 };
 
 struct Ex10Protocol const* get_ex10_protocol(void)
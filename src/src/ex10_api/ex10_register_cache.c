@@ -0,0 +1,461 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2020 - 2024 Impinj, Inc. All rights reserved.               *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "board/ex10_osal.h"
+#include "ex10_api/application_registers.h"
+#include "ex10_api/ex10_macros.h"
+#include "ex10_api/ex10_register_cache.h"
+
+/// The number of bytes reserved for shadowing the cached registers.
+#define REGISTER_CACHE_SHADOW_SIZE ((size_t)512u)
+
+/// The maximum number of segments passed to a single write_fn call.
+#define REGISTER_CACHE_SEGMENTS_MAX ((size_t)8u)
+
+/**
+ * The registers held in the cache. These are configured by the host and are
+ * not modified by the Impinj Reader Chip firmware. They are listed in address
+ * order so that address adjacent registers are also adjacent in the shadow
+ * store and can be merged into one write segment.
+ *
+ * Status, result and count registers are updated by the firmware and are not
+ * cached. Nor is the Gen2TxBuffer: it is only rewritten when its commands
+ * change, so there is little to skip, and a stale shadow of it would send
+ * the wrong Gen2 commands.
+ */
+static struct RegisterInfo const* const cached_registers[] = {
+    &event_fifo_int_level_reg,
+    &power_control_loop_aux_adc_control_reg,
+    &power_control_loop_gain_divisor_reg,
+    &power_control_loop_max_iterations_reg,
+    &power_control_loop_adc_target_reg,
+    &power_control_loop_adc_thresholds_reg,
+    &delay_us_reg,
+    &rf_mode_reg,
+    &etsi_burst_off_time_reg,
+    &measure_rssi_count_reg,
+    &lbt_offset_reg,
+    &lbt_control_reg,
+    &rssi_threshold_rn16_reg,
+    &rssi_threshold_epc_reg,
+    &inventory_round_control_reg,
+    &inventory_round_control_2_reg,
+    &nominal_stop_time_reg,
+    &extended_stop_time_reg,
+    &regulatory_stop_time_reg,
+    &tx_mutex_time_reg,
+    &gen2_select_enable_reg,
+    &gen2_access_enable_reg,
+    &gen2_auto_access_enable_reg,
+    &gen2_offsets_reg,
+    &gen2_lengths_reg,
+    &gen2_transaction_ids_reg,
+    &gen2_txn_controls_reg,
+    &drop_query_control_reg,
+    &tag_features_control_reg,
+};
+
+/**
+ * @struct CacheSegment
+ * A register write segment which will be sent to the Impinj Reader Chip.
+ */
+struct CacheSegment
+{
+    uint16_t    address;
+    uint16_t    length;
+    void const* data;
+    bool        cached;         ///< The segment is held in the shadow store.
+    size_t      shadow_offset;  ///< Valid when cached is true.
+    size_t      segment_count;  ///< The number of caller segments merged.
+};
+
+static uint8_t shadow[REGISTER_CACHE_SHADOW_SIZE];
+static bool    shadow_valid[REGISTER_CACHE_SHADOW_SIZE];
+
+static bool                          cache_enabled = false;
+static bool                          cache_ready   = false;
+static struct Ex10RegisterCacheStats cache_stats;
+
+static uint16_t register_size(struct RegisterInfo const* reg_info)
+{
+    return (uint16_t)(reg_info->length * reg_info->num_entries);
+}
+
+/**
+ * Find the shadow store location of a register address range.
+ *
+ * @param address       The first register address of the range.
+ * @param length        The number of bytes in the range.
+ * @param shadow_offset The shadow store offset of the range, when found.
+ *
+ * @return bool true if the range is entirely within one cached register.
+ */
+static bool find_cached_range(uint16_t address,
+                              uint16_t length,
+                              size_t*  shadow_offset)
+{
+    size_t offset = 0u;
+    for (size_t iter = 0u; iter < ARRAY_SIZE(cached_registers); ++iter)
+    {
+        struct RegisterInfo const* const reg_info = cached_registers[iter];
+        uint32_t const reg_begin = reg_info->address;
+        uint32_t const reg_end   = reg_begin + register_size(reg_info);
+
+        if ((uint32_t)address >= reg_begin &&
+            (uint32_t)address + length <= reg_end)
+        {
+            *shadow_offset = offset + (address - reg_begin);
+            return true;
+        }
+        offset += register_size(reg_info);
+    }
+    return false;
+}
+
+static void set_shadow_valid(size_t shadow_offset, size_t length, bool valid)
+{
+    for (size_t iter = 0u; iter < length; ++iter)
+    {
+        shadow_valid[shadow_offset + iter] = valid;
+    }
+}
+
+static bool shadow_matches(size_t      shadow_offset,
+                           void const* data,
+                           size_t      length)
+{
+    uint8_t const* const data_ptr = (uint8_t const*)data;
+    for (size_t iter = 0u; iter < length; ++iter)
+    {
+        if (shadow_valid[shadow_offset + iter] == false ||
+            shadow[shadow_offset + iter] != data_ptr[iter])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void invalidate(void)
+{
+    ex10_memzero(shadow_valid, sizeof(shadow_valid));
+    cache_stats.invalidations += 1u;
+}
+
+static void invalidate_range(uint16_t address, uint16_t length)
+{
+    uint32_t const range_begin = address;
+    uint32_t const range_end   = range_begin + length;
+
+    size_t offset = 0u;
+    for (size_t iter = 0u; iter < ARRAY_SIZE(cached_registers); ++iter)
+    {
+        struct RegisterInfo const* const reg_info = cached_registers[iter];
+        uint32_t const reg_begin = reg_info->address;
+        uint32_t const reg_end   = reg_begin + register_size(reg_info);
+
+        if (range_begin < reg_end && reg_begin < range_end)
+        {
+            uint32_t const begin =
+                (range_begin > reg_begin) ? range_begin : reg_begin;
+            uint32_t const end = (range_end < reg_end) ? range_end : reg_end;
+            set_shadow_valid(offset + (begin - reg_begin), end - begin, false);
+        }
+        offset += register_size(reg_info);
+    }
+}
+
+static void init(void)
+{
+    size_t shadow_size = 0u;
+    for (size_t iter = 0u; iter < ARRAY_SIZE(cached_registers); ++iter)
+    {
+        shadow_size += register_size(cached_registers[iter]);
+    }
+
+    // If the cached register list outgrows the shadow store the cache is
+    // left permanently disabled; writes always pass through.
+    cache_ready   = (shadow_size <= sizeof(shadow));
+    cache_enabled = false;
+
+    ex10_memzero(shadow, sizeof(shadow));
+    ex10_memzero(shadow_valid, sizeof(shadow_valid));
+    ex10_memzero(&cache_stats, sizeof(cache_stats));
+}
+
+static void enable(bool enable_cache)
+{
+    if (enable_cache && cache_enabled == false)
+    {
+        invalidate();
+    }
+    cache_enabled = enable_cache && cache_ready;
+}
+
+static bool is_enabled(void)
+{
+    return cache_enabled;
+}
+
+/**
+ * Send the pending segments to the Impinj Reader Chip using the uncached
+ * write function. On failure the shadow contents of the segments are no
+ * longer known and are invalidated.
+ */
+static struct Ex10Result write_segments(
+    struct CacheSegment const segments[REGISTER_CACHE_SEGMENTS_MAX],
+    size_t                    count,
+    struct Ex10Result (*write_fn)(struct RegisterInfo const* const[],
+                                  void const*[],
+                                  size_t))
+{
+    if (count == 0u)
+    {
+        return make_ex10_success();
+    }
+
+// Segments beyond count are zero initialized and are not passed to write_fn.
+#define SEGMENT_REG_INFO(_index)                      \
+    {                                                 \
+        .name        = NULL,                          \
+        .address     = segments[_index].address,      \
+        .length      = segments[_index].length,       \
+        .num_entries = 1u,                            \
+        .access      = WriteOnly,                     \
+    }
+
+    static_assert(REGISTER_CACHE_SEGMENTS_MAX == 8u,
+                  "SEGMENT_REG_INFO list must match the segment count");
+    struct RegisterInfo const reg_infos[REGISTER_CACHE_SEGMENTS_MAX] = {
+        SEGMENT_REG_INFO(0),
+        SEGMENT_REG_INFO(1),
+        SEGMENT_REG_INFO(2),
+        SEGMENT_REG_INFO(3),
+        SEGMENT_REG_INFO(4),
+        SEGMENT_REG_INFO(5),
+        SEGMENT_REG_INFO(6),
+        SEGMENT_REG_INFO(7),
+    };
+#undef SEGMENT_REG_INFO
+
+    struct RegisterInfo const* reg_list[REGISTER_CACHE_SEGMENTS_MAX];
+    void const*                buffers[REGISTER_CACHE_SEGMENTS_MAX];
+    for (size_t iter = 0u; iter < count; ++iter)
+    {
+        reg_list[iter] = &reg_infos[iter];
+        buffers[iter]  = segments[iter].data;
+    }
+
+    struct Ex10Result const ex10_result = write_fn(reg_list, buffers, count);
+
+    cache_stats.write_commands += 1u;
+    for (size_t iter = 0u; iter < count; ++iter)
+    {
+        cache_stats.writes_issued += segments[iter].segment_count;
+        cache_stats.writes_merged += segments[iter].segment_count - 1u;
+        if (ex10_result.error)
+        {
+            invalidate_range(segments[iter].address, segments[iter].length);
+        }
+    }
+
+    return ex10_result;
+}
+
+static bool overlaps_pending(struct CacheSegment const segments[],
+                             size_t                    count,
+                             size_t                    shadow_offset,
+                             uint16_t                  length)
+{
+    for (size_t iter = 0u; iter < count; ++iter)
+    {
+        if (segments[iter].cached &&
+            shadow_offset < segments[iter].shadow_offset +
+                                segments[iter].length &&
+            segments[iter].shadow_offset < shadow_offset + length)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static struct Ex10Result write_multiple(
+    struct RegisterInfo const* const reg_list[],
+    void const*                      buffers[],
+    size_t                           num_regs,
+    struct Ex10Result (*write_fn)(struct RegisterInfo const* const[],
+                                  void const*[],
+                                  size_t))
+{
+    if (reg_list == NULL || buffers == NULL || write_fn == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleProtocol, Ex10SdkErrorNullPointer);
+    }
+
+    if (cache_enabled == false)
+    {
+        return write_fn(reg_list, buffers, num_regs);
+    }
+
+    // Check all segments before the shadow store is modified.
+    for (size_t iter = 0u; iter < num_regs; ++iter)
+    {
+        if (reg_list[iter] == NULL || buffers[iter] == NULL)
+        {
+            return make_ex10_sdk_error(Ex10ModuleProtocol,
+                                       Ex10SdkErrorNullPointer);
+        }
+    }
+
+    struct CacheSegment segments[REGISTER_CACHE_SEGMENTS_MAX];
+    ex10_memzero(segments, sizeof(segments));
+    size_t count = 0u;
+
+    for (size_t iter = 0u; iter < num_regs; ++iter)
+    {
+        uint16_t const address = reg_list[iter]->address;
+        uint16_t const length  = register_size(reg_list[iter]);
+        size_t         shadow_offset = 0u;
+        bool const     cached =
+            find_cached_range(address, length, &shadow_offset);
+
+        if (cached && shadow_matches(shadow_offset, buffers[iter], length))
+        {
+            cache_stats.writes_skipped += 1u;
+            continue;
+        }
+
+        // A pending segment must be sent before its register bytes are
+        // overwritten in the shadow store; merged segments point into it.
+        if (count == REGISTER_CACHE_SEGMENTS_MAX ||
+            (cached &&
+             overlaps_pending(segments, count, shadow_offset, length)))
+        {
+            struct Ex10Result const ex10_result =
+                write_segments(segments, count, write_fn);
+            if (ex10_result.error)
+            {
+                return ex10_result;
+            }
+            ex10_memzero(segments, sizeof(segments));
+            count = 0u;
+        }
+
+        if (cached == false)
+        {
+            // Writes which overlap part of a cached register leave it in an
+            // unknown state.
+            invalidate_range(address, length);
+        }
+        else
+        {
+            ex10_memcpy(&shadow[shadow_offset],
+                        sizeof(shadow) - shadow_offset,
+                        buffers[iter],
+                        length);
+            set_shadow_valid(shadow_offset, length, true);
+
+            struct CacheSegment* const prev =
+                (count > 0u) ? &segments[count - 1u] : NULL;
+            if (prev != NULL && prev->cached &&
+                (uint32_t)prev->address + prev->length == address &&
+                prev->shadow_offset + prev->length == shadow_offset)
+            {
+                // Merge into the preceding segment. The shadow store holds
+                // the data for both segments contiguously.
+                prev->data = &shadow[prev->shadow_offset];
+                prev->length += length;
+                prev->segment_count += 1u;
+                continue;
+            }
+        }
+
+        segments[count] = (struct CacheSegment){
+            .address       = address,
+            .length        = length,
+            .data          = buffers[iter],
+            .cached        = cached,
+            .shadow_offset = shadow_offset,
+            .segment_count = 1u,
+        };
+        count += 1u;
+    }
+
+    return write_segments(segments, count, write_fn);
+}
+
+static void update_from_read(struct RegisterInfo const* const reg_list[],
+                             void*                            buffers[],
+                             size_t                           num_regs)
+{
+    if (cache_enabled == false || reg_list == NULL || buffers == NULL)
+    {
+        return;
+    }
+
+    for (size_t iter = 0u; iter < num_regs; ++iter)
+    {
+        if (reg_list[iter] == NULL || buffers[iter] == NULL)
+        {
+            continue;
+        }
+
+        uint16_t const length        = register_size(reg_list[iter]);
+        size_t         shadow_offset = 0u;
+        if (find_cached_range(
+                reg_list[iter]->address, length, &shadow_offset))
+        {
+            ex10_memcpy(&shadow[shadow_offset],
+                        sizeof(shadow) - shadow_offset,
+                        buffers[iter],
+                        length);
+            set_shadow_valid(shadow_offset, length, true);
+        }
+    }
+}
+
+static void get_stats(struct Ex10RegisterCacheStats* stats)
+{
+    if (stats != NULL)
+    {
+        *stats = cache_stats;
+    }
+}
+
+static void reset_stats(void)
+{
+    ex10_memzero(&cache_stats, sizeof(cache_stats));
+}
+
+static const struct Ex10RegisterCache ex10_register_cache = {
+    .init             = init,
+    .enable           = enable,
+    .is_enabled       = is_enabled,
+    .invalidate       = invalidate,
+    .invalidate_range = invalidate_range,
+    .write_multiple   = write_multiple,
+    .update_from_read = update_from_read,
+    .get_stats        = get_stats,
+    .reset_stats      = reset_stats,
+};
+
+struct Ex10RegisterCache const* get_ex10_register_cache(void)
+{
+    return &ex10_register_cache;
+}
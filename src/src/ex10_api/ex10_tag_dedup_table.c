@@ -0,0 +1,438 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2020 - 2024 Impinj, Inc. All rights reserved.               *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "board/ex10_osal.h"
+#include "ex10_api/ex10_tag_dedup_table.h"
+
+// 32-bit FNV-1a hash parameters.
+#define FNV_OFFSET_BASIS ((uint32_t)2166136261u)
+#define FNV_PRIME ((uint32_t)16777619u)
+
+struct TagDedupTableState
+{
+    struct Ex10TagDedupEntry* entries;
+    size_t                    entry_count;
+    size_t                    max_load;
+    uint64_t                  max_age_us;
+    uint16_t                  lru_head;
+    uint16_t                  lru_tail;
+    struct Ex10TagDedupStats  stats;
+};
+
+static struct TagDedupTableState table = {
+    .entries     = NULL,
+    .entry_count = 0u,
+    .max_load    = 0u,
+    .max_age_us  = 0u,
+    .lru_head    = TAG_DEDUP_NO_ENTRY,
+    .lru_tail    = TAG_DEDUP_NO_ENTRY,
+};
+
+static uint32_t hash_key(uint16_t pc, uint8_t const* epc, size_t epc_length)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    hash          = (hash ^ (uint8_t)(pc >> 8u)) * FNV_PRIME;
+    hash          = (hash ^ (uint8_t)pc) * FNV_PRIME;
+    for (size_t iter = 0u; iter < epc_length; ++iter)
+    {
+        hash = (hash ^ epc[iter]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+static size_t home_slot(uint32_t hash)
+{
+    return (size_t)hash & (table.entry_count - 1u);
+}
+
+static size_t next_slot(size_t slot)
+{
+    return (slot + 1u) & (table.entry_count - 1u);
+}
+
+static bool entry_matches(struct Ex10TagDedupEntry const* entry,
+                          uint32_t                        hash,
+                          uint16_t                        pc,
+                          uint8_t const*                  epc,
+                          size_t                          epc_length)
+{
+    if ((entry->hash != hash) || (entry->pc != pc) ||
+        (entry->epc_length != epc_length))
+    {
+        return false;
+    }
+    for (size_t iter = 0u; iter < epc_length; ++iter)
+    {
+        if (entry->epc[iter] != epc[iter])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Find the slot holding a key, or the empty slot which ends its probe
+ * sequence. The table always holds at least one empty slot, since it is
+ * never filled beyond max_load.
+ */
+static size_t probe(uint32_t       hash,
+                    uint16_t       pc,
+                    uint8_t const* epc,
+                    size_t         epc_length)
+{
+    size_t slot = home_slot(hash);
+    while (table.entries[slot].in_use &&
+           !entry_matches(&table.entries[slot], hash, pc, epc, epc_length))
+    {
+        slot = next_slot(slot);
+    }
+    return slot;
+}
+
+static void lru_unlink(uint16_t slot)
+{
+    struct Ex10TagDedupEntry* entry = &table.entries[slot];
+    if (entry->lru_prev == TAG_DEDUP_NO_ENTRY)
+    {
+        table.lru_head = entry->lru_next;
+    }
+    else
+    {
+        table.entries[entry->lru_prev].lru_next = entry->lru_next;
+    }
+    if (entry->lru_next == TAG_DEDUP_NO_ENTRY)
+    {
+        table.lru_tail = entry->lru_prev;
+    }
+    else
+    {
+        table.entries[entry->lru_next].lru_prev = entry->lru_prev;
+    }
+}
+
+static void lru_push_front(uint16_t slot)
+{
+    struct Ex10TagDedupEntry* entry = &table.entries[slot];
+    entry->lru_prev                 = TAG_DEDUP_NO_ENTRY;
+    entry->lru_next                 = table.lru_head;
+    if (table.lru_head == TAG_DEDUP_NO_ENTRY)
+    {
+        table.lru_tail = slot;
+    }
+    else
+    {
+        table.entries[table.lru_head].lru_prev = slot;
+    }
+    table.lru_head = slot;
+}
+
+/// Move the entry in slot from to the empty slot to, keeping its LRU place.
+static void move_entry(size_t from, size_t to)
+{
+    table.entries[to]          = table.entries[from];
+    table.entries[from].in_use = false;
+
+    struct Ex10TagDedupEntry const* moved = &table.entries[to];
+
+    if (moved->lru_prev == TAG_DEDUP_NO_ENTRY)
+    {
+        table.lru_head = (uint16_t)to;
+    }
+    else
+    {
+        table.entries[moved->lru_prev].lru_next = (uint16_t)to;
+    }
+    if (moved->lru_next == TAG_DEDUP_NO_ENTRY)
+    {
+        table.lru_tail = (uint16_t)to;
+    }
+    else
+    {
+        table.entries[moved->lru_next].lru_prev = (uint16_t)to;
+    }
+}
+
+/**
+ * Remove the entry in a slot. The entries following it in the same probe
+ * run are shifted back, so that no probe sequence is broken by the gap and
+ * no tombstones are needed.
+ */
+static void remove_entry(size_t slot)
+{
+    lru_unlink((uint16_t)slot);
+    table.stats.unique_tags -= 1u;
+    if (table.entries[slot].read_count > 1u)
+    {
+        table.stats.multi_read_tags -= 1u;
+    }
+    table.entries[slot].in_use = false;
+
+    size_t gap  = slot;
+    size_t next = next_slot(slot);
+    while (table.entries[next].in_use)
+    {
+        // The entry can fill the gap if its home slot is not cyclically
+        // within (gap, next].
+        size_t const home = home_slot(table.entries[next].hash);
+        bool const   stays =
+            (gap <= next) ? ((gap < home) && (home <= next))
+                          : ((gap < home) || (home <= next));
+        if (!stays)
+        {
+            move_entry(next, gap);
+            gap = next;
+        }
+        next = next_slot(next);
+    }
+}
+
+static void evict_aged(uint64_t now_us, uint64_t age_us, uint32_t* counter)
+{
+    while (table.lru_tail != TAG_DEDUP_NO_ENTRY)
+    {
+        uint64_t const last_us =
+            table.entries[table.lru_tail].last_timestamp_us;
+        if ((last_us >= now_us) || (now_us - last_us <= age_us))
+        {
+            break;
+        }
+        remove_entry(table.lru_tail);
+        *counter += 1u;
+    }
+}
+
+static void clear(void)
+{
+    for (size_t slot = 0u; slot < table.entry_count; ++slot)
+    {
+        table.entries[slot].in_use = false;
+    }
+    table.lru_head = TAG_DEDUP_NO_ENTRY;
+    table.lru_tail = TAG_DEDUP_NO_ENTRY;
+    ex10_memzero(&table.stats, sizeof(table.stats));
+}
+
+static struct Ex10Result init(struct Ex10TagDedupEntry* entries,
+                              size_t                    entry_count,
+                              uint64_t                  max_age_us)
+{
+    if (entries == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils, Ex10SdkErrorNullPointer);
+    }
+    if ((entry_count < 4u) || (entry_count > TAG_DEDUP_MAX_ENTRIES) ||
+        ((entry_count & (entry_count - 1u)) != 0u))
+    {
+        return make_ex10_sdk_error(Ex10ModuleUtils,
+                                   Ex10SdkErrorBadParamLength);
+    }
+
+    table.entries     = entries;
+    table.entry_count = entry_count;
+    table.max_load    = entry_count - (entry_count / 4u);
+    table.max_age_us  = max_age_us;
+    clear();
+
+    return make_ex10_success();
+}
+
+static struct Ex10TagDedupEntry const* record_read(
+    struct Ex10TagDedupRead const* read,
+    bool*                          is_new)
+{
+    if (is_new != NULL)
+    {
+        *is_new = false;
+    }
+    if ((table.entries == NULL) || (read == NULL))
+    {
+        return NULL;
+    }
+    if (read->epc_length > TAG_DEDUP_EPC_MAX_LENGTH)
+    {
+        table.stats.rejected_reads += 1u;
+        return NULL;
+    }
+
+    if (table.max_age_us > 0u)
+    {
+        evict_aged(read->timestamp_us,
+                   table.max_age_us,
+                   &table.stats.age_evictions);
+    }
+
+    uint32_t const hash =
+        hash_key(read->pc, read->epc, read->epc_length);
+    size_t slot = probe(hash, read->pc, read->epc, read->epc_length);
+
+    struct Ex10TagDedupEntry* entry = &table.entries[slot];
+    if (entry->in_use)
+    {
+        lru_unlink((uint16_t)slot);
+        if (entry->read_count == 1u)
+        {
+            table.stats.multi_read_tags += 1u;
+        }
+        entry->read_count += 1u;
+        if (read->rssi_cdbm > entry->peak_rssi_cdbm)
+        {
+            entry->peak_rssi_cdbm = read->rssi_cdbm;
+        }
+    }
+    else
+    {
+        if (table.stats.unique_tags >= table.max_load)
+        {
+            // Removing the LRU entry may shift entries into the free slot,
+            // so the key is probed for again.
+            remove_entry(table.lru_tail);
+            table.stats.lru_evictions += 1u;
+            slot  = probe(hash, read->pc, read->epc, read->epc_length);
+            entry = &table.entries[slot];
+        }
+
+        ex10_memzero(entry, sizeof(*entry));
+        entry->in_use     = true;
+        entry->pc         = read->pc;
+        entry->epc_length = (uint8_t)read->epc_length;
+        ex10_memcpy(entry->epc,
+                    sizeof(entry->epc),
+                    read->epc,
+                    read->epc_length);
+        entry->hash             = hash;
+        entry->read_count       = 1u;
+        entry->first_us_counter = read->us_counter;
+        entry->peak_rssi_cdbm   = read->rssi_cdbm;
+
+        table.stats.unique_tags += 1u;
+        table.stats.new_tags += 1u;
+        if (is_new != NULL)
+        {
+            *is_new = true;
+        }
+    }
+
+    entry->last_us_counter   = read->us_counter;
+    entry->last_timestamp_us = read->timestamp_us;
+    entry->rssi_sum_cdbm += read->rssi_cdbm;
+    if (read->antenna < 32u)
+    {
+        entry->antenna_bitmap |= (uint32_t)1u << read->antenna;
+    }
+    if (read->channel_index < 64u)
+    {
+        entry->channel_bitmap |= (uint64_t)1u << read->channel_index;
+    }
+    lru_push_front((uint16_t)slot);
+    table.stats.total_reads += 1u;
+
+    return entry;
+}
+
+static struct Ex10TagDedupEntry const* find(uint16_t       pc,
+                                            uint8_t const* epc,
+                                            size_t         epc_length)
+{
+    if ((table.entries == NULL) || (epc_length > TAG_DEDUP_EPC_MAX_LENGTH))
+    {
+        return NULL;
+    }
+
+    size_t const slot =
+        probe(hash_key(pc, epc, epc_length), pc, epc, epc_length);
+    return table.entries[slot].in_use ? &table.entries[slot] : NULL;
+}
+
+static size_t get_unique_count(void)
+{
+    return table.stats.unique_tags;
+}
+
+static size_t get_multi_read_count(void)
+{
+    return table.stats.multi_read_tags;
+}
+
+static int16_t get_mean_rssi_cdbm(struct Ex10TagDedupEntry const* entry)
+{
+    if ((entry == NULL) || (entry->read_count == 0u))
+    {
+        return 0;
+    }
+    return (int16_t)(entry->rssi_sum_cdbm / (int64_t)entry->read_count);
+}
+
+static size_t iterate(tag_dedup_entry_callback_t callback, void* context)
+{
+    size_t count = 0u;
+    for (uint16_t slot = table.lru_head; slot != TAG_DEDUP_NO_ENTRY;
+         slot          = table.entries[slot].lru_next)
+    {
+        callback(&table.entries[slot], context);
+        count += 1u;
+    }
+    return count;
+}
+
+static size_t snapshot(struct Ex10TagDedupEntry* entries, size_t max_entries)
+{
+    size_t count = 0u;
+    for (uint16_t slot = table.lru_head;
+         (slot != TAG_DEDUP_NO_ENTRY) && (count < max_entries);
+         slot = table.entries[slot].lru_next)
+    {
+        entries[count] = table.entries[slot];
+        count += 1u;
+    }
+    return count;
+}
+
+static size_t evict_older_than(uint64_t now_us, uint64_t age_us)
+{
+    uint32_t evicted = 0u;
+    evict_aged(now_us, age_us, &evicted);
+    table.stats.age_evictions += evicted;
+    return evicted;
+}
+
+static void get_stats(struct Ex10TagDedupStats* stats)
+{
+    if (stats != NULL)
+    {
+        *stats = table.stats;
+    }
+}
+
+static const struct Ex10TagDedupTable ex10_tag_dedup_table = {
+    .init                 = init,
+    .clear                = clear,
+    .record_read          = record_read,
+    .find                 = find,
+    .get_unique_count     = get_unique_count,
+    .get_multi_read_count = get_multi_read_count,
+    .get_mean_rssi_cdbm   = get_mean_rssi_cdbm,
+    .iterate              = iterate,
+    .snapshot             = snapshot,
+    .evict_older_than     = evict_older_than,
+    .get_stats            = get_stats,
+};
+
+struct Ex10TagDedupTable const* get_ex10_tag_dedup_table(void)
+{
+    return &ex10_tag_dedup_table;
+}
@@ -0,0 +1,224 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2020 - 2024 Impinj, Inc. All rights reserved.               *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "board/ex10_osal.h"
+#include "ex10_api/ex10_tag_report_stream.h"
+
+/// The number of channel indices whose TagReportRecordChannel is tracked.
+#define ANNOUNCED_CHANNEL_COUNT ((size_t)256u)
+
+#define ANNOUNCED_CHANNEL_WORDS (ANNOUNCED_CHANNEL_COUNT / 32u)
+
+/// The longest pair of records written for one tag read.
+#define TAG_REPORT_MAX_LENGTH                                       \
+    (TAG_REPORT_CHANNEL_RECORD_LENGTH +                             \
+     TAG_REPORT_TAG_READ_HEADER_LENGTH + TAG_REPORT_ID_MAX_LENGTH + \
+     1u + TAG_REPORT_TID_MAX_LENGTH)
+
+struct TagReportStreamState
+{
+    uint8_t*                  buffer;
+    size_t                    buffer_size;
+    size_t                    head;
+    size_t                    tail;
+    size_t                    used;
+    tag_report_sink_t         sink;
+    uint32_t                  announced[ANNOUNCED_CHANNEL_WORDS];
+    struct Ex10TagReportStats stats;
+};
+
+static struct TagReportStreamState stream;
+
+static size_t put_u8(uint8_t* dst, uint8_t value)
+{
+    dst[0] = value;
+    return 1u;
+}
+
+static size_t put_u16(uint8_t* dst, uint16_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8u);
+    return 2u;
+}
+
+static size_t put_u32(uint8_t* dst, uint32_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8u);
+    dst[2] = (uint8_t)(value >> 16u);
+    dst[3] = (uint8_t)(value >> 24u);
+    return 4u;
+}
+
+static size_t put_bytes(uint8_t*       dst,
+                        uint8_t const* src,
+                        size_t         length,
+                        size_t         max_length)
+{
+    size_t const copy_length =
+        (src == NULL) ? 0u : ((length < max_length) ? length : max_length);
+    dst[0] = (uint8_t)copy_length;
+    if (copy_length > 0u)
+    {
+        ex10_memcpy(&dst[1], max_length, src, copy_length);
+    }
+    return 1u + copy_length;
+}
+
+static bool channel_announced(channel_index_t channel_index)
+{
+    if (channel_index >= ANNOUNCED_CHANNEL_COUNT)
+    {
+        return false;
+    }
+    return (stream.announced[channel_index / 32u] &
+            ((uint32_t)1u << (channel_index % 32u))) != 0u;
+}
+
+static void set_channel_announced(channel_index_t channel_index)
+{
+    if (channel_index < ANNOUNCED_CHANNEL_COUNT)
+    {
+        stream.announced[channel_index / 32u] |= (uint32_t)1u
+                                                 << (channel_index % 32u);
+    }
+}
+
+static void init(uint8_t* buffer, size_t buffer_size, tag_report_sink_t sink)
+{
+    ex10_memzero(&stream, sizeof(stream));
+    stream.buffer      = buffer;
+    stream.buffer_size = (buffer == NULL) ? 0u : buffer_size;
+    stream.sink        = sink;
+}
+
+static size_t flush(void)
+{
+    while ((stream.used > 0u) && (stream.sink != NULL))
+    {
+        size_t const contiguous = stream.buffer_size - stream.tail;
+        size_t const length =
+            (stream.used < contiguous) ? stream.used : contiguous;
+
+        size_t taken = stream.sink(&stream.buffer[stream.tail], length);
+        taken        = (taken < length) ? taken : length;
+        stream.stats.sink_calls += 1u;
+        stream.stats.sink_bytes += (uint32_t)taken;
+
+        stream.tail = (stream.tail + taken) % stream.buffer_size;
+        stream.used -= taken;
+        if (taken < length)
+        {
+            break;
+        }
+    }
+    return stream.used;
+}
+
+static void ring_write(uint8_t const* data, size_t length)
+{
+    size_t const contiguous = stream.buffer_size - stream.head;
+    size_t const first      = (length < contiguous) ? length : contiguous;
+
+    ex10_memcpy(&stream.buffer[stream.head], contiguous, data, first);
+    if (first < length)
+    {
+        ex10_memcpy(
+            stream.buffer, stream.buffer_size, &data[first], length - first);
+    }
+    stream.head = (stream.head + length) % stream.buffer_size;
+    stream.used += length;
+}
+
+static bool write_tag_read(struct Ex10TagReport const* report)
+{
+    uint8_t record[TAG_REPORT_MAX_LENGTH];
+    size_t  length = 0u;
+
+    bool const announce = !channel_announced(report->channel_index);
+    if (announce)
+    {
+        length += put_u8(&record[length], TagReportRecordChannel);
+        length += put_u8(&record[length],
+                         (uint8_t)TAG_REPORT_CHANNEL_RECORD_LENGTH);
+        length += put_u16(&record[length], report->channel_index);
+        length += put_u32(&record[length], report->channel_frequency_khz);
+    }
+
+    size_t const start = length;
+    length += put_u8(&record[length], TagReportRecordTagRead);
+    length += put_u8(&record[length], 0u);
+    length += put_u32(&record[length], report->us_counter);
+    length += put_u16(&record[length], report->rf_mode);
+    length += put_u16(&record[length], (uint16_t)report->rssi_cdbm);
+    length += put_u16(&record[length], report->phase_begin);
+    length += put_u16(&record[length], report->phase_end);
+    length += put_u16(&record[length], report->channel_index);
+    length += put_u8(&record[length], report->antenna);
+    length += put_u8(&record[length], (uint8_t)report->target);
+    length += put_u8(&record[length], report->packet_type);
+    length += put_u8(&record[length], report->epc_length);
+    length += put_u8(&record[length], report->flags);
+    length += put_bytes(&record[length],
+                        report->id,
+                        report->id_length,
+                        TAG_REPORT_ID_MAX_LENGTH);
+    length += put_bytes(&record[length],
+                        report->tid,
+                        report->tid_length,
+                        TAG_REPORT_TID_MAX_LENGTH);
+    record[start + 1u] = (uint8_t)(length - start);
+
+    if (stream.buffer_size - stream.used < length)
+    {
+        flush();
+    }
+    if (stream.buffer_size - stream.used < length)
+    {
+        stream.stats.dropped += 1u;
+        return false;
+    }
+
+    ring_write(record, length);
+    if (announce)
+    {
+        set_channel_announced(report->channel_index);
+    }
+    stream.stats.tag_reads += 1u;
+    return true;
+}
+
+static void get_stats(struct Ex10TagReportStats* stats)
+{
+    if (stats != NULL)
+    {
+        *stats = stream.stats;
+    }
+}
+
+static const struct Ex10TagReportStream ex10_tag_report_stream = {
+    .init           = init,
+    .write_tag_read = write_tag_read,
+    .flush          = flush,
+    .get_stats      = get_stats,
+};
+
+struct Ex10TagReportStream const* get_ex10_tag_report_stream(void)
+{
+    return &ex10_tag_report_stream;
+}
@@ -28,16 +28,155 @@ static struct Ex10LinkedList result_free_list;
 
 static ex10_mutex_t list_mutex = EX10_MUTEX_INITIALIZER;
 
+/**
+ * The maximum number of FifoBufferNode descriptors which can be used with
+ * the slab arena; see event_fifo_arena_init().
+ */
+#define FIFO_ARENA_NODES_MAX ((size_t)32u)
+
+/**
+ * The slab arena state used when the event fifo list is initialized with
+ * init_arena(). Slabs are carved from the arena in allocation order, like a
+ * ring buffer, and are returned to the arena in allocation order: a slab
+ * released out of order is held until all older slabs are released. This
+ * matches the in order consumption of EventFifo buffers.
+ */
+struct FifoArena
+{
+    uint8_t* data;    ///< The 32-bit aligned start of the arena.
+    size_t   length;  ///< The usable arena length in bytes.
+    size_t   head;    ///< The arena offset of the next slab to allocate.
+    size_t   tail;    ///< The arena offset of the oldest allocated slab.
+
+    struct FifoBufferNode* nodes;       ///< The node descriptors.
+    size_t                 node_count;  ///< The number of node descriptors.
+
+    /// The arena offset and length of the slab held by each node.
+    size_t slab_offset[FIFO_ARENA_NODES_MAX];
+    size_t slab_length[FIFO_ARENA_NODES_MAX];
+    /// Set when an allocated node has been released out of order.
+    bool slab_released[FIFO_ARENA_NODES_MAX];
+
+    /// The allocated node indices, oldest first, as a ring.
+    size_t alloc_order[FIFO_ARENA_NODES_MAX];
+    size_t alloc_first;
+    size_t alloc_count;
+
+    /// Set when an allocation failed for lack of arena space or nodes.
+    bool alloc_failed;
+};
+
+static struct FifoArena fifo_arena;
+
+static bool arena_owns_node(struct FifoBufferNode const* fifo_buffer_node)
+{
+    return (fifo_arena.nodes != NULL) &&
+           (fifo_buffer_node >= fifo_arena.nodes) &&
+           (fifo_buffer_node < fifo_arena.nodes + fifo_arena.node_count);
+}
+
+static_assert(FIFO_PACKET_MIN_SIZE == sizeof(struct PacketHeader),
+              "FIFO_PACKET_MIN_SIZE must be the packet header size");
+
+/**
+ * Set the packet index storage of a node.
+ *
+ * @param fifo_buffer_node The node.
+ * @param index_data       The 32-bit aligned index storage, or NULL.
+ * @param index_length     The length of index_data in bytes.
+ */
+static void fifo_buffer_node_set_index(struct FifoBufferNode* fifo_buffer_node,
+                                       uint8_t*               index_data,
+                                       size_t                 index_length)
+{
+    fifo_buffer_node->packet_index.entries =
+        (struct FifoPacketIndexEntry*)index_data;
+    fifo_buffer_node->packet_index.capacity =
+        (index_data == NULL)
+            ? 0u
+            : index_length / sizeof(struct FifoPacketIndexEntry);
+}
+
+static void fifo_buffer_node_clear(struct FifoBufferNode* fifo_buffer_node)
+{
+    fifo_buffer_node->packet_index.count          = 0u;
+    fifo_buffer_node->packet_index.indexed_length = 0u;
+    fifo_buffer_node->irq_time_us                 = 0u;
+}
+
+/**
+ * Release an arena node. The node's slab, and those of any following nodes
+ * already released, are returned to the arena once all older slabs have been
+ * returned. Must be called with the list_mutex held.
+ *
+ * @return bool true if an allocation had failed since the last release which
+ *              returned arena space.
+ */
+static bool event_fifo_arena_put(struct FifoBufferNode* event_fifo_buffer_node)
+{
+    size_t const node_index =
+        (size_t)(event_fifo_buffer_node - fifo_arena.nodes);
+    fifo_arena.slab_released[node_index] = true;
+
+    bool space_returned = false;
+    while (fifo_arena.alloc_count > 0u)
+    {
+        size_t const oldest = fifo_arena.alloc_order[fifo_arena.alloc_first];
+        if (fifo_arena.slab_released[oldest] == false)
+        {
+            break;
+        }
+
+        fifo_arena.slab_released[oldest] = false;
+        fifo_arena.alloc_first = (fifo_arena.alloc_first + 1u) %
+                                 FIFO_ARENA_NODES_MAX;
+        fifo_arena.alloc_count -= 1u;
+
+        struct FifoBufferNode* node = &fifo_arena.nodes[oldest];
+        node->fifo_data.length      = 0u;
+        node->raw_buffer.length     = 0u;
+        fifo_buffer_node_clear(node);
+        fifo_buffer_node_set_index(node, NULL, 0u);
+        list_push_back(&event_fifo_free_list, &node->list_node);
+        space_returned = true;
+    }
+
+    if (fifo_arena.alloc_count == 0u)
+    {
+        fifo_arena.head = 0u;
+        fifo_arena.tail = 0u;
+    }
+    else
+    {
+        size_t const oldest = fifo_arena.alloc_order[fifo_arena.alloc_first];
+        fifo_arena.tail     = fifo_arena.slab_offset[oldest];
+    }
+
+    bool const alloc_failed = space_returned && fifo_arena.alloc_failed;
+    if (space_returned)
+    {
+        fifo_arena.alloc_failed = false;
+    }
+    return alloc_failed;
+}
 
 static bool event_fifo_free_list_put(
     struct FifoBufferNode* event_fifo_buffer_node)
 {
     ex10_mutex_lock(&list_mutex);
+    if (arena_owns_node(event_fifo_buffer_node))
+    {
+        bool const alloc_failed = event_fifo_arena_put(event_fifo_buffer_node);
+        ex10_mutex_unlock(&list_mutex);
+        return alloc_failed;
+    }
+
     bool const is_empty = list_is_empty(&event_fifo_free_list);
 
     // It is not necessary that fifo_data.length be set to zero,
     // but it provides a sanity check w.r.t the state of the buffer.
     event_fifo_buffer_node->fifo_data.length = 0u;
+    fifo_buffer_node_clear(event_fifo_buffer_node);
     list_push_back(&event_fifo_free_list, &event_fifo_buffer_node->list_node);
 
     ex10_mutex_unlock(&list_mutex);
@@ -49,6 +188,8 @@ static struct Ex10Result event_fifo_free_list_init(
     struct ByteSpan const* byte_spans,
     size_t                 buffer_count)
 {
+    ex10_memzero(&fifo_arena, sizeof(fifo_arena));
+
     if ((byte_spans == NULL) || (fifo_buffer_nodes == NULL))
     {
         return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
@@ -83,8 +224,25 @@ static struct Ex10Result event_fifo_free_list_init(
                                        Ex10SdkErrorBadParamLength);
         }
 
+        // A buffer with room for the index of a full EventFifo drain after
+        // EX10_EVENT_FIFO_SIZE bytes of data keeps the index at its end.
+        size_t const index_length =
+            FIFO_ARENA_SLAB_SIZE(EX10_EVENT_FIFO_SIZE) - align -
+            EX10_EVENT_FIFO_SIZE;
+        size_t fifo_length = length;
+        if (length >= EX10_EVENT_FIFO_SIZE + index_length)
+        {
+            fifo_length = length - index_length;
+            fifo_buffer_node_set_index(
+                &fifo_buffer_nodes[index], &data[fifo_length], index_length);
+        }
+        else
+        {
+            fifo_buffer_node_set_index(&fifo_buffer_nodes[index], NULL, 0u);
+        }
+
         fifo_buffer_nodes[index].raw_buffer.data   = data;
-        fifo_buffer_nodes[index].raw_buffer.length = length;
+        fifo_buffer_nodes[index].raw_buffer.length = fifo_length;
 
         fifo_buffer_nodes[index].fifo_data.data   = data;
         fifo_buffer_nodes[index].fifo_data.length = 0u;
@@ -97,8 +255,186 @@ static struct Ex10Result event_fifo_free_list_init(
     return make_ex10_success();
 }
 
+static struct Ex10Result event_fifo_arena_init(
+    struct FifoBufferNode* fifo_buffer_nodes,
+    size_t                 node_count,
+    struct ByteSpan const* arena)
+{
+    ex10_memzero(&fifo_arena, sizeof(fifo_arena));
+    list_init(&event_fifo_free_list);
+
+    if ((fifo_buffer_nodes == NULL) || (arena == NULL) ||
+        (arena->data == NULL))
+    {
+        return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
+                                   Ex10SdkErrorNullPointer);
+    }
+
+    if ((node_count == 0u) || (node_count > FIFO_ARENA_NODES_MAX))
+    {
+        return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
+                                   Ex10SdkErrorBadParamValue);
+    }
+
+    // Align the arena start so that every slab, which is a multiple of
+    // 32-bits in length, is 32-bit aligned.
+    uintptr_t const data_address = (uintptr_t)arena->data;
+    size_t const    align        = sizeof(uint32_t);
+    size_t const    offset = (align - data_address % align) % align;
+    if (arena->length < offset)
+    {
+        return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
+                                   Ex10SdkErrorBadParamLength);
+    }
+    size_t const length = ((arena->length - offset) / align) * align;
+
+    // The slab of a full EventFifo drain must fit in the arena.
+    if (length < FIFO_ARENA_SLAB_SIZE(EX10_EVENT_FIFO_SIZE))
+    {
+        return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
+                                   Ex10SdkErrorBadParamLength);
+    }
+
+    for (size_t index = 0u; index < node_count; ++index)
+    {
+        fifo_buffer_nodes[index].raw_buffer.data   = NULL;
+        fifo_buffer_nodes[index].raw_buffer.length = 0u;
+        fifo_buffer_nodes[index].fifo_data.data    = NULL;
+        fifo_buffer_nodes[index].fifo_data.length  = 0u;
+        fifo_buffer_node_clear(&fifo_buffer_nodes[index]);
+        fifo_buffer_node_set_index(&fifo_buffer_nodes[index], NULL, 0u);
+
+        get_ex10_list_node_helper()->init(&fifo_buffer_nodes[index].list_node);
+        fifo_buffer_nodes[index].list_node.data = &fifo_buffer_nodes[index];
+        list_push_back(&event_fifo_free_list,
+                       &fifo_buffer_nodes[index].list_node);
+    }
+
+    ex10_mutex_lock(&list_mutex);
+    fifo_arena.data       = &arena->data[offset];
+    fifo_arena.length     = length;
+    fifo_arena.nodes      = fifo_buffer_nodes;
+    fifo_arena.node_count = node_count;
+    ex10_mutex_unlock(&list_mutex);
+
+    return make_ex10_success();
+}
+
+/**
+ * Find the arena offset for a slab of slab_length bytes.
+ * Must be called with the list_mutex held.
+ *
+ * @return bool true if the slab fits, with its offset in slab_offset.
+ */
+static bool event_fifo_arena_fit(size_t slab_length, size_t* slab_offset)
+{
+    if (fifo_arena.alloc_count == 0u)
+    {
+        *slab_offset = 0u;
+        return slab_length <= fifo_arena.length;
+    }
+
+    if (fifo_arena.head > fifo_arena.tail)
+    {
+        // The free space is after the head and before the tail.
+        if (fifo_arena.length - fifo_arena.head >= slab_length)
+        {
+            *slab_offset = fifo_arena.head;
+            return true;
+        }
+        // Slabs are contiguous; wrap to the start of the arena, leaving the
+        // space at the end unused until the head wraps.
+        *slab_offset = 0u;
+        return fifo_arena.tail >= slab_length;
+    }
+
+    // The head has wrapped; the free space is between the head and the tail.
+    *slab_offset = fifo_arena.head;
+    return fifo_arena.tail - fifo_arena.head >= slab_length;
+}
+
+static struct FifoBufferNode* event_fifo_arena_get(size_t length)
+{
+    // Each slab reserves a 32-bit word ahead of the data for the ReadFifo
+    // response code, keeping the EventFifo packets 32-bit aligned. The
+    // packet index follows the data.
+    size_t const align       = sizeof(uint32_t);
+    size_t const data_length = (length > 0u) ? length : align;
+    size_t const slab_length = FIFO_ARENA_SLAB_SIZE(data_length);
+    size_t const index_offset =
+        align + ((data_length + align - 1u) / align) * align;
+
+    size_t               slab_offset = 0u;
+    struct Ex10ListNode* list_node   = list_front(&event_fifo_free_list);
+    if ((list_node->data == NULL) ||
+        (event_fifo_arena_fit(slab_length, &slab_offset) == false))
+    {
+        fifo_arena.alloc_failed = true;
+        return NULL;
+    }
+
+    list_pop_front(&event_fifo_free_list);
+    struct FifoBufferNode* fifo_buffer =
+        (struct FifoBufferNode*)list_node->data;
+    size_t const node_index = (size_t)(fifo_buffer - fifo_arena.nodes);
+
+    fifo_arena.slab_offset[node_index]   = slab_offset;
+    fifo_arena.slab_length[node_index]   = slab_length;
+    fifo_arena.slab_released[node_index] = false;
+
+    size_t const order_index =
+        (fifo_arena.alloc_first + fifo_arena.alloc_count) %
+        FIFO_ARENA_NODES_MAX;
+    fifo_arena.alloc_order[order_index] = node_index;
+    fifo_arena.alloc_count += 1u;
+    fifo_arena.head = slab_offset + slab_length;
+    if (fifo_arena.alloc_count == 1u)
+    {
+        fifo_arena.tail = slab_offset;
+    }
+
+    uint8_t* data                  = &fifo_arena.data[slab_offset + align];
+    fifo_buffer->raw_buffer.data   = data;
+    fifo_buffer->raw_buffer.length = index_offset - align;
+    fifo_buffer->fifo_data.data    = data;
+    fifo_buffer->fifo_data.length  = 0u;
+    fifo_buffer_node_set_index(fifo_buffer,
+                               &fifo_arena.data[slab_offset + index_offset],
+                               slab_length - index_offset);
+
+    return fifo_buffer;
+}
+
+static struct FifoBufferNode* event_fifo_free_list_get_sized(size_t length)
+{
+    ex10_mutex_lock(&list_mutex);
+
+    struct FifoBufferNode* fifo_buffer = NULL;
+    if (fifo_arena.nodes != NULL)
+    {
+        fifo_buffer = event_fifo_arena_get(length);
+    }
+    else
+    {
+        struct Ex10ListNode* list_node = list_front(&event_fifo_free_list);
+        if (list_node->data)
+        {
+            list_pop_front(&event_fifo_free_list);
+            fifo_buffer = (struct FifoBufferNode*)list_node->data;
+        }
+    }
+
+    ex10_mutex_unlock(&list_mutex);
+    return fifo_buffer;
+}
+
 static struct FifoBufferNode* event_fifo_free_list_get(void)
 {
+    if (fifo_arena.nodes != NULL)
+    {
+        return event_fifo_free_list_get_sized(EX10_EVENT_FIFO_SIZE);
+    }
+
     ex10_mutex_lock(&list_mutex);
 
     struct FifoBufferNode* fifo_buffer = NULL;
@@ -116,16 +452,24 @@ static struct FifoBufferNode* event_fifo_free_list_get(void)
 static size_t event_fifo_free_list_size(void)
 {
     ex10_mutex_lock(&list_mutex);
-    size_t const count = list_size(&event_fifo_free_list);
+    size_t count = list_size(&event_fifo_free_list);
+    if ((fifo_arena.nodes != NULL) && (fifo_arena.alloc_count > 0u) &&
+        (fifo_arena.head == fifo_arena.tail))
+    {
+        // The node descriptors are free but the arena is full.
+        count = 0u;
+    }
     ex10_mutex_unlock(&list_mutex);
     return count;
 }
 
 static struct FifoBufferList const ex10_fifo_buffer_list = {
-    .init           = event_fifo_free_list_init,
-    .free_list_put  = event_fifo_free_list_put,
-    .free_list_get  = event_fifo_free_list_get,
-    .free_list_size = event_fifo_free_list_size,
+    .init                = event_fifo_free_list_init,
+    .init_arena          = event_fifo_arena_init,
+    .free_list_put       = event_fifo_free_list_put,
+    .free_list_get       = event_fifo_free_list_get,
+    .free_list_get_sized = event_fifo_free_list_get_sized,
+    .free_list_size      = event_fifo_free_list_size,
 };
 
 struct FifoBufferList const* get_ex10_fifo_buffer_list(void)
@@ -140,6 +484,7 @@ static bool result_free_list_put(struct FifoBufferNode* fifo_buffer_node)
     // It is not necessary that fifo_data.length be set to zero,
     // but it provides a sanity check w.r.t the state of the buffer.
     fifo_buffer_node->fifo_data.length = 0u;
+    fifo_buffer_node_clear(fifo_buffer_node);
 
     bool const is_empty = list_is_empty(&result_free_list);
     list_push_back(&result_free_list, &fifo_buffer_node->list_node);
@@ -180,6 +525,7 @@ static struct Ex10Result result_free_list_init(
 
         fifo_buffer_nodes[index].fifo_data.data   = byte_spans[index].data;
         fifo_buffer_nodes[index].fifo_data.length = 0u;
+        fifo_buffer_node_set_index(&fifo_buffer_nodes[index], NULL, 0u);
 
         get_ex10_list_node_helper()->init(&fifo_buffer_nodes[index].list_node);
         fifo_buffer_nodes[index].list_node.data = &fifo_buffer_nodes[index];
@@ -205,6 +551,26 @@ static struct FifoBufferNode* result_free_list_get(void)
     return fifo_buffer;
 }
 
+static struct Ex10Result result_free_list_init_arena(
+    struct FifoBufferNode* fifo_buffer_nodes,
+    size_t                 node_count,
+    struct ByteSpan const* arena)
+{
+    (void)fifo_buffer_nodes;
+    (void)node_count;
+    (void)arena;
+
+    // Result packets are always a fixed size; use init().
+    return make_ex10_sdk_error(Ex10ModuleFifoBufferList,
+                               Ex10SdkErrorBadParamValue);
+}
+
+static struct FifoBufferNode* result_free_list_get_sized(size_t length)
+{
+    return (length <= RESULT_FIFO_BUFFER_SIZE_BYTES) ? result_free_list_get()
+                                                     : NULL;
+}
+
 static size_t result_free_list_size(void)
 {
     ex10_mutex_lock(&list_mutex);
@@ -214,10 +580,12 @@ static size_t result_free_list_size(void)
 }
 
 static struct FifoBufferList const ex10_result_buffer_list = {
-    .init           = result_free_list_init,
-    .free_list_put  = result_free_list_put,
-    .free_list_get  = result_free_list_get,
-    .free_list_size = result_free_list_size,
+    .init                = result_free_list_init,
+    .init_arena          = result_free_list_init_arena,
+    .free_list_put       = result_free_list_put,
+    .free_list_get       = result_free_list_get,
+    .free_list_get_sized = result_free_list_get_sized,
+    .free_list_size      = result_free_list_size,
 };
 
 struct FifoBufferList const* get_ex10_result_buffer_list(void)
@@ -227,7 +595,14 @@ struct FifoBufferList const* get_ex10_result_buffer_list(void)
 
 bool ex10_release_buffer_node(struct FifoBufferNode* fifo_buffer_node)
 {
-    if (fifo_buffer_node->raw_buffer.length == RESULT_FIFO_BUFFER_SIZE_BYTES)
+    // Arena slabs are sized to their contents, so the buffer length does not
+    // identify their list.
+    if (arena_owns_node(fifo_buffer_node))
+    {
+        return event_fifo_free_list_put(fifo_buffer_node);
+    }
+    else if (fifo_buffer_node->raw_buffer.length ==
+             RESULT_FIFO_BUFFER_SIZE_BYTES)
     {
         result_free_list_put(fifo_buffer_node);
         return false;
@@ -237,3 +612,35 @@ bool ex10_release_buffer_node(struct FifoBufferNode* fifo_buffer_node)
         return event_fifo_free_list_put(fifo_buffer_node);
     }
 }
+
+bool fifo_packet_index_append(struct FifoBufferNode*        fifo_buffer_node,
+                              struct EventFifoPacket const* packet,
+                              size_t                        packet_offset)
+{
+    struct FifoPacketIndex* packet_index = &fifo_buffer_node->packet_index;
+
+    if ((packet->is_valid == false) ||
+        (packet_index->count >= packet_index->capacity) ||
+        (packet_offset != packet_index->indexed_length) ||
+        (packet_offset > UINT16_MAX) ||
+        (packet->static_data_length > UINT8_MAX))
+    {
+        return false;
+    }
+
+    struct PacketHeader const* packet_header =
+        (struct PacketHeader const*)(fifo_buffer_node->fifo_data.data +
+                                     packet_offset);
+
+    struct FifoPacketIndexEntry* entry =
+        &packet_index->entries[packet_index->count];
+    entry->offset             = (uint16_t)packet_offset;
+    entry->packet_type        = (uint8_t)packet->packet_type;
+    entry->static_data_length = (uint8_t)packet->static_data_length;
+
+    packet_index->count += 1u;
+    packet_index->indexed_length +=
+        packet_header->packet_length * sizeof(uint32_t);
+
+    return true;
+}
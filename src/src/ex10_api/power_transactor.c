@@ -16,6 +16,7 @@
 #include "board/time_helpers.h"
 #include "ex10_api/board_init.h"
 #include "ex10_api/commands.h"
+#include "ex10_api/ex10_register_cache.h"
 
 static struct Ex10DriverList const* _driver_list = NULL;
 
@@ -145,6 +146,8 @@ static int power_up_to_application(void)
 {
     _driver_list->gpio_if.irq_enable(false);
     ex10_power_up_to_application();
+    get_ex10_register_cache()->invalidate();
+    get_ex10_protocol()->invalidate_read_cache();
     _driver_list->host_if.close();
     int error = _driver_list->host_if.open(BOOTLOADER_SPI_CLOCK_HZ);
     _driver_list->gpio_if.irq_enable(true);
@@ -165,10 +168,11 @@ static int power_up_to_application(void)
 
     if ((error == 0) && (running_location == Application))
     {
-        // Application execution confirmed. Set the SPI clock rate to 4 MHz.
+        // Application execution confirmed. Set the Application SPI clock.
         _driver_list->gpio_if.irq_enable(false);
         _driver_list->host_if.close();
-        error = _driver_list->host_if.open(DEFAULT_SPI_CLOCK_HZ);
+        error = _driver_list->host_if.open(
+            get_ex10_protocol()->get_application_spi_clock());
         _driver_list->gpio_if.irq_enable(true);
     }
 
@@ -185,6 +189,8 @@ static void power_up_to_bootloader(void)
 {
     _driver_list->gpio_if.irq_enable(false);
     ex10_power_up_to_bootloader();
+    get_ex10_register_cache()->invalidate();
+    get_ex10_protocol()->invalidate_read_cache();
     _driver_list->gpio_if.irq_enable(true);
 }
 
@@ -192,6 +198,8 @@ static void power_down(void)
 {
     _driver_list->gpio_if.irq_enable(false);
     ex10_power_down();
+    get_ex10_register_cache()->invalidate();
+    get_ex10_protocol()->invalidate_read_cache();
     _driver_list->gpio_if.irq_enable(true);
 }
 
@@ -57,7 +57,8 @@ struct ActivitySequenceState
     volatile size_t activity_iter;
 
     /// If true, publish all packets.
-    /// If false, publish TagRead and InventoryRoundSummary packets.
+    /// If false, publish TagRead, TagReadExtended and InventoryRoundSummary
+    /// packets.
     bool publish_all_packets;
 
     /// The callback to notify the subscriber of a new packet.
@@ -66,6 +67,12 @@ struct ActivitySequenceState
     void (*packet_subscriber_callback)(struct EventFifoPacket const*,
                                        struct Ex10Result*);
 
+    /// When set, called with each batch of packets in place of
+    /// packet_subscriber_callback.
+    void (*packet_batch_subscriber_callback)(struct EventFifoPacket const*,
+                                             size_t,
+                                             struct Ex10Result*);
+
     /// Registers a callback to take place before each activity in the activty
     /// sequence. This allows for special actions to prepare for activities as
     /// well as the ability to alter the sequence based on info from the
@@ -788,6 +795,15 @@ static void register_packet_subscriber_callback(
     sequence_state.packet_subscriber_callback = packet_subscriber_callback;
 }
 
+static void register_packet_batch_subscriber_callback(
+    void (*packet_batch_subscriber_callback)(struct EventFifoPacket const*,
+                                             size_t,
+                                             struct Ex10Result*))
+{
+    sequence_state.packet_batch_subscriber_callback =
+        packet_batch_subscriber_callback;
+}
+
 static void register_pre_activity_callback(void (
     *pre_activity_callback)(struct ActivityCallbackInfo*, struct Ex10Result*))
 {
@@ -817,6 +833,118 @@ static struct InventoryRoundConfigBasic const* get_inventory_round(void)
     return get_basic_inventory_round_config(sequence_state.activity_iter);
 }
 
+/// The packet types sent to the packet subscriber when filtering.
+static enum EventPacketType const filtered_packet_types[] = {
+    TagRead,
+    TagReadExtended,
+    InventoryRoundSummary,
+};
+
+static bool packet_is_published(enum EventPacketType packet_type)
+{
+    if (sequence_state.publish_all_packets)
+    {
+        return true;
+    }
+    for (size_t iter = 0u; iter < ARRAY_SIZE(filtered_packet_types); ++iter)
+    {
+        if (filtered_packet_types[iter] == packet_type)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// The published packets of a batch, when the packet filter is enabled.
+static struct EventFifoPacket published_batch[EVENT_FIFO_PACKET_BATCH_SIZE];
+
+/**
+ * Deliver the packets in the EventFifo queue to the batch subscriber, one
+ * callback per batch, with the same bookkeeping and filtering as
+ * publish_packets() does per packet.
+ *
+ * @param ex10_result   Set to the result of an Ex10ResultPacket, or passed to
+ *                      the subscriber.
+ * @param sequence_done Set true if the subscriber stops the sequence.
+ *
+ * @return bool true if an Ex10ResultPacket was encountered and publishing
+ *              must stop.
+ */
+static bool publish_packet_batches(struct Ex10Result* ex10_result,
+                                   bool*              sequence_done)
+{
+    struct Ex10EventFifoQueue const* event_fifo_queue =
+        get_ex10_event_fifo_queue();
+    struct EventFifoPacket const* packets = NULL;
+
+    size_t packet_count = event_fifo_queue->packet_peek_batch(&packets);
+    while (packet_count > 0u)
+    {
+        // Packets following an Ex10ResultPacket are not delivered.
+        size_t deliver_count   = 0u;
+        size_t published_count = 0u;
+        for (; deliver_count < packet_count; ++deliver_count)
+        {
+            struct EventFifoPacket const* packet = &packets[deliver_count];
+            if (packet->packet_type == Ex10ResultPacket)
+            {
+                break;
+            }
+
+            if (sequence_state.publish_all_packets == false &&
+                packet_is_published(packet->packet_type))
+            {
+                published_batch[published_count] = *packet;
+                published_count += 1u;
+            }
+
+            if ((packet->packet_type == InventoryRoundSummary) &&
+                (sequence_state.inventory_round_pending > 0))
+            {
+                // If we are waiting on an inventory round to finish,
+                // decrement the counter
+                sequence_state.inventory_round_pending--;
+            }
+        }
+
+        struct EventFifoPacket const* published_packets = published_batch;
+        if (sequence_state.publish_all_packets)
+        {
+            published_packets = packets;
+            published_count   = deliver_count;
+        }
+
+        if (published_count > 0u)
+        {
+            sequence_state.packet_batch_subscriber_callback(
+                published_packets, published_count, ex10_result);
+            // The inventory may be stopped by the client application,
+            // without creating an error condition.
+            if ((ex10_result->customer == true) ||
+                (ex10_result->result_code.raw != 0u))
+            {
+                *sequence_done = true;
+            }
+        }
+
+        if (deliver_count < packet_count)
+        {
+            struct EventFifoPacket const* packet = &packets[deliver_count];
+            *ex10_result = packet->static_data->ex10_result_packet.ex10_result;
+
+            get_ex10_event_fifo_printer()->print_packets(packet);
+            event_fifo_queue->packet_remove_batch();
+            return true;
+        }
+
+        event_fifo_queue->packet_remove_batch();
+        packet_count = event_fifo_queue->packet_peek_batch(&packets);
+    }
+
+    return false;
+}
+
 static struct Ex10Result publish_packets(void)
 {
     struct Ex10Result ex10_result = make_ex10_success();
@@ -852,7 +980,18 @@ static struct Ex10Result publish_packets(void)
 
         uint32_t const packet_wait_timeout_us = 200u * 1000u;
         event_fifo_queue->packet_wait_with_timeout(packet_wait_timeout_us);
-        packet = event_fifo_queue->packet_peek();
+        if (sequence_state.packet_batch_subscriber_callback != NULL)
+        {
+            if (publish_packet_batches(&ex10_result, &sequence_done))
+            {
+                return ex10_result;
+            }
+            packet = NULL;
+        }
+        else
+        {
+            packet = event_fifo_queue->packet_peek();
+        }
         while (packet != NULL)
         {
             if (packet->packet_type == Ex10ResultPacket)
@@ -874,7 +1013,8 @@ static struct Ex10Result publish_packets(void)
                 }
             }
 
-            if (sequence_state.packet_subscriber_callback != NULL)
+            if (sequence_state.packet_subscriber_callback != NULL &&
+                packet_is_published(packet->packet_type))
             {
                 sequence_state.packet_subscriber_callback(packet, &ex10_result);
                 // The inventory may be stopped by the client application,
@@ -973,6 +1113,8 @@ static struct Ex10ActivitySequenceUseCase ex10_activity_sequence_use_case = {
     .register_packet_subscriber_callback = register_packet_subscriber_callback,
     .register_pre_activity_callback      = register_pre_activity_callback,
     .register_post_activity_callback     = register_post_activity_callback,
+    .register_packet_batch_subscriber_callback =
+        register_packet_batch_subscriber_callback,
     .enable_packet_filter                = enable_packet_filter,
     .get_activity_sequence               = get_activity_sequence,
     .get_inventory_round                 = get_inventory_round,
@@ -75,6 +75,13 @@ static void register_packet_subscriber_callback(
         ->register_packet_subscriber_callback(callback);
 }
 
+static void register_packet_batch_subscriber_callback(
+    void (*callback)(struct EventFifoPacket const*, size_t, struct Ex10Result*))
+{
+    get_ex10_continuous_inventory_use_case()
+        ->register_packet_batch_subscriber_callback(callback);
+}
+
 static void enable_packet_filter(bool enable_filter)
 {
     get_ex10_continuous_inventory_use_case()->enable_packet_filter(
@@ -137,6 +144,7 @@ static struct Ex10ContinuousInventoryStartUseCase ex10_continuous_inventory_star
     .init                                 = init,
     .deinit                               = deinit,
     .register_packet_subscriber_callback  = register_packet_subscriber_callback,
+    .register_packet_batch_subscriber_callback = register_packet_batch_subscriber_callback,
     .enable_packet_filter                 = enable_packet_filter,
     .enable_tag_read_extended_packet      = enable_tag_read_extended_packet,
     .continuous_inventory                 = continuous_inventory,
@@ -23,6 +23,7 @@
 #include "ex10_api/event_packet_parser.h"
 #include "ex10_api/ex10_active_region.h"
 #include "ex10_api/ex10_boot_health.h"
+#include "ex10_api/ex10_device_time.h"
 #include "ex10_api/ex10_event_fifo_queue.h"
 #include "ex10_api/ex10_inventory.h"
 #include "ex10_api/ex10_macros.h"
@@ -115,9 +116,27 @@ struct ContinuousInventoryState
     // TagReadExtended event FIFO packets.
     bool use_tag_read_extended;
 
+    // If true, the adaptive EventFifo threshold controller runs for the
+    // duration of each continuous inventory.
+    bool adaptive_event_fifo_threshold;
+
     /// The callback to notify the subscriber of a new packet.
     void (*packet_subscriber_callback)(struct EventFifoPacket const*,
                                        struct Ex10Result*);
+
+    /// The callback to notify the subscriber of a batch of packets. When set,
+    /// it is used in place of packet_subscriber_callback.
+    void (*packet_batch_subscriber_callback)(struct EventFifoPacket const*,
+                                             size_t,
+                                             struct Ex10Result*);
+
+    /// The callback to notify the observer of a packet of one of the
+    /// observer_packet_types, regardless of the packet filter.
+    void (*packet_observer_callback)(struct EventFifoPacket const*);
+
+    /// The packet types passed to packet_observer_callback.
+    enum EventPacketType observer_packet_types[PACKET_OBSERVER_TYPES_MAX];
+    size_t               observer_packet_type_count;
 };
 
 /**
@@ -131,6 +150,7 @@ static bool                            inventory_dual_target;
 static struct ContinuousInventoryState inventory_state;
 static struct StopConditions           stop_conditions;
 static uint32_t                        start_time_us;
+static uint64_t                        start_timestamp_us;
 
 
 static bool check_stop_conditions(uint32_t timestamp_us)
@@ -160,13 +180,13 @@ static bool check_stop_conditions(uint32_t timestamp_us)
     }
     if (stop_conditions.max_duration_us > 0u)
     {
-        // Packet before start checks for packets which occurred before the
-        // continuous inventory round was started.
-        bool const     packet_before_start = (start_time_us > timestamp_us);
-        uint32_t const elapsed_us =
-            (packet_before_start)
-                ? ((UINT32_MAX - start_time_us) + timestamp_us + 1)
-                : (timestamp_us - start_time_us);
+        // Packets which occurred before the continuous inventory round was
+        // started have no elapsed time.
+        uint64_t const time_us =
+            get_ex10_device_time()->extend_us_counter(timestamp_us);
+        uint64_t const elapsed_us = (time_us > start_timestamp_us)
+                                        ? (time_us - start_timestamp_us)
+                                        : 0u;
         if (elapsed_us >= stop_conditions.max_duration_us)
         {
             inventory_state.stop_reason = SRMaxDuration;
@@ -483,13 +503,20 @@ static bool interrupt_handler(struct InterruptStatusFields irq_status)
 // interrupt.
 static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
 {
-    struct ConstByteSpan bytes       = fifo_buffer_node->fifo_data;
-    const size_t         byte_length = bytes.length;
+    struct Ex10EventParser const* event_parser = get_ex10_event_parser();
+    struct ConstByteSpan          bytes        = fifo_buffer_node->fifo_data;
+    const size_t                  byte_length  = bytes.length;
     while (bytes.length > 0u)
     {
-        const size_t parsed_byte_length            = byte_length - bytes.length;
-        struct Ex10EventParser const* event_parser = get_ex10_event_parser();
-        struct EventFifoPacket        packet =
+        // Filtered packets are neither parsed nor indexed.
+        event_parser->skip_unsubscribed_packets(&bytes);
+        if (bytes.length == 0u)
+        {
+            break;
+        }
+
+        const size_t           parsed_byte_length = byte_length - bytes.length;
+        struct EventFifoPacket packet =
             event_parser->parse_event_packet(&bytes);
         if (event_parser->get_packet_type_valid(packet.packet_type) == false)
         {
@@ -502,6 +529,9 @@ static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
             break;
         }
 
+        // Record the packet so the EventFifo queue need not parse it again.
+        fifo_packet_index_append(fifo_buffer_node, &packet, parsed_byte_length);
+
         if (packet.packet_type == TagRead ||
             packet.packet_type == TagReadExtended)
         {
@@ -537,6 +567,7 @@ static struct Ex10Result init(void)
     ex10_memzero(&stop_conditions, sizeof(stop_conditions));
     inventory_state.state = InvIdle;
     start_time_us         = 0u;
+    start_timestamp_us    = 0u;
 
     get_ex10_event_fifo_queue()->init();
     get_ex10_gen2_tx_command_manager()->init();
@@ -589,6 +620,40 @@ static void register_packet_subscriber_callback(
     inventory_state.packet_subscriber_callback = callback;
 }
 
+static void register_packet_batch_subscriber_callback(
+    void (*callback)(struct EventFifoPacket const*, size_t, struct Ex10Result*))
+{
+    inventory_state.packet_batch_subscriber_callback = callback;
+}
+
+static struct Ex10Result register_packet_observer_callback(
+    void (*callback)(struct EventFifoPacket const*),
+    enum EventPacketType const* packet_types,
+    size_t                      count)
+{
+    if (callback != NULL && packet_types == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUseCase, Ex10SdkErrorNullPointer);
+    }
+    if (count > PACKET_OBSERVER_TYPES_MAX)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUseCase,
+                                   Ex10SdkErrorBadParamLength);
+    }
+
+    inventory_state.packet_observer_callback   = callback;
+    inventory_state.observer_packet_type_count = 0u;
+    if (callback != NULL)
+    {
+        for (size_t iter = 0u; iter < count; ++iter)
+        {
+            inventory_state.observer_packet_types[iter] = packet_types[iter];
+        }
+        inventory_state.observer_packet_type_count = count;
+    }
+    return make_ex10_success();
+}
+
 static void enable_packet_filter(bool enable_filter)
 {
     inventory_state.publish_all_packets = (enable_filter == false);
@@ -619,11 +684,178 @@ static void enable_tag_read_extended_packet(bool enable)
     inventory_state.use_tag_read_extended = enable;
 }
 
+static void enable_adaptive_event_fifo_threshold(bool enable)
+{
+    inventory_state.adaptive_event_fifo_threshold = enable;
+}
+
 static enum StopReason get_continuous_inventory_stop_reason(void)
 {
     return inventory_state.stop_reason;
 }
 
+/// The packet types sent to the packet subscriber when filtering.
+static enum EventPacketType const filtered_packet_types[] = {
+    TagRead,
+    TagReadExtended,
+    ContinuousInventorySummary,
+    Gen2Transaction,
+    Custom,
+};
+
+static bool packet_is_published(enum EventPacketType packet_type)
+{
+    if (inventory_state.publish_all_packets)
+    {
+        return true;
+    }
+    for (size_t iter = 0u; iter < ARRAY_SIZE(filtered_packet_types); ++iter)
+    {
+        if (filtered_packet_types[iter] == packet_type)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool packet_is_observed(enum EventPacketType packet_type)
+{
+    if (inventory_state.packet_observer_callback == NULL)
+    {
+        return false;
+    }
+    for (size_t iter = 0u; iter < inventory_state.observer_packet_type_count;
+         ++iter)
+    {
+        if (inventory_state.observer_packet_types[iter] == packet_type)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// The packet types delivered by the event parser when filtering: the
+/// published packet types followed by the observed packet types.
+static enum EventPacketType
+    parser_packet_types[ARRAY_SIZE(filtered_packet_types) +
+                        PACKET_OBSERVER_TYPES_MAX];
+
+/**
+ * Install the packet filter into the event parser, so that packets which are
+ * neither published nor observed are skipped without being parsed.
+ */
+static void set_event_parser_packet_filter(void)
+{
+    struct Ex10EventParser const* event_parser = get_ex10_event_parser();
+    if (inventory_state.publish_all_packets)
+    {
+        event_parser->set_packet_type_filter(NULL, 0u);
+        return;
+    }
+
+    size_t count = 0u;
+    for (size_t iter = 0u; iter < ARRAY_SIZE(filtered_packet_types); ++iter)
+    {
+        parser_packet_types[count++] = filtered_packet_types[iter];
+    }
+    if (inventory_state.packet_observer_callback != NULL)
+    {
+        for (size_t iter = 0u;
+             iter < inventory_state.observer_packet_type_count;
+             ++iter)
+        {
+            parser_packet_types[count++] =
+                inventory_state.observer_packet_types[iter];
+        }
+    }
+    event_parser->set_packet_type_filter(parser_packet_types, count);
+}
+
+/// The published packets of a batch, when the packet filter is enabled.
+static struct EventFifoPacket published_batch[EVENT_FIFO_PACKET_BATCH_SIZE];
+
+/**
+ * Deliver the packets at the front of the EventFifo queue to the batch
+ * subscriber with a single callback. The packets are checked for errors and
+ * the end of the inventory, and filtered, as in publish_packets().
+ *
+ * @param ex10_result Set to the result of any Ex10ResultPacket, then passed
+ *                    to the subscriber.
+ *
+ * @return bool true if the ContinuousInventorySummary packet was delivered.
+ */
+static bool publish_packet_batch(struct Ex10Result* ex10_result)
+{
+    struct Ex10EventFifoQueue const* event_fifo_queue =
+        get_ex10_event_fifo_queue();
+    struct EventFifoPacket const* packets = NULL;
+    size_t const packet_count = event_fifo_queue->packet_peek_batch(&packets);
+
+    bool   inventory_done  = false;
+    size_t published_count = 0u;
+    for (size_t index = 0u; index < packet_count; ++index)
+    {
+        struct EventFifoPacket const* packet = &packets[index];
+        if (packet_is_observed(packet->packet_type))
+        {
+            inventory_state.packet_observer_callback(packet);
+        }
+        if (inventory_state.publish_all_packets == false &&
+            packet_is_published(packet->packet_type))
+        {
+            published_batch[published_count] = *packet;
+            published_count += 1u;
+        }
+
+        if (packet->packet_type == InvalidPacket)
+        {
+            ex10_eprintf("Invalid packet occurred with no known cause\n");
+            *ex10_result = make_ex10_sdk_error(Ex10ModuleUseCase,
+                                               Ex10InvalidEventFifoPacket);
+        }
+        else if (packet->packet_type == Ex10ResultPacket)
+        {
+            *ex10_result = packet->static_data->ex10_result_packet.ex10_result;
+
+            get_ex10_event_fifo_printer()->print_packets(packet);
+        }
+        else if (packet->packet_type == ContinuousInventorySummary)
+        {
+            inventory_done = true;
+        }
+    }
+
+    if (inventory_state.publish_all_packets)
+    {
+        published_count = packet_count;
+    }
+    else
+    {
+        packets = published_batch;
+    }
+
+    if (published_count > 0u)
+    {
+        inventory_state.packet_batch_subscriber_callback(
+            packets, published_count, ex10_result);
+        // The inventory may be stopped by the client application,
+        // without creating an error condition.
+        if ((ex10_result->customer == true) ||
+            (ex10_result->result_code.raw != 0u))
+        {
+            inventory_state.state = InvStopRequested;
+        }
+    }
+    if (packet_count > 0u)
+    {
+        event_fifo_queue->packet_remove_batch();
+    }
+
+    return inventory_done;
+}
+
 static struct Ex10Result publish_packets(void)
 {
     bool inventory_done = false;
@@ -660,6 +892,12 @@ static struct Ex10Result publish_packets(void)
 
         uint32_t const packet_wait_timeout_us = 200u * 1000u;
         event_fifo_queue->packet_wait_with_timeout(packet_wait_timeout_us);
+        if (inventory_state.packet_batch_subscriber_callback != NULL)
+        {
+            inventory_done = publish_packet_batch(&ex10_result);
+            continue;
+        }
+
         packet = event_fifo_queue->packet_peek();
 
         if (packet != NULL)
@@ -682,14 +920,14 @@ static struct Ex10Result publish_packets(void)
                 inventory_done = true;
             }
 
+            if (packet_is_observed(packet->packet_type))
+            {
+                inventory_state.packet_observer_callback(packet);
+            }
+
             if (inventory_state.packet_subscriber_callback != NULL)
             {
-                if (inventory_state.publish_all_packets ||
-                    packet->packet_type == TagRead ||
-                    packet->packet_type == TagReadExtended ||
-                    packet->packet_type == ContinuousInventorySummary ||
-                    packet->packet_type == Gen2Transaction ||
-                    packet->packet_type == Custom)
+                if (packet_is_published(packet->packet_type))
                 {
                     inventory_state.packet_subscriber_callback(packet,
                                                                &ex10_result);
@@ -768,7 +1006,48 @@ static void set_use_case_parameters(
 
 static void set_inventory_timer_start(void)
 {
-    start_time_us = get_ex10_ops()->get_device_time();
+    start_time_us      = get_ex10_ops()->get_device_time();
+    start_timestamp_us =
+        get_ex10_device_time()->anchor_us_counter(start_time_us);
+}
+
+/**
+ * Enable the adaptive EventFifo threshold controller, with the SDK default
+ * limits, if it was enabled for the use case.
+ */
+static struct Ex10Result start_adaptive_event_fifo_threshold(void)
+{
+    if (inventory_state.adaptive_event_fifo_threshold == false)
+    {
+        return make_ex10_success();
+    }
+    return get_ex10_protocol()->enable_adaptive_event_fifo_threshold(true,
+                                                                     NULL);
+}
+
+/**
+ * Disable the adaptive EventFifo threshold controller, restoring
+ * DEFAULT_EVENT_FIFO_THRESHOLD, if it was enabled for the use case.
+ *
+ * @param ex10_result The result of the inventory.
+ *
+ * @return struct Ex10Result The result of the inventory if it failed,
+ *         otherwise the result of disabling the controller.
+ */
+static struct Ex10Result end_adaptive_event_fifo_threshold(
+    struct Ex10Result ex10_result)
+{
+    if (inventory_state.adaptive_event_fifo_threshold)
+    {
+        struct Ex10Result const disable_result =
+            get_ex10_protocol()->enable_adaptive_event_fifo_threshold(false,
+                                                                      NULL);
+        if (ex10_result.error == false)
+        {
+            ex10_result = disable_result;
+        }
+    }
+    return ex10_result;
 }
 
 static struct Ex10Result continuous_inventory(
@@ -819,21 +1098,29 @@ static struct Ex10Result continuous_inventory(
 
     set_inventory_timer_start();
 
-    // Begin inventory
-    struct Ex10Result const ex10_result =
-        get_ex10_inventory()->start_inventory(params->antenna,
-                                              params->rf_mode,
-                                              params->tx_power_cdbm,
-                                              &inventory_config,
-                                              &inventory_config_2,
-                                              params->send_selects);
+    set_event_parser_packet_filter();
+
+    struct Ex10Result ex10_result = start_adaptive_event_fifo_threshold();
     if (ex10_result.error)
     {
         inventory_state.state = InvIdle;
         return ex10_result;
     }
 
-    return publish_packets();
+    // Begin inventory
+    ex10_result = get_ex10_inventory()->start_inventory(params->antenna,
+                                                        params->rf_mode,
+                                                        params->tx_power_cdbm,
+                                                        &inventory_config,
+                                                        &inventory_config_2,
+                                                        params->send_selects);
+    if (ex10_result.error)
+    {
+        inventory_state.state = InvIdle;
+        return end_adaptive_event_fifo_threshold(ex10_result);
+    }
+
+    return end_adaptive_event_fifo_threshold(publish_packets());
 }
 
 // clang-format off
@@ -841,12 +1128,15 @@ static struct Ex10ContinuousInventoryUseCase ex10_continuous_inventory_use_case
     .init                                 = init,
     .deinit                               = deinit,
     .register_packet_subscriber_callback  = register_packet_subscriber_callback,
+    .register_packet_batch_subscriber_callback = register_packet_batch_subscriber_callback,
+    .register_packet_observer_callback    = register_packet_observer_callback,
     .enable_packet_filter                 = enable_packet_filter,
     .enable_auto_access                   = enable_auto_access,
     .enable_abort_on_fail                 = enable_abort_on_fail,
     .enable_fast_id                       = enable_fast_id,
     .enable_tag_focus                     = enable_tag_focus,
     .enable_tag_read_extended_packet      = enable_tag_read_extended_packet,
+    .enable_adaptive_event_fifo_threshold = enable_adaptive_event_fifo_threshold,
     .continuous_inventory                 = continuous_inventory,
     .get_continuous_inventory_stop_reason = get_continuous_inventory_stop_reason,
     .set_use_case_parameters = set_use_case_parameters,
@@ -76,6 +76,16 @@ static void register_packet_subscriber_callback(
         packet_subscriber_callback);
 }
 
+static void register_packet_batch_subscriber_callback(
+    void (*packet_batch_subscriber_callback)(struct EventFifoPacket const*,
+                                             size_t,
+                                             struct Ex10Result*))
+{
+    get_ex10_activity_sequence_use_case()
+        ->register_packet_batch_subscriber_callback(
+            packet_batch_subscriber_callback);
+}
+
 static void enable_packet_filter(bool enable_filter)
 {
     get_ex10_activity_sequence_use_case()->enable_packet_filter(enable_filter);
@@ -141,6 +151,8 @@ static struct Ex10InventorySequenceUseCase ex10_inventory_sequence_use_case = {
     .init                                = init,
     .deinit                              = deinit,
     .register_packet_subscriber_callback = register_packet_subscriber_callback,
+    .register_packet_batch_subscriber_callback =
+        register_packet_batch_subscriber_callback,
     .enable_packet_filter                = enable_packet_filter,
     .get_inventory_sequence              = get_inventory_sequence,
     .get_inventory_round                 = get_inventory_round,
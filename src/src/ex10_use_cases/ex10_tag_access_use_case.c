@@ -199,9 +199,11 @@ static bool interrupt_handler(struct InterruptStatusFields irq_status)
 // though the event fifo queue.
 static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
 {
-    struct ConstByteSpan bytes = fifo_buffer_node->fifo_data;
+    struct ConstByteSpan bytes       = fifo_buffer_node->fifo_data;
+    const size_t         byte_length = bytes.length;
     while (bytes.length > 0u)
     {
+        const size_t parsed_byte_length            = byte_length - bytes.length;
         struct Ex10EventParser const* event_parser = get_ex10_event_parser();
         struct EventFifoPacket const  packet =
             event_parser->parse_event_packet(&bytes);
@@ -215,7 +217,11 @@ static void fifo_data_handler(struct FifoBufferNode* fifo_buffer_node)
                 bytes.length);
             break;
         }
-        else if (packet.packet_type == TagRead &&
+
+        // Record the packet so the EventFifo queue need not parse it again.
+        fifo_packet_index_append(fifo_buffer_node, &packet, parsed_byte_length);
+
+        if (packet.packet_type == TagRead &&
                  packet.static_data->tag_read.halted_on_tag)
         {
             // got a TagRead with a successful halt
@@ -0,0 +1,227 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "board/ex10_osal.h"
+#include "include_gen2x/ex10_api/ex10_stored_crc_epc_map_gen2x.h"
+
+#include "ex10_stored_crc_hash_gen2x.h"
+
+static bool round_is_current(struct StoredCrcEpcMapGen2X const* map,
+                             uint32_t                           round_stamp)
+{
+    return (round_stamp != 0u) &&
+           (map->round - round_stamp <= map->max_age_rounds);
+}
+
+static bool epc_matches(struct StoredCrcEpcEntryGen2X const* entry,
+                        uint16_t                             pc,
+                        uint8_t const*                       epc,
+                        size_t                               epc_length)
+{
+    if ((entry->pc != pc) || (entry->epc_length != epc_length))
+    {
+        return false;
+    }
+    for (size_t iter = 0u; iter < epc_length; ++iter)
+    {
+        if (entry->epc[iter] != epc[iter])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t first_slot(struct StoredCrcEpcMapGen2X const* map,
+                         uint16_t                           stored_crc)
+{
+    return stored_crc_hash_first_slot(stored_crc, map->hash_shift);
+}
+
+static size_t probe_limit(struct StoredCrcEpcMapGen2X const* map)
+{
+    return stored_crc_hash_probe_limit(map->entry_count,
+                                       STORED_CRC_EPC_MAP_PROBE_LIMIT);
+}
+
+static struct Ex10Result init(struct StoredCrcEpcMapGen2X*   map,
+                              struct StoredCrcEpcEntryGen2X* entries,
+                              size_t                         entry_count,
+                              uint32_t                       max_age_rounds)
+{
+    if (map == NULL || entries == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUseCase, Ex10SdkErrorNullPointer);
+    }
+    if (stored_crc_hash_entry_count_is_valid(entry_count) == false)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUseCase,
+                                   Ex10SdkErrorBadParamLength);
+    }
+
+    ex10_memzero(entries, entry_count * sizeof(*entries));
+    map->entries        = entries;
+    map->entry_count    = entry_count;
+    map->hash_shift     = stored_crc_hash_shift(entry_count);
+    map->max_age_rounds = max_age_rounds;
+    map->round          = 1u;
+    map->evictions      = 0u;
+
+    return make_ex10_success();
+}
+
+static void advance_round(struct StoredCrcEpcMapGen2X* map)
+{
+    map->round += 1u;
+}
+
+/**
+ * Find the slot of a StoredCRC, or the slot to store it in: the first
+ * free or expired slot, else the least recently added entry.
+ */
+static struct StoredCrcEpcEntryGen2X* find_slot(
+    struct StoredCrcEpcMapGen2X* map,
+    uint16_t                     stored_crc)
+{
+    size_t const mask  = map->entry_count - 1u;
+    size_t const limit = probe_limit(map);
+    size_t const first = first_slot(map, stored_crc);
+
+    struct StoredCrcEpcEntryGen2X* free_entry   = NULL;
+    struct StoredCrcEpcEntryGen2X* oldest_entry = NULL;
+
+    for (size_t iter = 0u; iter < limit; ++iter)
+    {
+        struct StoredCrcEpcEntryGen2X* entry =
+            &map->entries[(first + iter) & mask];
+        if (entry->round_stamp == 0u)
+        {
+            // Nothing was ever stored beyond an unused slot.
+            return (free_entry != NULL) ? free_entry : entry;
+        }
+        if (entry->stored_crc == stored_crc)
+        {
+            return entry;
+        }
+        if (!round_is_current(map, entry->round_stamp))
+        {
+            if (free_entry == NULL)
+            {
+                free_entry = entry;
+            }
+        }
+        else if ((oldest_entry == NULL) ||
+                 (entry->round_stamp < oldest_entry->round_stamp))
+        {
+            oldest_entry = entry;
+        }
+    }
+
+    if (free_entry == NULL)
+    {
+        map->evictions += 1u;
+        return oldest_entry;
+    }
+    return free_entry;
+}
+
+static void add(struct StoredCrcEpcMapGen2X* map,
+                uint16_t                     stored_crc,
+                uint16_t                     pc,
+                uint8_t const*               epc,
+                size_t                       epc_length)
+{
+    struct StoredCrcEpcEntryGen2X* entry = find_slot(map, stored_crc);
+
+    bool const is_current = (entry->stored_crc == stored_crc) &&
+                            round_is_current(map, entry->round_stamp);
+    if (!is_current)
+    {
+        entry->stored_crc      = stored_crc;
+        entry->ambiguous_round = 0u;
+    }
+    else if (!epc_matches(entry, pc, epc, epc_length))
+    {
+        // A second tag shares this StoredCRC; report the latest EPC read,
+        // flagged as ambiguous.
+        entry->ambiguous_round = map->round;
+    }
+
+    entry->round_stamp = map->round;
+    entry->pc          = pc;
+    if (epc_length > STORED_CRC_EPC_MAX_LENGTH)
+    {
+        // An EPC which can not be held can not resolve the StoredCRC.
+        entry->epc_length      = 0u;
+        entry->ambiguous_round = map->round;
+        return;
+    }
+    entry->epc_length = (uint8_t)epc_length;
+    ex10_memcpy(entry->epc, sizeof(entry->epc), epc, epc_length);
+}
+
+static enum StoredCrcResolutionGen2X resolve(
+    struct StoredCrcEpcMapGen2X const*    map,
+    uint16_t                              stored_crc,
+    struct StoredCrcEpcEntryGen2X const** entry)
+{
+    if (entry != NULL)
+    {
+        *entry = NULL;
+    }
+
+    size_t const mask  = map->entry_count - 1u;
+    size_t const limit = probe_limit(map);
+    size_t const first = first_slot(map, stored_crc);
+
+    for (size_t iter = 0u; iter < limit; ++iter)
+    {
+        struct StoredCrcEpcEntryGen2X const* slot =
+            &map->entries[(first + iter) & mask];
+        if (slot->round_stamp == 0u)
+        {
+            break;
+        }
+        if (slot->stored_crc == stored_crc)
+        {
+            if (!round_is_current(map, slot->round_stamp))
+            {
+                break;
+            }
+            if (entry != NULL)
+            {
+                *entry = slot;
+            }
+            return round_is_current(map, slot->ambiguous_round)
+                       ? StoredCrcAmbiguous
+                       : StoredCrcResolved;
+        }
+    }
+    return StoredCrcUnresolved;
+}
+
+static const struct Ex10StoredCrcEpcMapGen2X ex10_stored_crc_epc_map_gen2x = {
+    .init          = init,
+    .advance_round = advance_round,
+    .add           = add,
+    .resolve       = resolve,
+};
+
+struct Ex10StoredCrcEpcMapGen2X const* get_ex10_stored_crc_epc_map_gen2x(void)
+{
+    return &ex10_stored_crc_epc_map_gen2x;
+}
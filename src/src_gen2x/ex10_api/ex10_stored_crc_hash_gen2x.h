@@ -0,0 +1,88 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file ex10_stored_crc_hash_gen2x.h
+ * The open addressed hash table helpers shared by the StoredCRC set and the
+ * StoredCRC to EPC map. Not part of the public SDK interface.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The largest supported table; one slot per possible StoredCRC.
+#define STORED_CRC_HASH_MAX_ENTRIES ((size_t)0x10000u)
+
+/// The 32-bit Fibonacci hashing multiplier, 2^32 divided by the golden ratio.
+#define STORED_CRC_HASH_MULTIPLIER ((uint32_t)2654435769u)
+
+/**
+ * @return bool true if entry_count is a power of two from 2 through
+ *              STORED_CRC_HASH_MAX_ENTRIES.
+ */
+static inline bool stored_crc_hash_entry_count_is_valid(size_t entry_count)
+{
+    return (entry_count >= 2u) &&
+           (entry_count <= STORED_CRC_HASH_MAX_ENTRIES) &&
+           ((entry_count & (entry_count - 1u)) == 0u);
+}
+
+/**
+ * @param entry_count A valid table entry count.
+ *
+ * @return uint8_t The right shift which reduces a 32-bit hash to a slot
+ *                 index of the table.
+ */
+static inline uint8_t stored_crc_hash_shift(size_t entry_count)
+{
+    uint8_t bits = 0u;
+    while (((size_t)1u << bits) < entry_count)
+    {
+        bits += 1u;
+    }
+    return (uint8_t)(32u - bits);
+}
+
+/**
+ * Fibonacci hashing spreads StoredCRCs which differ only in their high bits
+ * across the table.
+ *
+ * @return size_t The first slot probed for stored_crc.
+ */
+static inline size_t stored_crc_hash_first_slot(uint16_t stored_crc,
+                                                uint8_t  hash_shift)
+{
+    return (size_t)(((uint32_t)stored_crc * STORED_CRC_HASH_MULTIPLIER) >>
+                    hash_shift);
+}
+
+/**
+ * @return size_t The number of slots probed from the first slot; the lesser
+ *                of the table size and max_probes.
+ */
+static inline size_t stored_crc_hash_probe_limit(size_t entry_count,
+                                                 size_t max_probes)
+{
+    return (entry_count < max_probes) ? entry_count : max_probes;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,166 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2024 Impinj, Inc. All rights reserved.                      *
+ *                                                                           *
+ *****************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "board/ex10_osal.h"
+#include "include_gen2x/ex10_api/ex10_stored_crc_set_gen2x.h"
+
+#include "ex10_stored_crc_hash_gen2x.h"
+
+static bool slot_is_member(struct StoredCrcSetGen2X const*      set,
+                           struct StoredCrcSetEntryGen2X const* entry)
+{
+    return (entry->round_stamp != 0u) &&
+           (entry->round_stamp >= set->valid_from_round) &&
+           (set->round - entry->round_stamp <= set->max_age_rounds);
+}
+
+static size_t first_slot(struct StoredCrcSetGen2X const* set,
+                         uint16_t                        stored_crc)
+{
+    return stored_crc_hash_first_slot(stored_crc, set->hash_shift);
+}
+
+static size_t probe_limit(struct StoredCrcSetGen2X const* set)
+{
+    return stored_crc_hash_probe_limit(set->entry_count,
+                                       STORED_CRC_SET_PROBE_LIMIT);
+}
+
+static struct Ex10Result init(struct StoredCrcSetGen2X*      set,
+                              struct StoredCrcSetEntryGen2X* entries,
+                              size_t                         entry_count,
+                              uint32_t                       max_age_rounds)
+{
+    if (set == NULL || entries == NULL)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUseCase, Ex10SdkErrorNullPointer);
+    }
+    if (stored_crc_hash_entry_count_is_valid(entry_count) == false)
+    {
+        return make_ex10_sdk_error(Ex10ModuleUseCase,
+                                   Ex10SdkErrorBadParamLength);
+    }
+
+    ex10_memzero(entries, entry_count * sizeof(*entries));
+    set->entries          = entries;
+    set->entry_count      = entry_count;
+    set->hash_shift       = stored_crc_hash_shift(entry_count);
+    set->max_age_rounds   = max_age_rounds;
+    set->round            = 1u;
+    set->valid_from_round = 1u;
+    set->evictions        = 0u;
+
+    return make_ex10_success();
+}
+
+static void advance_round(struct StoredCrcSetGen2X* set)
+{
+    set->round += 1u;
+}
+
+static void expire_all(struct StoredCrcSetGen2X* set)
+{
+    set->round += 1u;
+    set->valid_from_round = set->round;
+}
+
+static void insert(struct StoredCrcSetGen2X* set, uint16_t stored_crc)
+{
+    size_t const mask  = set->entry_count - 1u;
+    size_t const limit = probe_limit(set);
+    size_t const first = first_slot(set, stored_crc);
+
+    // The slot to use if the StoredCRC is not found: the first free or
+    // expired slot, else the least recently inserted member.
+    struct StoredCrcSetEntryGen2X* free_entry   = NULL;
+    struct StoredCrcSetEntryGen2X* oldest_entry = NULL;
+
+    for (size_t iter = 0u; iter < limit; ++iter)
+    {
+        struct StoredCrcSetEntryGen2X* entry =
+            &set->entries[(first + iter) & mask];
+        if (entry->round_stamp == 0u)
+        {
+            // Nothing was ever stored beyond an unused slot.
+            if (free_entry == NULL)
+            {
+                free_entry = entry;
+            }
+            break;
+        }
+        if (entry->stored_crc == stored_crc)
+        {
+            entry->round_stamp = set->round;
+            return;
+        }
+        if (!slot_is_member(set, entry))
+        {
+            if (free_entry == NULL)
+            {
+                free_entry = entry;
+            }
+        }
+        else if ((oldest_entry == NULL) ||
+                 (entry->round_stamp < oldest_entry->round_stamp))
+        {
+            oldest_entry = entry;
+        }
+    }
+
+    if (free_entry == NULL)
+    {
+        free_entry = oldest_entry;
+        set->evictions += 1u;
+    }
+    free_entry->stored_crc  = stored_crc;
+    free_entry->round_stamp = set->round;
+}
+
+static bool contains(struct StoredCrcSetGen2X const* set, uint16_t stored_crc)
+{
+    size_t const mask  = set->entry_count - 1u;
+    size_t const limit = probe_limit(set);
+    size_t const first = first_slot(set, stored_crc);
+
+    for (size_t iter = 0u; iter < limit; ++iter)
+    {
+        struct StoredCrcSetEntryGen2X const* entry =
+            &set->entries[(first + iter) & mask];
+        if (entry->round_stamp == 0u)
+        {
+            return false;
+        }
+        if (entry->stored_crc == stored_crc)
+        {
+            return slot_is_member(set, entry);
+        }
+    }
+    return false;
+}
+
+static const struct Ex10StoredCrcSetGen2X ex10_stored_crc_set_gen2x = {
+    .init          = init,
+    .advance_round = advance_round,
+    .expire_all    = expire_all,
+    .insert        = insert,
+    .contains      = contains,
+};
+
+struct Ex10StoredCrcSetGen2X const* get_ex10_stored_crc_set_gen2x(void)
+{
+    return &ex10_stored_crc_set_gen2x;
+}
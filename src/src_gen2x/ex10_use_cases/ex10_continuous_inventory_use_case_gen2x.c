@@ -74,11 +74,13 @@ static struct Ex10ContinuousInventoryUseCaseGen2X ex10_continuous_inventory_use_
     .init                                 = NULL,
     .deinit                               = NULL,
     .register_packet_subscriber_callback  = NULL,
+    .register_packet_observer_callback    = NULL,
     .enable_packet_filter                 = NULL,
     .enable_auto_access                   = NULL,
     .enable_abort_on_fail                 = NULL,
     .enable_tag_focus                     = NULL,
     .enable_tag_read_extended_packet      = NULL,
+    .enable_adaptive_event_fifo_threshold = NULL,
     .continuous_inventory                 = continuous_inventory,
     .get_continuous_inventory_stop_reason = NULL,
 };
@@ -102,12 +104,16 @@ struct Ex10ContinuousInventoryUseCaseGen2X const*
     ciucg->deinit = ciuc->deinit;
     ciucg->register_packet_subscriber_callback =
         ciuc->register_packet_subscriber_callback;
+    ciucg->register_packet_observer_callback =
+        ciuc->register_packet_observer_callback;
     ciucg->enable_packet_filter = ciuc->enable_packet_filter;
     ciucg->enable_auto_access   = ciuc->enable_auto_access;
     ciucg->enable_abort_on_fail = ciuc->enable_abort_on_fail;
     ciucg->enable_tag_focus     = ciuc->enable_tag_focus;
     ciucg->enable_tag_read_extended_packet =
         ciuc->enable_tag_read_extended_packet;
+    ciucg->enable_adaptive_event_fifo_threshold =
+        ciuc->enable_adaptive_event_fifo_threshold;
     ciucg->get_continuous_inventory_stop_reason =
         ciuc->get_continuous_inventory_stop_reason;
 
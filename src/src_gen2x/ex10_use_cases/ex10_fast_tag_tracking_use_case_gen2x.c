@@ -14,50 +14,55 @@
 #include "ex10_api/ex10_print.h"
 
 #include "ex10_api/application_register_field_enums.h"
-#include "ex10_api/bit_span.h"
+#include "ex10_api/event_packet_parser.h"
 #include "ex10_api/ex10_continuous_inventory_common.h"
+#include "ex10_api/ex10_device_time.h"
 #include "ex10_api/ex10_macros.h"
 #include "ex10_api/ex10_protocol.h"
 #include "ex10_api/ex10_select_commands.h"
+#include "ex10_api/ex10_utils.h"
 
 #include "include_gen2x/ex10_use_cases/ex10_continuous_inventory_use_case_gen2x.h"
 #include "include_gen2x/ex10_use_cases/ex10_fast_tag_tracking_use_case_gen2x.h"
 
 #include "include_gen2x/ex10_api/application_register_field_enums_gen2x.h"
 #include "include_gen2x/ex10_api/event_fifo_packet_types_gen2x.h"
+#include "include_gen2x/ex10_api/ex10_stored_crc_epc_map_gen2x.h"
+#include "include_gen2x/ex10_api/ex10_stored_crc_set_gen2x.h"
 
 struct FastTagTrackingState
 {
     /// The callback to notify the subscriber of a new packet.
     void (*packet_subscriber_callback)(struct EventFifoPacket const*,
                                        struct Ex10Result*);
-    bool            force_full_round;
-    bool            switch_to_full_round;
-    bool            stop_inventory;
-    enum StopReason stop_reason;
-    size_t          fast_round_count;
-    size_t          round_count;
-    size_t          tag_count;
-    uint16_t        last_new_stored_crc;
-    struct BitSpan  known_bitspan;
-    struct BitSpan  new_bitspan;
+    bool                         force_full_round;
+    bool                         switch_to_full_round;
+    bool                         stop_inventory;
+    enum StopReason              stop_reason;
+    size_t                       round_count;
+    size_t                       tag_count;
+    uint16_t                     last_new_stored_crc;
+    struct StoredCrcSetGen2X*    known_stored_crcs;
+    struct StoredCrcSetGen2X*    new_stored_crcs;
+    struct StoredCrcEpcMapGen2X* stored_crc_epcs;
 };
 
 static struct FastTagTrackingState fast_tag_tracking_state = {
-    NULL,                         // callback pointer
-    false,                        // force_full_round,
-    false,                        // switch to full round,
-    false,                        // stop_inventory
-    SRNone,                       // inventory stop reason
-    0,                            // fast round count
-    0,                            // round count
-    0,                            // tag_count
-    0x0000,                       // last new stored crc
-    {.data = NULL, .length = 0},  // known bitspan
-    {.data = NULL, .length = 0}   // new bitspan
+    NULL,    // callback pointer
+    false,   // force_full_round,
+    false,   // switch to full round,
+    false,   // stop_inventory
+    SRNone,  // inventory stop reason
+    0,       // round count
+    0,       // tag_count
+    0x0000,  // last new stored crc
+    NULL,    // known stored crcs
+    NULL,    // new stored crcs
+    NULL     // stored crc epcs
 };
 
-static uint32_t              start_time_us = 0;
+static uint32_t              start_time_us      = 0;
+static uint64_t              start_timestamp_us = 0;
 static struct StopConditions stop_conditions;
 
 enum Ex10FastTagTrackingResultCode
@@ -69,7 +74,9 @@ enum Ex10FastTagTrackingResultCode
 
 static void set_inventory_timer_start(void)
 {
-    start_time_us = get_ex10_ops()->get_device_time();
+    start_time_us      = get_ex10_ops()->get_device_time();
+    start_timestamp_us =
+        get_ex10_device_time()->anchor_us_counter(start_time_us);
 }
 
 static struct Ex10Result init(void)
@@ -123,8 +130,10 @@ static struct StopConditions update_stop_conditions(void)
 
     if (stop_conditions.max_duration_us != 0)
     {
-        uint32_t elapsed_time =
-            get_ex10_ops()->get_device_time() - start_time_us;
+        uint64_t const time_us = get_ex10_device_time()->extend_us_counter(
+            get_ex10_ops()->get_device_time());
+        uint32_t const elapsed_time =
+            (uint32_t)(time_us - start_timestamp_us);
         updated_stop.max_duration_us =
             stop_conditions.max_duration_us - elapsed_time;
     }
@@ -172,13 +181,13 @@ static bool check_stop_conditions(uint32_t timestamp_us)
     }
     if (stop_conditions.max_duration_us > 0u)
     {
-        // Packet before start checks for packets which occurred before the
-        // continuous inventory round was started.
-        bool const     packet_before_start = (start_time_us > timestamp_us);
-        uint32_t const elapsed_us =
-            (packet_before_start)
-                ? ((UINT32_MAX - start_time_us) + timestamp_us + 1)
-                : (timestamp_us - start_time_us);
+        // Packets which occurred before the continuous inventory round was
+        // started have no elapsed time.
+        uint64_t const time_us =
+            get_ex10_device_time()->extend_us_counter(timestamp_us);
+        uint64_t const elapsed_us = (time_us > start_timestamp_us)
+                                        ? (time_us - start_timestamp_us)
+                                        : 0u;
         if (elapsed_us >= stop_conditions.max_duration_us)
         {
             fast_tag_tracking_state.stop_reason = SRMaxDuration;
@@ -234,29 +243,47 @@ static struct Ex10Result make_ex10_customer_reason(
     return ex10_result;
 }
 
-static void set_bitfield_bit(struct BitSpan bit_span, uint16_t bit)
+static void record_stored_crc_epc(struct EventFifoPacket const* packet,
+                                  uint16_t                      stored_crc)
 {
-    const size_t index = bit / 8;
-    const size_t shift = bit % 8;
-    bit_span.data[index] |= (0x01 << shift);
-}
+    if (fast_tag_tracking_state.stored_crc_epcs == NULL)
+    {
+        return;
+    }
 
-static bool check_bitfield_set(struct BitSpan bit_span, uint16_t bit)
-{
-    const int     index = bit / 8;
-    const int     shift = bit % 8;
-    const uint8_t value = bit_span.data[index] & (0x01 << shift);
-    return (value != 0);
+    struct TagReadFields const tag_read =
+        get_ex10_event_parser()->get_tag_read_fields(
+            packet->dynamic_data,
+            packet->dynamic_data_length,
+            packet->static_data->tag_read_extended.type,
+            packet->static_data->tag_read_extended.tid_offset);
+    if (tag_read.pc == NULL || tag_read.epc == NULL)
+    {
+        return;
+    }
+
+    get_ex10_stored_crc_epc_map_gen2x()->add(
+        fast_tag_tracking_state.stored_crc_epcs,
+        stored_crc,
+        ex10_swap_bytes(*tag_read.pc),
+        tag_read.epc,
+        tag_read.epc_length);
 }
 
-static void clear_bitfield(struct BitSpan bit_span)
+static enum StoredCrcResolutionGen2X resolve_stored_crc(
+    uint16_t                              stored_crc,
+    struct StoredCrcEpcEntryGen2X const** entry)
 {
-    // Convert this to a 32-bit write just for speed
-    uint32_t* word = (uint32_t*)bit_span.data;
-    for (size_t i = 0; i < bit_span.length / (sizeof(uint32_t) * 8); i++)
+    if (fast_tag_tracking_state.stored_crc_epcs == NULL)
     {
-        *word++ = 0;
+        if (entry != NULL)
+        {
+            *entry = NULL;
+        }
+        return StoredCrcUnresolved;
     }
+    return get_ex10_stored_crc_epc_map_gen2x()->resolve(
+        fast_tag_tracking_state.stored_crc_epcs, stored_crc, entry);
 }
 
 static void full_epc_callback(struct EventFifoPacket const* packet,
@@ -264,7 +291,7 @@ static void full_epc_callback(struct EventFifoPacket const* packet,
 {
     *result_ptr = make_ex10_success();
 
-    // with this callback we are building the known bitfield
+    // with this callback we are building the known StoredCRC set
     if (packet->packet_type == TagReadExtended)
     {
         struct TagReadExtendedGen2X const* tag_read_extended =
@@ -279,8 +306,11 @@ static void full_epc_callback(struct EventFifoPacket const* packet,
             return;
         }
         // Only the bottom 16 bits of the cr_value are valid in this case.
-        set_bitfield_bit(fast_tag_tracking_state.known_bitspan,
-                         (tag_read_extended->cr_value & 0xFFFF));
+        uint16_t const stored_crc =
+            (uint16_t)(tag_read_extended->cr_value & 0xFFFF);
+        get_ex10_stored_crc_set_gen2x()->insert(
+            fast_tag_tracking_state.known_stored_crcs, stored_crc);
+        record_stored_crc_epc(packet, stored_crc);
     }
     else if (packet->packet_type == TagRead)
     {
@@ -311,7 +341,15 @@ static struct Ex10Result run_full_epc_inventory(
     uint32_t                                          device_time,
     struct Ex10FastTagTrackingUseCaseParametersGen2X* params)
 {
-    clear_bitfield(fast_tag_tracking_state.known_bitspan);
+    // Members of the known set which are not read again expire once the
+    // set's max age in full rounds has passed.
+    get_ex10_stored_crc_set_gen2x()->advance_round(
+        fast_tag_tracking_state.known_stored_crcs);
+    if (fast_tag_tracking_state.stored_crc_epcs != NULL)
+    {
+        get_ex10_stored_crc_epc_map_gen2x()->advance_round(
+            fast_tag_tracking_state.stored_crc_epcs);
+    }
 
     // run only 1 round to fill the known EPCs and ignore
     // the stop other stop conditions for a full epc round.
@@ -322,7 +360,7 @@ static struct Ex10Result run_full_epc_inventory(
     };
 
 
-    // Setup for the Full EPC round to gather the known bitfield
+    // Setup for the Full EPC round to gather the known StoredCRC set
     struct Ex10ContinuousInventoryUseCaseParametersGen2X ciucpg = {
         .antenna         = params->antenna,
         .rf_mode         = params->rf_mode,
@@ -379,15 +417,17 @@ static void fast_inventory_callback(struct EventFifoPacket const* packet,
             return;
         }
 
+        struct Ex10StoredCrcSetGen2X const* stored_crc_set =
+            get_ex10_stored_crc_set_gen2x();
         fast_tag_tracking_state.tag_count++;
         uint16_t cr_value = (uint16_t)(tag_read_extended->cr_value & 0xFFFF);
-        if (check_bitfield_set(fast_tag_tracking_state.known_bitspan,
-                               cr_value) == false)
+        if (stored_crc_set->contains(fast_tag_tracking_state.known_stored_crcs,
+                                     cr_value) == false)
         {
-            if (check_bitfield_set(fast_tag_tracking_state.new_bitspan,
-                                   cr_value))
+            if (stored_crc_set->contains(
+                    fast_tag_tracking_state.new_stored_crcs, cr_value))
             {
-                // It is in the new bitfield so we assume it is not a phantom.
+                // It is in the new set so we assume it is not a phantom.
                 // End the fast inventory early and have the application decide
                 // what it wants to do
                 fast_tag_tracking_state.last_new_stored_crc  = cr_value;
@@ -402,28 +442,25 @@ static void fast_inventory_callback(struct EventFifoPacket const* packet,
             }
             else
             {
-                // it is not in the new bitfield so we should add it and
+                // it is not in the new set so we should add it and
                 // continue inventory
-                set_bitfield_bit(fast_tag_tracking_state.new_bitspan, cr_value);
+                stored_crc_set->insert(fast_tag_tracking_state.new_stored_crcs,
+                                       cr_value);
                 // but not report it to the example so we return early
                 return;
             }
         }
         // else
-        // it is in the known bitfield so we let the
+        // it is in the known set so we let the
         // callback report it at the end of this function.
     }
     else if (packet->packet_type == ContinuousInventorySummary)
     {
-        fast_tag_tracking_state.fast_round_count++;
-        if (fast_tag_tracking_state.fast_round_count == 10)
-        {
-            // Every 10 rounds, clear out the new tag bits
-            // as they didn't come back.  They are probably phantom
-            // noise that we don't want it to accumulate over time.
-            clear_bitfield(fast_tag_tracking_state.new_bitspan);
-            fast_tag_tracking_state.fast_round_count = 0;
-        }
+        // Age the new StoredCRCs. Those which do not come back within the
+        // set's max age are probably phantom noise, and expire one by one
+        // so that they do not accumulate over time.
+        get_ex10_stored_crc_set_gen2x()->advance_round(
+            fast_tag_tracking_state.new_stored_crcs);
     }
     else if (packet->packet_type == TagRead)
     {
@@ -512,19 +549,14 @@ static struct Ex10Result fast_tag_tracking_inventory(
     struct Ex10FastTagTrackingUseCaseParametersGen2X* params)
 {
     if (params == NULL || params->stop_conditions == NULL ||
-        params->known_stored_crcs.data == NULL ||
-        params->new_stored_crcs.data == NULL)
+        params->known_stored_crcs == NULL ||
+        params->known_stored_crcs->entries == NULL ||
+        params->new_stored_crcs == NULL ||
+        params->new_stored_crcs->entries == NULL)
     {
         return make_ex10_sdk_error(Ex10ModuleUseCase, Ex10SdkErrorNullPointer);
     }
 
-    if (params->known_stored_crcs.length != SIZE_OF_BITFIELD ||
-        params->new_stored_crcs.length != SIZE_OF_BITFIELD)
-    {
-        return make_ex10_sdk_error(Ex10ModuleUseCase,
-                                   Ex10SdkErrorBadParamLength);
-    }
-
     set_inventory_timer_start();
 
     struct Ex10SelectCommands const* select_commands =
@@ -538,9 +570,10 @@ static struct Ex10Result fast_tag_tracking_inventory(
     }
     select_commands->enable_select_command((size_t)select_command_index_A);
 
-    stop_conditions                       = *params->stop_conditions;
-    fast_tag_tracking_state.known_bitspan = params->known_stored_crcs;
-    fast_tag_tracking_state.new_bitspan   = params->new_stored_crcs;
+    stop_conditions                           = *params->stop_conditions;
+    fast_tag_tracking_state.known_stored_crcs = params->known_stored_crcs;
+    fast_tag_tracking_state.new_stored_crcs   = params->new_stored_crcs;
+    fast_tag_tracking_state.stored_crc_epcs   = params->stored_crc_epcs;
 
     // enable the extended tag read to expose the CR (StoredCRC) values
     get_ex10_continuous_inventory_use_case_gen2x()
@@ -548,7 +581,7 @@ static struct Ex10Result fast_tag_tracking_inventory(
 
     struct Ex10Result ex10_result = make_ex10_success();
 
-    // clear the known epc bitfield and build a new one
+    // age the known StoredCRC set and refresh it from a full EPC round
     if (params->build_stored_crcs)
     {
         ex10_result = run_full_epc_inventory(start_time_us, params);
@@ -560,7 +593,8 @@ static struct Ex10Result fast_tag_tracking_inventory(
 
     if (params->clear_new_stored_crcs)
     {
-        clear_bitfield(fast_tag_tracking_state.new_bitspan);
+        get_ex10_stored_crc_set_gen2x()->expire_all(
+            fast_tag_tracking_state.new_stored_crcs);
     }
     uint32_t device_time = get_ex10_ops()->get_device_time();
     while (check_stop_conditions(device_time) == false)
@@ -576,8 +610,9 @@ static struct Ex10Result fast_tag_tracking_inventory(
         if (fast_tag_tracking_state.switch_to_full_round ||
             fast_tag_tracking_state.force_full_round)
         {
-            // clear out the new tag bitfield
-            clear_bitfield(fast_tag_tracking_state.new_bitspan);
+            // forget the new StoredCRCs; the full round reads the new tags
+            get_ex10_stored_crc_set_gen2x()->expire_all(
+                fast_tag_tracking_state.new_stored_crcs);
             // if the customer flag is set, then we should do a full inventory
             device_time = get_ex10_ops()->get_device_time();
             ex10_result = run_full_epc_inventory(device_time, params);
@@ -605,7 +640,7 @@ static struct Ex10FastTagTrackingUseCaseGen2X
         .get_fast_tag_tracking_stop_reason = get_fast_tag_tracking_stop_reason,
         .force_full_round                  = force_full_round,
         .stop_inventory                    = stop_inventory,
-        .clear_bitfield                    = clear_bitfield,
+        .resolve_stored_crc                = resolve_stored_crc,
         .fast_tag_tracking_inventory       = fast_tag_tracking_inventory,
 };
 
@@ -0,0 +1,236 @@
+/*****************************************************************************
+ *                  IMPINJ CONFIDENTIAL AND PROPRIETARY                      *
+ *                                                                           *
+ * This source code is the property of Impinj, Inc. Your use of this source  *
+ * code in whole or in part is subject to your applicable license terms      *
+ * from Impinj.                                                              *
+ * Contact support@impinj.com for a copy of the applicable Impinj license    *
+ * terms.                                                                    *
+ *                                                                           *
+ * (c) Copyright 2020 - 2024 Impinj, Inc. All rights reserved.               *
+ *                                                                           *
+ *****************************************************************************/
+
+/**
+ * @file tag_report_decode.c
+ * Convert a console log holding the binary tag report stream, written by the
+ * Gen2X continuous inventory example with TOI_LOGS_BINARY set, into the CSV
+ * lines printed when TOI_LOGS_BINARY is clear. Log lines which do not carry
+ * the stream are copied unchanged, so the output can be passed directly to
+ * toi_process.py.
+ *
+ * Build on Linux:
+ *   cc -std=c99 -Wall -I ../src/include -o tag_report_decode \
+ *       tag_report_decode.c
+ *
+ * Usage:
+ *   ./tag_report_decode [input_log [output_csv]]
+ * stdin and stdout are used when a file is not given.
+ *
+ * Define TAG_REPORT_DECODE_NO_MAIN to include this file in a test which
+ * drives append_hex() and decode_records() directly.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ex10_api/ex10_tag_report_stream.h"
+
+/// The longest log line read.
+#define LINE_LENGTH_MAX ((size_t)4096u)
+
+/// The number of stream bytes which may be held waiting for a full record.
+#define STREAM_BUFFER_SIZE ((size_t)1024u)
+
+/// Channel frequencies received in TagReportRecordChannel records.
+static uint32_t channel_frequency_khz[UINT16_MAX + 1u];
+
+static uint8_t stream_buffer[STREAM_BUFFER_SIZE];
+static size_t  stream_length;
+
+static uint16_t get_u16(uint8_t const* src)
+{
+    return (uint16_t)(src[0] | (src[1] << 8u));
+}
+
+static uint32_t get_u32(uint8_t const* src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8u) |
+           ((uint32_t)src[2] << 16u) | ((uint32_t)src[3] << 24u);
+}
+
+static int hex_value(char digit)
+{
+    if ((digit >= '0') && (digit <= '9'))
+    {
+        return digit - '0';
+    }
+    if ((digit >= 'A') && (digit <= 'F'))
+    {
+        return digit - 'A' + 10;
+    }
+    if ((digit >= 'a') && (digit <= 'f'))
+    {
+        return digit - 'a' + 10;
+    }
+    return -1;
+}
+
+static void print_tag_read(FILE* output, uint8_t const* record, size_t length)
+{
+    size_t const id_length = record[21];
+    if (TAG_REPORT_TAG_READ_HEADER_LENGTH + id_length + 1u > length)
+    {
+        fprintf(stderr, "Malformed TagRead record\n");
+        return;
+    }
+
+    uint8_t const* id            = &record[22];
+    uint16_t const channel_index = get_u16(&record[14]);
+    fprintf(output,
+            "%u,%c,%u,%u,%u,T%u,%u,",
+            get_u32(&record[2]),
+            (char)record[17],
+            channel_frequency_khz[channel_index],
+            record[16],
+            get_u16(&record[6]),
+            record[18],
+            record[19]);
+
+    if ((record[20] & TAG_REPORT_FLAG_NICKNAME) && (id_length == 2u))
+    {
+        fprintf(output, "0x%02X%02X,", id[0], id[1]);
+    }
+    else
+    {
+        for (size_t iter = 0u; iter < id_length; ++iter)
+        {
+            fprintf(output, "%02X", id[iter]);
+        }
+        fprintf(output, ",");
+    }
+
+    fprintf(output,
+            "%u,%u,%i\n",
+            get_u16(&record[10]),
+            get_u16(&record[12]),
+            (int16_t)get_u16(&record[8]));
+}
+
+/// Decode the complete records held in stream_buffer.
+static void decode_records(FILE* output)
+{
+    size_t offset = 0u;
+    while (stream_length - offset >= 2u)
+    {
+        uint8_t const* record = &stream_buffer[offset];
+        size_t const   length = record[1];
+        if (length < 2u)
+        {
+            fprintf(stderr, "Bad record length, stream discarded\n");
+            offset = stream_length;
+            break;
+        }
+        if (stream_length - offset < length)
+        {
+            break;
+        }
+
+        if ((record[0] == TagReportRecordChannel) &&
+            (length >= TAG_REPORT_CHANNEL_RECORD_LENGTH))
+        {
+            channel_frequency_khz[get_u16(&record[2])] = get_u32(&record[4]);
+        }
+        else if ((record[0] == TagReportRecordTagRead) &&
+                 (length >= TAG_REPORT_TAG_READ_HEADER_LENGTH))
+        {
+            print_tag_read(output, record, length);
+        }
+        offset += length;
+    }
+
+    memmove(stream_buffer, &stream_buffer[offset], stream_length - offset);
+    stream_length -= offset;
+}
+
+/**
+ * Append the hex digits of a stream log line to stream_buffer, decoding the
+ * records held whenever it fills.
+ */
+static bool append_hex(FILE* output, char const* digits)
+{
+    while ((digits[0] != '\0') && (digits[1] != '\0'))
+    {
+        int const high = hex_value(digits[0]);
+        int const low  = hex_value(digits[1]);
+        if ((high < 0) || (low < 0))
+        {
+            break;
+        }
+        if (stream_length == STREAM_BUFFER_SIZE)
+        {
+            decode_records(output);
+            if (stream_length == STREAM_BUFFER_SIZE)
+            {
+                return false;
+            }
+        }
+        stream_buffer[stream_length++] = (uint8_t)((high << 4) | low);
+        digits += 2;
+    }
+    return true;
+}
+
+#if !defined(TAG_REPORT_DECODE_NO_MAIN)
+int main(int argc, char** argv)
+{
+    FILE* input  = stdin;
+    FILE* output = stdout;
+
+    if ((argc > 1) && ((input = fopen(argv[1], "r")) == NULL))
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    if ((argc > 2) && ((output = fopen(argv[2], "w")) == NULL))
+    {
+        perror(argv[2]);
+        return 1;
+    }
+
+    size_t const prefix_length = strlen(TAG_REPORT_LOG_PREFIX);
+    static char  line[LINE_LENGTH_MAX];
+    while (fgets(line, sizeof(line), input) != NULL)
+    {
+        if (strncmp(line, TAG_REPORT_LOG_PREFIX, prefix_length) != 0)
+        {
+            fputs(line, output);
+            continue;
+        }
+
+        if (!append_hex(output, &line[prefix_length]))
+        {
+            fprintf(stderr, "Stream buffer overflow, stream discarded\n");
+            stream_length = 0u;
+        }
+        decode_records(output);
+    }
+
+    if (stream_length > 0u)
+    {
+        fprintf(stderr, "%zu trailing stream bytes\n", stream_length);
+    }
+    if (input != stdin)
+    {
+        fclose(input);
+    }
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+    return 0;
+}
+#endif  // TAG_REPORT_DECODE_NO_MAIN